@@ -112,6 +112,28 @@ Ref<ResourceImportMetadata> _ResourceLoader::load_import_metadata(const String &
 	return ResourceLoader::load_import_metadata(p_path);
 }
 
+Error _ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint) {
+
+	return ResourceLoader::load_threaded_request(p_path, p_type_hint);
+}
+
+int _ResourceLoader::load_threaded_get_status(const String &p_path, Array r_progress) {
+
+	float progress = 0;
+	ResourceLoader::ThreadLoadStatus status = ResourceLoader::load_threaded_get_status(p_path, &progress);
+
+	if (r_progress.size() == 0)
+		r_progress.resize(1);
+	r_progress[0] = progress;
+
+	return status;
+}
+
+RES _ResourceLoader::load_threaded_get(const String &p_path) {
+
+	return ResourceLoader::load_threaded_get(p_path);
+}
+
 void _ResourceLoader::_bind_methods() {
 
 	ObjectTypeDB::bind_method(_MD("load_interactive:ResourceInteractiveLoader", "path", "type_hint"), &_ResourceLoader::load_interactive, DEFVAL(""));
@@ -121,6 +143,14 @@ void _ResourceLoader::_bind_methods() {
 	ObjectTypeDB::bind_method(_MD("set_abort_on_missing_resources", "abort"), &_ResourceLoader::set_abort_on_missing_resources);
 	ObjectTypeDB::bind_method(_MD("get_dependencies", "path"), &_ResourceLoader::get_dependencies);
 	ObjectTypeDB::bind_method(_MD("has", "path"), &_ResourceLoader::has);
+	ObjectTypeDB::bind_method(_MD("load_threaded_request", "path", "type_hint"), &_ResourceLoader::load_threaded_request, DEFVAL(""));
+	ObjectTypeDB::bind_method(_MD("load_threaded_get_status", "path", "progress"), &_ResourceLoader::load_threaded_get_status, DEFVAL(Array()));
+	ObjectTypeDB::bind_method(_MD("load_threaded_get:Resource", "path"), &_ResourceLoader::load_threaded_get);
+
+	BIND_CONSTANT(THREAD_LOAD_INVALID_RESOURCE);
+	BIND_CONSTANT(THREAD_LOAD_IN_PROGRESS);
+	BIND_CONSTANT(THREAD_LOAD_FAILED);
+	BIND_CONSTANT(THREAD_LOAD_LOADED);
 }
 
 _ResourceLoader::_ResourceLoader() {
@@ -45,6 +45,14 @@ protected:
 	static _ResourceLoader *singleton;
 
 public:
+	enum ThreadLoadStatus {
+
+		THREAD_LOAD_INVALID_RESOURCE,
+		THREAD_LOAD_IN_PROGRESS,
+		THREAD_LOAD_FAILED,
+		THREAD_LOAD_LOADED
+	};
+
 	static _ResourceLoader *get_singleton() { return singleton; }
 	Ref<ResourceInteractiveLoader> load_interactive(const String &p_path, const String &p_type_hint = "");
 	RES load(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false);
@@ -54,6 +62,10 @@ public:
 	bool has(const String &p_path);
 	Ref<ResourceImportMetadata> load_import_metadata(const String &p_path);
 
+	Error load_threaded_request(const String &p_path, const String &p_type_hint = "");
+	int load_threaded_get_status(const String &p_path, Array r_progress = Array());
+	RES load_threaded_get(const String &p_path);
+
 	_ResourceLoader();
 };
 
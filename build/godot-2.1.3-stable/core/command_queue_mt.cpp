@@ -77,6 +77,7 @@ CommandQueueMT::CommandQueueMT(bool p_sync) {
 
 	read_ptr = 0;
 	write_ptr = 0;
+	push_notify = NULL;
 	mutex = Mutex::create();
 
 	for (int i = 0; i < SYNC_SEMAPHORES; i++) {
@@ -549,6 +549,15 @@ class CommandQueueMT {
 	SyncSemaphore sync_sems[SYNC_SEMAPHORES];
 	Mutex *mutex;
 	Semaphore *sync;
+	void (*push_notify)();
+
+	_FORCE_INLINE_ void _post_pushed() {
+
+		if (sync)
+			sync->post();
+		else if (push_notify)
+			push_notify();
+	}
 
 	template <class T>
 	T *allocate() {
@@ -654,7 +663,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 	}
 
 	template <class T, class M, class P1>
@@ -668,7 +677,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 	}
 
 	template <class T, class M, class P1, class P2>
@@ -683,7 +692,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 	}
 
 	template <class T, class M, class P1, class P2, class P3>
@@ -699,7 +708,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 	}
 
 	template <class T, class M, class P1, class P2, class P3, class P4>
@@ -716,7 +725,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 	}
 
 	template <class T, class M, class P1, class P2, class P3, class P4, class P5>
@@ -734,7 +743,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 	}
 
 	template <class T, class M, class P1, class P2, class P3, class P4, class P5, class P6>
@@ -753,7 +762,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 	}
 
 	template <class T, class M, class P1, class P2, class P3, class P4, class P5, class P6, class P7>
@@ -773,7 +782,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 	}
 
 	template <class T, class M, class P1, class P2, class P3, class P4, class P5, class P6, class P7, class P8>
@@ -794,7 +803,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 	}
 	/*** PUSH AND RET COMMANDS ***/
 
@@ -811,7 +820,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 		ss->sem->wait();
 	}
 
@@ -829,7 +838,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 		ss->sem->wait();
 	}
 
@@ -848,7 +857,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 		ss->sem->wait();
 	}
 
@@ -868,7 +877,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 		ss->sem->wait();
 	}
 
@@ -889,7 +898,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 		ss->sem->wait();
 	}
 
@@ -911,7 +920,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 		ss->sem->wait();
 	}
 
@@ -934,7 +943,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 		ss->sem->wait();
 	}
 
@@ -958,7 +967,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 		ss->sem->wait();
 	}
 
@@ -983,7 +992,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 		ss->sem->wait();
 	}
 
@@ -1000,7 +1009,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 		ss->sem->wait();
 	}
 
@@ -1018,7 +1027,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 		ss->sem->wait();
 	}
 
@@ -1037,7 +1046,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 		ss->sem->wait();
 	}
 
@@ -1057,7 +1066,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 		ss->sem->wait();
 	}
 
@@ -1078,7 +1087,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 		ss->sem->wait();
 	}
 
@@ -1100,7 +1109,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 		ss->sem->wait();
 	}
 
@@ -1123,7 +1132,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 		ss->sem->wait();
 	}
 
@@ -1147,7 +1156,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 		ss->sem->wait();
 	}
 
@@ -1172,7 +1181,7 @@ public:
 
 		unlock();
 
-		if (sync) sync->post();
+		_post_pushed();
 		ss->sem->wait();
 	}
 
@@ -1184,6 +1193,9 @@ public:
 		unlock();
 	}
 
+	//without a flushing thread, called after each push so whoever flushes can be woken up
+	void set_push_notify_func(void (*p_notify)()) { push_notify = p_notify; }
+
 	void flush_all() {
 
 		//ERR_FAIL_COND(sync);
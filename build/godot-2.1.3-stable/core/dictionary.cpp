@@ -220,6 +220,19 @@ Error Dictionary::parse_json(const String &p_json) {
 	return OK;
 }
 
+Error Dictionary::parse_json_file(const String &p_path) {
+
+	String errstr;
+	int errline = 0;
+	Error err = JSON::parse_file(p_path, *this, errstr, errline);
+	if (err != OK) {
+		ERR_EXPLAIN("Error parsing JSON file '" + p_path + "': " + errstr + " at line: " + itos(errline));
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+
+	return OK;
+}
+
 String Dictionary::to_json() const {
 
 	return JSON::print(*this);
@@ -61,6 +61,7 @@ public:
 	void clear();
 
 	Error parse_json(const String &p_json);
+	Error parse_json_file(const String &p_path);
 	String to_json() const;
 
 	bool is_shared() const;
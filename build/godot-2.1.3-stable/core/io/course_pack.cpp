@@ -0,0 +1,292 @@
+/*************************************************************************/
+/*  course_pack.cpp                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2017 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "course_pack.h"
+
+#include "core/io/file_access_pack.h"
+#include "core/io/marshalls.h"
+
+// hands mounted media to FileAccess::open(), the same way open_media() does
+class PackedSourceCourse : public PackSource {
+
+public:
+	virtual bool try_open_pack(const String &p_path) { return false; } // only mounted through CoursePack
+	virtual FileAccess *get_file(const String &p_path, PackedData::PackedFile *p_file) { return memnew(FileAccessPack(p_path, *p_file)); }
+};
+
+static PackedSourceCourse *packed_source_course = NULL;
+
+void CoursePack::_bind_methods() {
+
+	ObjectTypeDB::bind_method(_MD("open:Error", "path"), &CoursePack::open);
+	ObjectTypeDB::bind_method(_MD("close"), &CoursePack::close);
+	ObjectTypeDB::bind_method(_MD("is_open"), &CoursePack::is_open);
+	ObjectTypeDB::bind_method(_MD("has_lesson", "md5"), &CoursePack::has_lesson);
+	ObjectTypeDB::bind_method(_MD("get_lesson_md5", "path"), &CoursePack::get_lesson_md5);
+	ObjectTypeDB::bind_method(_MD("get_lesson", "md5"), &CoursePack::get_lesson);
+	ObjectTypeDB::bind_method(_MD("get_lesson_list"), &CoursePack::get_lesson_list);
+	ObjectTypeDB::bind_method(_MD("has_media", "path"), &CoursePack::has_media);
+	ObjectTypeDB::bind_method(_MD("get_media", "path"), &CoursePack::get_media);
+	ObjectTypeDB::bind_method(_MD("mount_media"), &CoursePack::mount_media);
+}
+
+// index entries come from disk, so lengths and ranges are checked against the file before use
+static bool _get_index_path(FileAccess *p_file, String &r_path) {
+
+	size_t len = p_file->get_len();
+	if (p_file->get_pos() + 4 > len)
+		return false;
+
+	uint32_t sl = p_file->get_32();
+	if (sl > len - p_file->get_pos())
+		return false;
+
+	CharString cs;
+	cs.resize(sl + 1);
+	p_file->get_buffer((uint8_t *)cs.ptr(), sl);
+	cs[sl] = 0;
+	r_path.parse_utf8(cs.ptr());
+
+	return true;
+}
+
+static bool _get_index_range(FileAccess *p_file, uint64_t &r_offset, uint64_t &r_size) {
+
+	r_offset = p_file->get_64();
+	r_size = p_file->get_64();
+
+	uint64_t len = p_file->get_len();
+	return !p_file->eof_reached() && r_offset <= len && r_size <= len - r_offset;
+}
+
+Error CoursePack::open(const String &p_path) {
+
+	close();
+
+	Error err;
+	file = FileAccess::open(p_path, FileAccess::READ, &err);
+	if (!file)
+		return err;
+
+	uint32_t magic = file->get_32();
+	uint32_t version = file->get_32();
+
+	if (magic != COURSE_PACK_MAGIC || version != COURSE_PACK_VERSION) {
+
+		close();
+		ERR_EXPLAIN("Not a course pack or unsupported version: " + p_path);
+		ERR_FAIL_V(ERR_FILE_UNRECOGNIZED);
+	}
+
+	file->get_32(); // alignment
+	int lesson_count = file->get_32();
+	int media_count = file->get_32();
+
+	for (int i = 0; i < 11; i++) {
+		file->get_32(); // reserved
+	}
+
+	// only the index is read here, blobs are read when asked for
+
+	bool valid = true;
+
+	for (int i = 0; i < lesson_count && valid; i++) {
+
+		Blob b;
+		uint8_t md5[16];
+		valid = _get_index_path(file, b.path) && file->get_buffer(md5, 16) == 16 && _get_index_range(file, b.offset, b.size);
+		if (!valid)
+			break;
+
+		String md5_text = String::md5(md5);
+		lessons[md5_text] = b;
+		lesson_md5s[b.path] = md5_text;
+	}
+
+	for (int i = 0; i < media_count && valid; i++) {
+
+		Blob b;
+		valid = _get_index_path(file, b.path) && _get_index_range(file, b.offset, b.size);
+		if (!valid)
+			break;
+		media[b.path] = b;
+	}
+
+	if (!valid || file->eof_reached()) {
+
+		close();
+		ERR_EXPLAIN("Truncated or corrupt course pack: " + p_path);
+		ERR_FAIL_V(ERR_FILE_CORRUPT);
+	}
+
+	pack_path = p_path;
+
+	return OK;
+}
+
+void CoursePack::close() {
+
+	if (file) {
+		file->close();
+		memdelete(file);
+		file = NULL;
+	}
+
+	pack_path = String();
+	lessons.clear();
+	lesson_md5s.clear();
+	media.clear();
+}
+
+bool CoursePack::is_open() const {
+
+	return file != NULL;
+}
+
+bool CoursePack::has_lesson(const String &p_md5) const {
+
+	return lessons.has(p_md5);
+}
+
+String CoursePack::get_lesson_md5(const String &p_path) const {
+
+	const Map<String, String>::Element *E = lesson_md5s.find(p_path.simplify_path());
+	if (!E)
+		return String();
+
+	return E->get();
+}
+
+Dictionary CoursePack::get_lesson(const String &p_md5) {
+
+	ERR_FAIL_COND_V(!file, Dictionary());
+
+	const Map<String, Blob>::Element *E = lessons.find(p_md5);
+	ERR_FAIL_COND_V(!E, Dictionary());
+
+	// one seek and one read, the other lessons are never touched
+	const Blob &b = E->get();
+	Vector<uint8_t> buf;
+	buf.resize(b.size);
+	file->seek(b.offset);
+	int read = file->get_buffer(buf.ptr(), b.size);
+	ERR_FAIL_COND_V(read != (int)b.size, Dictionary());
+
+	Variant v;
+	Error err = decode_variant(v, buf.ptr(), b.size);
+	ERR_FAIL_COND_V(err != OK || v.get_type() != Variant::DICTIONARY, Dictionary());
+
+	return v;
+}
+
+StringArray CoursePack::get_lesson_list() const {
+
+	StringArray ret;
+	for (const Map<String, String>::Element *E = lesson_md5s.front(); E; E = E->next()) {
+
+		ret.push_back(E->key());
+	}
+
+	return ret;
+}
+
+bool CoursePack::has_media(const String &p_path) const {
+
+	return media.has(p_path.simplify_path());
+}
+
+FileAccess *CoursePack::open_media(const String &p_path) const {
+
+	ERR_FAIL_COND_V(!file, NULL);
+
+	const Map<String, Blob>::Element *E = media.find(p_path.simplify_path());
+	if (!E)
+		return NULL;
+
+	// the blob is read straight out of the pack, same as a file inside a .pck
+	PackedData::PackedFile pf;
+	pf.pack = pack_path;
+	pf.offset = E->get().offset;
+	pf.size = E->get().size;
+	zeromem(pf.md5, 16);
+	pf.src = NULL;
+
+	return memnew(FileAccessPack(p_path, pf));
+}
+
+ByteArray CoursePack::get_media(const String &p_path) const {
+
+	FileAccess *f = open_media(p_path);
+	ERR_FAIL_COND_V(!f, ByteArray());
+
+	ByteArray data;
+	data.resize(f->get_len());
+	{
+		ByteArray::Write w = data.write();
+		f->get_buffer(w.ptr(), data.size());
+	}
+
+	memdelete(f);
+
+	return data;
+}
+
+Error CoursePack::mount_media() {
+
+	ERR_FAIL_COND_V(!file, ERR_UNCONFIGURED);
+
+	PackedData *packed_data = PackedData::get_singleton();
+	if (!packed_data || packed_data->is_disabled())
+		return ERR_UNAVAILABLE;
+
+	if (!packed_source_course) {
+		packed_source_course = memnew(PackedSourceCourse);
+		packed_data->add_pack_source(packed_source_course); // PackedData frees it
+	}
+
+	// entries stay until exit, like a resource pack; they point at the pack file, not at this object
+	uint8_t md5[16];
+	zeromem(md5, 16);
+	for (const Map<String, Blob>::Element *E = media.front(); E; E = E->next()) {
+
+		packed_data->add_path(pack_path, E->key(), E->get().offset, E->get().size, md5, packed_source_course);
+	}
+
+	return OK;
+}
+
+CoursePack::CoursePack() {
+
+	file = NULL;
+}
+
+CoursePack::~CoursePack() {
+
+	close();
+}
@@ -0,0 +1,94 @@
+/*************************************************************************/
+/*  course_pack.h                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2017 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#ifndef COURSE_PACK_H
+#define COURSE_PACK_H
+
+#include "core/reference.h"
+#include "map.h"
+#include "os/file_access.h"
+
+#define COURSE_PACK_MAGIC 0x50434447 // "GDCP"
+#define COURSE_PACK_VERSION 1
+
+/*
+ * Course pack layout (little endian), written by CoursePacker:
+ *
+ *   magic, version, alignment, lesson count, media count, 11 reserved words
+ *   lesson index: path (pascal string), md5 (16 bytes), offset (64), size (64)
+ *   media index:  path (pascal string), offset (64), size (64)
+ *   aligned blobs: lessons are encode_variant()'d Dictionaries, media is raw
+ *
+ * Lessons are keyed by the md5 of their source file, the same key the client
+ * already uses for progress, so it never has to hash the lesson itself.
+ *
+ * Media paths are res:// paths. mount_media() adds them to PackedData, so
+ * FileAccess::open() and the resource loaders read them out of the pack.
+ */
+
+class CoursePack : public Reference {
+
+	OBJ_TYPE(CoursePack, Reference);
+
+	struct Blob {
+
+		String path;
+		uint64_t offset;
+		uint64_t size;
+	};
+
+	String pack_path;
+	FileAccess *file;
+
+	Map<String, Blob> lessons; // by md5 text
+	Map<String, String> lesson_md5s; // by path
+	Map<String, Blob> media; // by path
+
+	static void _bind_methods();
+
+public:
+	Error open(const String &p_path);
+	void close();
+	bool is_open() const;
+
+	bool has_lesson(const String &p_md5) const;
+	String get_lesson_md5(const String &p_path) const;
+	Dictionary get_lesson(const String &p_md5);
+	StringArray get_lesson_list() const;
+
+	bool has_media(const String &p_path) const;
+	FileAccess *open_media(const String &p_path) const;
+	ByteArray get_media(const String &p_path) const;
+	Error mount_media();
+
+	CoursePack();
+	~CoursePack();
+};
+
+#endif // COURSE_PACK_H
@@ -0,0 +1,333 @@
+/*************************************************************************/
+/*  course_packer.cpp                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2017 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "course_packer.h"
+
+#include "core/io/course_pack.h"
+#include "core/io/json.h"
+#include "core/io/marshalls.h"
+#include "core/io/md5.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+
+static uint64_t _align(uint64_t p_n, int p_alignment) {
+
+	if (p_alignment == 0)
+		return p_n;
+
+	uint64_t rest = p_n % p_alignment;
+	if (rest == 0)
+		return p_n;
+	else
+		return p_n + (p_alignment - rest);
+};
+
+static void _pad(FileAccess *p_file, int p_bytes) {
+
+	for (int i = 0; i < p_bytes; i++) {
+
+		p_file->store_8(0);
+	};
+};
+
+void CoursePacker::_bind_methods() {
+
+	ObjectTypeDB::bind_method(_MD("pack_start", "pack_name", "alignment"), &CoursePacker::pack_start);
+	ObjectTypeDB::bind_method(_MD("add_lesson", "pack_path", "source_path"), &CoursePacker::add_lesson);
+	ObjectTypeDB::bind_method(_MD("add_media", "pack_path", "source_path"), &CoursePacker::add_media);
+	ObjectTypeDB::bind_method(_MD("add_dir", "pack_path", "source_dir"), &CoursePacker::add_dir);
+	ObjectTypeDB::bind_method(_MD("flush", "verbose"), &CoursePacker::flush, DEFVAL(false));
+};
+
+Error CoursePacker::pack_start(const String &p_file, int p_alignment) {
+
+	if (file) {
+		memdelete(file);
+	};
+
+	file = FileAccess::open(p_file, FileAccess::WRITE);
+	if (file == NULL) {
+
+		return ERR_CANT_CREATE;
+	};
+
+	alignment = p_alignment;
+	lessons.clear();
+	media.clear();
+
+	return OK;
+};
+
+Error CoursePacker::add_lesson(const String &p_path, const String &p_src) {
+
+	FileAccess *f = FileAccess::open(p_src, FileAccess::READ);
+	if (!f) {
+		return ERR_FILE_CANT_OPEN;
+	};
+
+	File pf;
+	pf.path = p_path.simplify_path();
+	pf.src_path = p_src;
+	pf.offset_offset = 0;
+
+	// same digest File.get_md5() gives the client for this lesson
+	MD5_CTX md5;
+	MD5Init(&md5);
+
+	uint8_t buf[4096];
+	while (true) {
+
+		int read = f->get_buffer(buf, sizeof(buf));
+		if (read <= 0)
+			break;
+		MD5Update(&md5, buf, read);
+	};
+
+	MD5Final(&md5);
+	copymem(pf.md5, md5.digest, 16);
+
+	lessons.push_back(pf);
+
+	f->close();
+	memdelete(f);
+
+	return OK;
+};
+
+Error CoursePacker::add_media(const String &p_path, const String &p_src) {
+
+	if (!FileAccess::exists(p_src)) {
+		return ERR_FILE_CANT_OPEN;
+	};
+
+	File pf;
+	pf.path = p_path.simplify_path();
+	pf.src_path = p_src;
+	zeromem(pf.md5, 16);
+	pf.offset_offset = 0;
+
+	media.push_back(pf);
+
+	return OK;
+};
+
+Error CoursePacker::add_dir(const String &p_path, const String &p_src_dir) {
+
+	DirAccess *da = DirAccess::open(p_src_dir);
+	if (!da) {
+		return ERR_FILE_CANT_OPEN;
+	};
+
+	Error err = OK;
+	List<String> subdirs;
+
+	da->list_dir_begin();
+	String entry;
+	while ((entry = da->get_next()) != "") {
+
+		if (entry.begins_with("."))
+			continue;
+
+		if (da->current_is_dir()) {
+			subdirs.push_back(entry);
+		} else if (entry.extension() == "lesson") {
+			err = add_lesson(p_path.plus_file(entry), p_src_dir.plus_file(entry));
+		} else {
+			err = add_media(p_path.plus_file(entry), p_src_dir.plus_file(entry));
+		};
+
+		if (err != OK)
+			break;
+	};
+	da->list_dir_end();
+	memdelete(da);
+
+	for (List<String>::Element *E = subdirs.front(); E && err == OK; E = E->next()) {
+
+		err = add_dir(p_path.plus_file(E->get()), p_src_dir.plus_file(E->get()));
+	};
+
+	return err;
+};
+
+Error CoursePacker::_write_blob(File &p_file, const uint8_t *p_data, uint64_t p_size, uint64_t &r_ofs) {
+
+	if (p_data) {
+
+		file->store_buffer(p_data, p_size);
+	} else {
+
+		FileAccess *src = FileAccess::open(p_file.src_path, FileAccess::READ);
+		if (!src) {
+			return ERR_FILE_CANT_OPEN;
+		};
+
+		const uint32_t buf_max = 65536;
+		uint8_t *buf = memnew_arr(uint8_t, buf_max);
+
+		uint64_t to_write = p_size;
+		while (to_write > 0) {
+
+			int read = src->get_buffer(buf, MIN(to_write, buf_max));
+			if (read <= 0)
+				break;
+			file->store_buffer(buf, read);
+			to_write -= read;
+		};
+
+		memdelete_arr(buf);
+		src->close();
+		memdelete(src);
+	};
+
+	uint64_t pos = file->get_pos();
+	file->seek(p_file.offset_offset); // go back to store the blob's offset and size
+	file->store_64(r_ofs);
+	file->store_64(p_size);
+	file->seek(pos);
+
+	r_ofs = _align(r_ofs + p_size, alignment);
+	_pad(file, r_ofs - pos);
+
+	return OK;
+};
+
+Error CoursePacker::flush(bool p_verbose) {
+
+	if (!file) {
+		ERR_FAIL_COND_V(!file, ERR_INVALID_PARAMETER);
+		return ERR_INVALID_PARAMETER;
+	};
+
+	file->store_32(COURSE_PACK_MAGIC);
+	file->store_32(COURSE_PACK_VERSION);
+	file->store_32(alignment);
+	file->store_32(lessons.size());
+	file->store_32(media.size());
+
+	for (int i = 0; i < 11; i++) {
+
+		file->store_32(0); // reserved
+	};
+
+	// write the index, offsets and sizes are filled in as blobs are written
+
+	for (int i = 0; i < lessons.size(); i++) {
+
+		file->store_pascal_string(lessons[i].path);
+		file->store_buffer(lessons[i].md5, 16);
+		lessons[i].offset_offset = file->get_pos();
+		file->store_64(0); // offset
+		file->store_64(0); // size
+	};
+
+	for (int i = 0; i < media.size(); i++) {
+
+		file->store_pascal_string(media[i].path);
+		media[i].offset_offset = file->get_pos();
+		file->store_64(0); // offset
+		file->store_64(0); // size
+	};
+
+	uint64_t ofs = file->get_pos();
+	ofs = _align(ofs, alignment);
+
+	_pad(file, ofs - file->get_pos());
+
+	Error err = OK;
+	int count = 0;
+	int total = lessons.size() + media.size();
+
+	for (int i = 0; i < lessons.size() && err == OK; i++) {
+
+		// parse once here, so the client only decodes
+		Dictionary lesson(true);
+		String err_str;
+		int err_line = 0;
+		err = JSON::parse_file(lessons[i].src_path, lesson, err_str, err_line);
+		if (err != OK) {
+			ERR_EXPLAIN("Error parsing lesson '" + lessons[i].src_path + "': " + err_str + " at line: " + itos(err_line));
+			ERR_BREAK(err != OK);
+		};
+
+		int len;
+		err = encode_variant(lesson, NULL, len);
+		ERR_BREAK(err != OK);
+
+		Vector<uint8_t> buf;
+		buf.resize(len);
+		encode_variant(lesson, buf.ptr(), len);
+
+		err = _write_blob(lessons[i], buf.ptr(), len, ofs);
+		count += 1;
+	};
+
+	for (int i = 0; i < media.size() && err == OK; i++) {
+
+		FileAccess *src = FileAccess::open(media[i].src_path, FileAccess::READ);
+		if (!src) {
+			err = ERR_FILE_CANT_OPEN;
+			break;
+		};
+		uint64_t size = src->get_len();
+		src->close();
+		memdelete(src);
+
+		err = _write_blob(media[i], NULL, size, ofs);
+		count += 1;
+		if (p_verbose) {
+			if (count % 100 == 0) {
+				printf("%i/%i (%.2f)\r", count, total, float(count) / total * 100);
+				fflush(stdout);
+			};
+		};
+	};
+
+	if (p_verbose)
+		printf("\n");
+
+	file->close();
+	memdelete(file);
+	file = NULL;
+
+	return err;
+};
+
+CoursePacker::CoursePacker() {
+
+	file = NULL;
+	alignment = 0;
+};
+
+CoursePacker::~CoursePacker() {
+	if (file != NULL) {
+		memdelete(file);
+	};
+	file = NULL;
+};
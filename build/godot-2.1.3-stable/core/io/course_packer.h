@@ -0,0 +1,69 @@
+/*************************************************************************/
+/*  course_packer.h                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2017 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#ifndef COURSE_PACKER_H
+#define COURSE_PACKER_H
+
+#include "core/reference.h"
+
+class FileAccess;
+
+class CoursePacker : public Reference {
+
+	OBJ_TYPE(CoursePacker, Reference);
+
+	FileAccess *file;
+	int alignment;
+
+	static void _bind_methods();
+
+	struct File {
+
+		String path;
+		String src_path;
+		uint8_t md5[16];
+		uint64_t offset_offset;
+	};
+	Vector<File> lessons;
+	Vector<File> media;
+
+	Error _write_blob(File &p_file, const uint8_t *p_data, uint64_t p_size, uint64_t &r_ofs);
+
+public:
+	Error pack_start(const String &p_file, int p_alignment);
+	Error add_lesson(const String &p_path, const String &p_src);
+	Error add_media(const String &p_path, const String &p_src);
+	Error add_dir(const String &p_path, const String &p_src_dir);
+	Error flush(bool p_verbose = false);
+
+	CoursePacker();
+	~CoursePacker();
+};
+
+#endif // COURSE_PACKER_H
@@ -28,6 +28,7 @@
 /* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
 /*************************************************************************/
 #include "json.h"
+#include "os/file_access.h"
 #include "print_string.h"
 
 const char *JSON::tk_name[TK_MAX] = {
@@ -149,14 +150,19 @@ Error JSON::_get_token(const CharType *p_str, int &idx, int p_len, Token &r_toke
 
 				idx++;
 				String str;
+				int from = idx; //plain characters are appended in runs, not one by one
 				while (true) {
 					if (p_str[idx] == 0) {
 						r_err_str = "Unterminated String";
 						return ERR_PARSE_ERROR;
 					} else if (p_str[idx] == '"') {
+						if (idx > from)
+							str += String(&p_str[from], idx - from);
 						idx++;
 						break;
 					} else if (p_str[idx] == '\\') {
+						if (idx > from)
+							str += String(&p_str[from], idx - from);
 						//escaped characters...
 						idx++;
 						CharType next = p_str[idx];
@@ -218,11 +224,10 @@ Error JSON::_get_token(const CharType *p_str, int &idx, int p_len, Token &r_toke
 						}
 
 						str += res;
+						from = idx + 1;
 
-					} else {
-						if (p_str[idx] == '\n')
-							line++;
-						str += p_str[idx];
+					} else if (p_str[idx] == '\n') {
+						line++;
 					}
 					idx++;
 				}
@@ -450,3 +455,607 @@ Error JSON::parse(const String &p_json, Dictionary &r_ret, String &r_err_str, in
 
 	return _parse_object(r_ret, str, idx, len, r_err_line, r_err_str);
 }
+
+/* UTF-8 parser. Works directly on bytes, either from a memory block or
+ * streamed from a FileAccess in fixed size chunks, and builds each String
+ * once from a reusable scratch buffer. Object keys are interned per
+ * document, so repeated keys share a single String buffer. */
+
+#define JSON_STREAM_CHUNK_SIZE 16384
+#define JSON_KEY_CACHE_MIN_SIZE 64
+
+class JSONUTF8Parser {
+
+	struct KeyEntry {
+
+		uint32_t hash;
+		CharString raw;
+		String key;
+		bool used;
+
+		KeyEntry() {
+			hash = 0;
+			used = false;
+		}
+	};
+
+	FileAccess *file;
+	Vector<uint8_t> chunk;
+	int chunk_size;
+
+	const uint8_t *data;
+	int pos;
+	int len;
+
+	uint8_t *scratch;
+	int scratch_len;
+	int scratch_max;
+
+	Vector<KeyEntry> keys;
+	int key_count;
+
+	_FORCE_INLINE_ bool _refill() {
+
+		if (!file)
+			return false;
+
+		len = file->get_buffer(chunk.ptr(), chunk_size);
+		pos = 0;
+		if (len < 0)
+			len = 0;
+		return len > 0;
+	}
+
+	_FORCE_INLINE_ int _get() {
+
+		if (pos >= len && !_refill())
+			return -1;
+		return data[pos++];
+	}
+
+	_FORCE_INLINE_ void _scratch_push(const uint8_t *p_bytes, int p_count) {
+
+		if (scratch_len + p_count > scratch_max) {
+
+			scratch_max = nearest_power_of_2(scratch_len + p_count);
+			scratch = (uint8_t *)memrealloc(scratch, scratch_max);
+		}
+		copymem(&scratch[scratch_len], p_bytes, p_count);
+		scratch_len += p_count;
+	}
+
+	void _scratch_push_unicode(uint32_t p_char);
+	void _make_string(String &r_str, bool p_utf8) const;
+	String _intern_key(bool p_utf8);
+
+	int _skip_space();
+	Error _parse_string(String &r_str, bool p_key);
+	Error _parse_number(Variant &r_value, int p_first);
+	Error _parse_identifier(Variant &r_value, int p_first);
+	Error _parse_value(Variant &r_value, int p_first);
+	Error _parse_array(Array &r_array);
+	Error _parse_object(Dictionary &r_object);
+
+public:
+	String err_str;
+	int line;
+
+	Error parse(Dictionary &r_ret);
+
+	JSONUTF8Parser(const uint8_t *p_data, int p_len);
+	JSONUTF8Parser(FileAccess *p_file);
+	~JSONUTF8Parser();
+};
+
+JSONUTF8Parser::JSONUTF8Parser(const uint8_t *p_data, int p_len) {
+
+	file = NULL;
+	chunk_size = 0;
+	data = p_data;
+	pos = 0;
+	len = p_len;
+	scratch = NULL;
+	scratch_len = 0;
+	scratch_max = 0;
+	key_count = 0;
+	line = 0;
+}
+
+JSONUTF8Parser::JSONUTF8Parser(FileAccess *p_file) {
+
+	file = p_file;
+	chunk_size = CLAMP(int(p_file->get_len()), 1, JSON_STREAM_CHUNK_SIZE); //small files don't need a full chunk
+	chunk.resize(chunk_size);
+	data = chunk.ptr();
+	pos = 0;
+	len = 0;
+	scratch = NULL;
+	scratch_len = 0;
+	scratch_max = 0;
+	key_count = 0;
+	line = 0;
+}
+
+JSONUTF8Parser::~JSONUTF8Parser() {
+
+	if (scratch)
+		memfree(scratch);
+}
+
+void JSONUTF8Parser::_scratch_push_unicode(uint32_t p_char) {
+
+	uint8_t buf[4];
+	int count;
+
+	if (p_char < 0x80) {
+		buf[0] = p_char;
+		count = 1;
+	} else if (p_char < 0x800) {
+		buf[0] = 0xC0 | (p_char >> 6);
+		buf[1] = 0x80 | (p_char & 0x3F);
+		count = 2;
+	} else if (p_char < 0x10000) {
+		buf[0] = 0xE0 | (p_char >> 12);
+		buf[1] = 0x80 | ((p_char >> 6) & 0x3F);
+		buf[2] = 0x80 | (p_char & 0x3F);
+		count = 3;
+	} else {
+		buf[0] = 0xF0 | (p_char >> 18);
+		buf[1] = 0x80 | ((p_char >> 12) & 0x3F);
+		buf[2] = 0x80 | ((p_char >> 6) & 0x3F);
+		buf[3] = 0x80 | (p_char & 0x3F);
+		count = 4;
+	}
+
+	_scratch_push(buf, count);
+}
+
+void JSONUTF8Parser::_make_string(String &r_str, bool p_utf8) const {
+
+	if (scratch_len == 0) {
+		r_str = String();
+	} else if (p_utf8) {
+		r_str.parse_utf8((const char *)scratch, scratch_len);
+	} else {
+		//plain ASCII, widen in a single pass
+		r_str.resize(scratch_len + 1);
+		CharType *dst = r_str.ptr();
+		for (int i = 0; i < scratch_len; i++)
+			dst[i] = scratch[i];
+		dst[scratch_len] = 0;
+	}
+}
+
+String JSONUTF8Parser::_intern_key(bool p_utf8) {
+
+	uint32_t hash = hash_djb2_buffer(scratch, scratch_len);
+
+	if (key_count * 2 >= keys.size()) {
+
+		//grow and rehash, open addressing needs to stay at most half full
+		Vector<KeyEntry> old = keys;
+		keys.clear();
+		keys.resize(MAX(old.size() * 2, JSON_KEY_CACHE_MIN_SIZE));
+		uint32_t mask = keys.size() - 1;
+
+		for (int i = 0; i < old.size(); i++) {
+
+			if (!old[i].used)
+				continue;
+			uint32_t idx = old[i].hash & mask;
+			while (keys[idx].used)
+				idx = (idx + 1) & mask;
+			keys[idx] = old[i];
+		}
+	}
+
+	uint32_t mask = keys.size() - 1;
+	uint32_t idx = hash & mask;
+
+	while (keys[idx].used) {
+
+		const KeyEntry &e = keys[idx];
+		if (e.hash == hash && e.raw.length() == scratch_len && memcmp(e.raw.ptr(), scratch, scratch_len) == 0)
+			return e.key;
+		idx = (idx + 1) & mask;
+	}
+
+	KeyEntry &e = keys[idx];
+	e.used = true;
+	e.hash = hash;
+	e.raw.resize(scratch_len + 1);
+	copymem(e.raw.ptr(), scratch, scratch_len);
+	e.raw[scratch_len] = 0;
+	_make_string(e.key, p_utf8);
+	key_count++;
+
+	return e.key;
+}
+
+int JSONUTF8Parser::_skip_space() {
+
+	while (true) {
+
+		if (pos >= len && !_refill())
+			return -1;
+
+		uint8_t c = data[pos++];
+		if (c == '\n')
+			line++;
+		else if (c > 32)
+			return c;
+	}
+}
+
+Error JSONUTF8Parser::_parse_string(String &r_str, bool p_key) {
+
+	scratch_len = 0;
+	uint8_t high = 0; //any byte with the high bit set means the string is not plain ASCII
+	uint32_t lead = 0; //a \u lead surrogate, waiting to see if a trail surrogate follows
+
+	while (true) {
+
+		if (pos >= len && !_refill()) {
+			err_str = "Unterminated String";
+			return ERR_PARSE_ERROR;
+		}
+
+		//copy the run of plain bytes left in this chunk in one go
+		int from = pos;
+		while (pos < len) {
+
+			uint8_t c = data[pos];
+			if (c == '"' || c == '\\' || c == 0)
+				break;
+			if (c == '\n')
+				line++;
+			high |= c;
+			pos++;
+		}
+
+		if (pos > from) {
+
+			if (lead) {
+				_scratch_push_unicode(lead);
+				lead = 0;
+			}
+			_scratch_push(&data[from], pos - from);
+		}
+
+		if (pos >= len)
+			continue;
+
+		uint8_t c = data[pos++];
+
+		if (c == '"') {
+			break;
+		} else if (c == 0) {
+			err_str = "Unterminated String";
+			return ERR_PARSE_ERROR;
+		}
+
+		//escaped characters...
+		int next = _get();
+		if (next <= 0) {
+			err_str = "Unterminated String";
+			return ERR_PARSE_ERROR;
+		}
+
+		uint32_t res = 0;
+
+		switch (next) {
+
+			case 'b': res = 8; break;
+			case 't': res = 9; break;
+			case 'n': res = 10; break;
+			case 'f': res = 12; break;
+			case 'r': res = 13; break;
+			case 'u': {
+
+				for (int j = 0; j < 4; j++) {
+
+					int h = _get();
+					if (h <= 0) {
+						err_str = "Unterminated String";
+						return ERR_PARSE_ERROR;
+					}
+
+					uint32_t v;
+					if (h >= '0' && h <= '9') {
+						v = h - '0';
+					} else if (h >= 'a' && h <= 'f') {
+						v = h - 'a' + 10;
+					} else if (h >= 'A' && h <= 'F') {
+						v = h - 'A' + 10;
+					} else {
+						err_str = "Malformed hex constant in string";
+						return ERR_PARSE_ERROR;
+					}
+
+					res <<= 4;
+					res |= v;
+				}
+
+			} break;
+			default: {
+				res = next;
+			} break;
+		}
+
+		if (res >= 0x80)
+			high = 0x80;
+
+		if (lead) {
+
+			//pairs become a single character, like the same character written as raw UTF-8
+			if (next == 'u' && res >= 0xDC00 && res <= 0xDFFF)
+				res = 0x10000 + ((lead - 0xD800) << 10) + (res - 0xDC00);
+			else
+				_scratch_push_unicode(lead);
+			lead = 0;
+		}
+
+		if (next == 'u' && res >= 0xD800 && res <= 0xDBFF) {
+			lead = res;
+			continue;
+		}
+
+		_scratch_push_unicode(res);
+	}
+
+	if (lead)
+		_scratch_push_unicode(lead);
+
+	if (p_key)
+		r_str = _intern_key(high & 0x80);
+	else
+		_make_string(r_str, high & 0x80);
+
+	return OK;
+}
+
+Error JSONUTF8Parser::_parse_number(Variant &r_value, int p_first) {
+
+	char buf[64];
+	int count = 0;
+	buf[count++] = p_first;
+
+	while (true) {
+
+		if (pos >= len && !_refill())
+			break;
+
+		uint8_t c = data[pos];
+		if (!((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '-' || c == '+'))
+			break;
+
+		if (count == sizeof(buf) - 1) {
+			err_str = "Number too long";
+			return ERR_PARSE_ERROR;
+		}
+
+		buf[count++] = c;
+		pos++;
+	}
+
+	buf[count] = 0;
+	r_value = String::to_double(buf);
+	return OK;
+}
+
+Error JSONUTF8Parser::_parse_identifier(Variant &r_value, int p_first) {
+
+	char buf[16];
+	int count = 0;
+	buf[count++] = p_first;
+
+	while (true) {
+
+		if (pos >= len && !_refill())
+			break;
+
+		uint8_t c = data[pos];
+		if (!((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')))
+			break;
+
+		if (count < (int)sizeof(buf) - 1)
+			buf[count++] = c;
+		pos++;
+	}
+
+	buf[count] = 0;
+
+	if (strcmp(buf, "true") == 0)
+		r_value = true;
+	else if (strcmp(buf, "false") == 0)
+		r_value = false;
+	else if (strcmp(buf, "null") == 0)
+		r_value = Variant();
+	else {
+		err_str = "Expected 'true','false' or 'null', got '" + String(buf) + "'.";
+		return ERR_PARSE_ERROR;
+	}
+
+	return OK;
+}
+
+Error JSONUTF8Parser::_parse_value(Variant &r_value, int p_first) {
+
+	switch (p_first) {
+
+		case '{': {
+
+			Dictionary d(true);
+			Error err = _parse_object(d);
+			if (err)
+				return err;
+			r_value = d;
+			return OK;
+		} break;
+		case '[': {
+
+			Array a(true);
+			Error err = _parse_array(a);
+			if (err)
+				return err;
+			r_value = a;
+			return OK;
+		} break;
+		case '"': {
+
+			String str;
+			Error err = _parse_string(str, false);
+			if (err)
+				return err;
+			r_value = str;
+			return OK;
+		} break;
+		case -1: {
+
+			err_str = "Expected value, got EOF.";
+			return ERR_PARSE_ERROR;
+		} break;
+		default: {
+
+			if (p_first == '-' || (p_first >= '0' && p_first <= '9'))
+				return _parse_number(r_value, p_first);
+
+			if ((p_first >= 'A' && p_first <= 'Z') || (p_first >= 'a' && p_first <= 'z'))
+				return _parse_identifier(r_value, p_first);
+
+			err_str = "Unexpected character.";
+			return ERR_PARSE_ERROR;
+		}
+	}
+
+	return ERR_PARSE_ERROR;
+}
+
+Error JSONUTF8Parser::_parse_array(Array &r_array) {
+
+	bool need_comma = false;
+
+	while (true) {
+
+		int c = _skip_space();
+
+		if (c == ']')
+			return OK;
+
+		if (need_comma) {
+
+			if (c != ',') {
+				err_str = "Expected ','";
+				return ERR_PARSE_ERROR;
+			}
+			need_comma = false;
+			continue;
+		}
+
+		Variant v;
+		Error err = _parse_value(v, c);
+		if (err)
+			return err;
+
+		r_array.push_back(v);
+		need_comma = true;
+	}
+
+	return ERR_PARSE_ERROR;
+}
+
+Error JSONUTF8Parser::_parse_object(Dictionary &r_object) {
+
+	bool need_comma = false;
+
+	while (true) {
+
+		int c = _skip_space();
+
+		if (c == '}')
+			return OK;
+
+		if (need_comma) {
+
+			if (c != ',') {
+				err_str = "Expected '}' or ','";
+				return ERR_PARSE_ERROR;
+			}
+			need_comma = false;
+			continue;
+		}
+
+		if (c != '"') {
+			err_str = "Expected key";
+			return ERR_PARSE_ERROR;
+		}
+
+		String key;
+		Error err = _parse_string(key, true);
+		if (err)
+			return err;
+
+		if (_skip_space() != ':') {
+			err_str = "Expected ':'";
+			return ERR_PARSE_ERROR;
+		}
+
+		Variant v;
+		err = _parse_value(v, _skip_space());
+		if (err)
+			return err;
+
+		r_object[key] = v;
+		need_comma = true;
+	}
+
+	return ERR_PARSE_ERROR;
+}
+
+Error JSONUTF8Parser::parse(Dictionary &r_ret) {
+
+	if (file)
+		_refill();
+
+	/* HANDLE BOM (Byte Order Mark) */
+	if (len - pos >= 3 && data[pos] == 0xEF && data[pos + 1] == 0xBB && data[pos + 2] == 0xBF)
+		pos += 3;
+
+	if (_skip_space() != '{') {
+
+		err_str = "Expected '{'";
+		return ERR_PARSE_ERROR;
+	}
+
+	return _parse_object(r_ret);
+}
+
+Error JSON::parse_utf8(const uint8_t *p_utf8, int p_len, Dictionary &r_ret, String &r_err_str, int &r_err_line) {
+
+	JSONUTF8Parser parser(p_utf8, p_len);
+	Error err = parser.parse(r_ret);
+	r_err_str = parser.err_str;
+	r_err_line = parser.line;
+	return err;
+}
+
+Error JSON::parse_file(const String &p_path, Dictionary &r_ret, String &r_err_str, int &r_err_line) {
+
+	Error err;
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ, &err);
+	if (!f) {
+		r_err_str = "Can't open file: " + p_path;
+		r_err_line = 0;
+		return err;
+	}
+
+	JSONUTF8Parser parser(f);
+	err = parser.parse(r_ret);
+	r_err_str = parser.err_str;
+	r_err_line = parser.line;
+
+	f->close();
+	memdelete(f);
+
+	return err;
+}
@@ -74,6 +74,10 @@ class JSON {
 public:
 	static String print(const Dictionary &p_dict);
 	static Error parse(const String &p_json, Dictionary &r_ret, String &r_err_str, int &r_err_line);
+
+	// byte oriented parsers, the document is never converted to a String as a whole
+	static Error parse_utf8(const uint8_t *p_utf8, int p_len, Dictionary &r_ret, String &r_err_str, int &r_err_line);
+	static Error parse_file(const String &p_path, Dictionary &r_ret, String &r_err_str, int &r_err_line);
 };
 
 #endif // JSON_H
@@ -102,6 +102,7 @@ class ResourceFormatLoaderXML : public ResourceFormatLoader {
 public:
 	static ResourceFormatLoaderXML *singleton;
 	virtual Ref<ResourceInteractiveLoader> load_interactive(const String &p_path, Error *r_error = NULL);
+	virtual bool can_load_interactive() const { return true; }
 	virtual void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const;
 	virtual void get_recognized_extensions(List<String> *p_extensions) const;
 	virtual bool handles_type(const String &p_type) const;
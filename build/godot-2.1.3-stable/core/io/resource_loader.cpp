@@ -161,12 +161,32 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 	local_path = find_complete_path(local_path, p_type_hint);
 	ERR_FAIL_COND_V(local_path == "", RES());
 
-	if (!p_no_cache && ResourceCache::has(local_path)) {
+	if (!p_no_cache) {
 
-		if (OS::get_singleton()->is_stdout_verbose())
-			print_line("load resource: " + local_path + " (cached)");
+		RES cached = ResourceCache::get_ref(local_path);
+		if (cached.is_valid()) {
+
+			if (OS::get_singleton()->is_stdout_verbose())
+				print_line("load resource: " + local_path + " (cached)");
+
+			return cached;
+		}
+
+		if (thread_load_mutex) {
+
+			thread_load_mutex->lock();
+
+			ThreadLoadTask **task = thread_load_tasks.getptr(local_path);
+			//a resource requesting itself while loading would wait forever, let it load plainly
+			bool loading_here = task && (*task)->polling && (*task)->loader_id == Thread::get_caller_ID();
 
-		return RES(ResourceCache::get(local_path));
+			if (task && !loading_here) {
+				//share the load with a threaded request for the same path
+				return _thread_load_wait(*task, false, r_error);
+			}
+
+			thread_load_mutex->unlock();
+		}
 	}
 
 	String remapped_path = PathRemap::get_singleton()->get_remap(local_path);
@@ -187,17 +207,7 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 		RES res = loader[i]->load(remapped_path, local_path, r_error);
 		if (res.is_null())
 			continue;
-		if (!p_no_cache)
-			res->set_path(local_path);
-#ifdef TOOLS_ENABLED
-
-		res->set_edited(false);
-		if (timestamp_on_load) {
-			uint64_t mt = FileAccess::get_modified_time(remapped_path);
-			//printf("mt %s: %lli\n",remapped_path.utf8().get_data(),mt);
-			res->set_last_modified_time(mt);
-		}
-#endif
+		_finish_load(res.ptr(), p_no_cache ? String() : local_path, remapped_path);
 
 		return res;
 	}
@@ -211,6 +221,20 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 	return RES();
 }
 
+void ResourceLoader::_finish_load(Resource *p_resource, const String &p_local_path, const String &p_remapped_path) {
+
+	if (p_local_path != "")
+		p_resource->set_path(p_local_path);
+#ifdef TOOLS_ENABLED
+
+	p_resource->set_edited(false);
+	if (timestamp_on_load) {
+		uint64_t mt = FileAccess::get_modified_time(p_remapped_path);
+		p_resource->set_last_modified_time(mt);
+	}
+#endif
+}
+
 Ref<ResourceImportMetadata> ResourceLoader::load_import_metadata(const String &p_path) {
 
 	String local_path;
@@ -294,12 +318,12 @@ Ref<ResourceInteractiveLoader> ResourceLoader::load_interactive(const String &p_
 	local_path = find_complete_path(local_path, p_type_hint);
 	ERR_FAIL_COND_V(local_path == "", Ref<ResourceInteractiveLoader>());
 
-	if (!p_no_cache && ResourceCache::has(local_path)) {
+	Ref<Resource> res_cached = p_no_cache ? RES() : ResourceCache::get_ref(local_path);
+	if (res_cached.is_valid()) {
 
 		if (OS::get_singleton()->is_stdout_verbose())
 			print_line("load resource: " + local_path + " (cached)");
 
-		Ref<Resource> res_cached = ResourceCache::get(local_path);
 		Ref<ResourceInteractiveLoaderDefault> ril = Ref<ResourceInteractiveLoaderDefault>(memnew(ResourceInteractiveLoaderDefault));
 
 		ril->resource = res_cached;
@@ -457,6 +481,524 @@ String ResourceLoader::get_resource_type(const String &p_path) {
 
 	return "";
 }
+
+/* THREADED LOADING */
+
+String ResourceLoader::_get_local_path(const String &p_path) {
+
+	if (p_path.is_rel_path())
+		return "res://" + p_path;
+	return Globals::get_singleton()->localize_path(p_path);
+}
+
+void ResourceLoader::_thread_load_start() {
+
+	//called with thread_load_mutex held
+	if (thread_load_started)
+		return;
+	thread_load_started = true;
+
+	int threads = GLOBAL_DEF("resource/loader_threads", CLAMP(OS::get_singleton()->get_processor_count() - 1, 1, 4));
+
+	if (OS::get_singleton()->get_render_thread_mode() == OS::RENDER_THREAD_UNSAFE) {
+		//loaders would touch the visual server from other threads, step from the calling thread instead
+		threads = 0;
+	}
+
+	if (threads <= 0)
+		return;
+
+	thread_load_semaphore = Semaphore::create();
+	if (!thread_load_semaphore)
+		return;
+
+	for (int i = 0; i < threads; i++) {
+
+		Thread *thread = Thread::create(_thread_load_worker, NULL);
+		if (!thread)
+			break;
+		thread_load_workers.push_back(thread);
+	}
+}
+
+ResourceLoader::ThreadLoadTask *ResourceLoader::_thread_load_get_task(const String &p_local_path, const String &p_type_hint, bool p_queue) {
+
+	//called with thread_load_mutex held
+	ThreadLoadTask **existing = thread_load_tasks.getptr(p_local_path);
+	if (existing)
+		return *existing;
+
+	ThreadLoadTask *task = memnew(ThreadLoadTask);
+	task->local_path = p_local_path;
+	task->type_hint = p_type_hint;
+	task->status = THREAD_LOAD_IN_PROGRESS;
+	task->loader_id = 0;
+	task->polling = false;
+	task->requests = 0;
+	task->users = 0;
+	task->stage = 0;
+	task->stage_count = 0;
+	task->error = OK;
+	task->waiters = 0;
+	task->semaphore = NULL;
+
+	RES cached = ResourceCache::get_ref(p_local_path);
+	if (cached.is_valid()) {
+
+		task->status = THREAD_LOAD_LOADED;
+		task->resource = cached;
+		task->stage = 1;
+		task->stage_count = 1;
+	} else if (p_queue && thread_load_workers.size()) {
+
+		thread_load_queue.push_back(p_local_path);
+		thread_load_semaphore->post();
+	}
+
+	thread_load_tasks[p_local_path] = task;
+	return task;
+}
+
+void ResourceLoader::_thread_load_queue_dependencies(ThreadLoadTask *p_task) {
+
+	//scenes load their dependencies one after the other, hand them to the other workers first
+	if (get_resource_type(p_task->local_path) != "PackedScene")
+		return;
+
+	List<String> dependencies;
+	get_dependencies(p_task->local_path, &dependencies);
+
+	thread_load_mutex->lock();
+
+	if (thread_load_workers.size() > 1) {
+
+		for (List<String>::Element *E = dependencies.front(); E; E = E->next()) {
+
+			String path = _get_local_path(E->get());
+			if (!thread_load_tasks.has(path) && ResourceCache::has(path))
+				continue;
+
+			ThreadLoadTask *dependency = _thread_load_get_task(path, "", true);
+			dependency->requests++;
+			p_task->dependencies.push_back(path);
+		}
+	}
+
+	thread_load_mutex->unlock();
+}
+
+Error ResourceLoader::_thread_load_open(ThreadLoadTask *p_task, Ref<ResourceInteractiveLoader> &r_interactive, RES &r_resource) {
+
+	//like load_interactive(), but formats that can't load in stages are loaded right away
+	//with their local path, the same as load() does
+	RES cached = ResourceCache::get_ref(p_task->local_path);
+	if (cached.is_valid()) {
+
+		r_resource = cached;
+		return OK;
+	}
+
+	String remapped_path = PathRemap::get_singleton()->get_remap(p_task->local_path);
+
+	if (OS::get_singleton()->is_stdout_verbose())
+		print_line("load resource: " + remapped_path + " (threaded)");
+
+	String extension = remapped_path.extension();
+	bool found = false;
+	Error err = OK;
+
+	for (int i = 0; i < loader_count; i++) {
+
+		if (!loader[i]->recognize(extension))
+			continue;
+		if (p_task->type_hint != "" && !loader[i]->handles_type(p_task->type_hint))
+			continue;
+		found = true;
+
+		if (loader[i]->can_load_interactive()) {
+
+			r_interactive = loader[i]->load_interactive(remapped_path, &err);
+			if (r_interactive.is_null())
+				continue;
+			r_interactive->set_local_path(p_task->local_path);
+			return OK;
+		}
+
+		r_resource = loader[i]->load(remapped_path, p_task->local_path, &err);
+		if (r_resource.is_null())
+			continue;
+		_finish_load(r_resource.ptr(), p_task->local_path, remapped_path);
+		return OK;
+	}
+
+	if (found) {
+		ERR_EXPLAIN("Failed loading resource: " + p_task->local_path);
+	} else {
+		ERR_EXPLAIN("No loader found for resource: " + p_task->local_path);
+	}
+	ERR_FAIL_V(!found ? ERR_FILE_UNRECOGNIZED : (err != OK ? err : ERR_CANT_OPEN));
+}
+
+bool ResourceLoader::_thread_load_poll(ThreadLoadTask *p_task) {
+
+	//called by the thread that claimed the task, returns true once it is done
+	Error err;
+
+	if (p_task->interactive.is_null()) {
+
+		_thread_load_queue_dependencies(p_task);
+
+		Ref<ResourceInteractiveLoader> interactive;
+		RES resource;
+		err = _thread_load_open(p_task, interactive, resource);
+
+		thread_load_mutex->lock();
+
+		if (interactive.is_valid()) {
+
+			p_task->interactive = interactive;
+			p_task->stage_count = interactive->get_stage_count();
+			thread_load_mutex->unlock();
+			return false;
+		}
+
+		p_task->resource = resource;
+		p_task->stage_count = 1;
+
+	} else {
+
+		err = p_task->interactive->poll();
+
+		RES resource;
+		if (err == ERR_FILE_EOF) {
+
+			//same as load(), so a plain load() afterwards finds it in the cache
+			resource = p_task->interactive->get_resource();
+			if (resource.is_valid())
+				_finish_load(resource.ptr(), p_task->local_path, PathRemap::get_singleton()->get_remap(p_task->local_path));
+		}
+
+		thread_load_mutex->lock();
+
+		if (err == OK) {
+
+			p_task->stage = p_task->interactive->get_stage();
+			thread_load_mutex->unlock();
+			return false;
+		}
+
+		if (err == ERR_FILE_EOF) {
+
+			p_task->resource = resource;
+			err = resource.is_valid() ? OK : ERR_CANT_OPEN;
+		}
+
+		p_task->interactive.unref();
+	}
+
+	p_task->status = err == OK ? THREAD_LOAD_LOADED : THREAD_LOAD_FAILED;
+	p_task->error = err;
+	p_task->stage = p_task->stage_count;
+
+	for (List<String>::Element *E = p_task->dependencies.front(); E; E = E->next()) {
+
+		ThreadLoadTask **dependency = thread_load_tasks.getptr(E->get());
+		if (!dependency)
+			continue;
+		(*dependency)->requests--;
+		_thread_load_release(*dependency);
+	}
+	p_task->dependencies.clear();
+
+	_thread_load_wake(p_task);
+
+	thread_load_mutex->unlock();
+
+	return true;
+}
+
+void ResourceLoader::_thread_load_run(ThreadLoadTask *p_task) {
+
+	while (!_thread_load_poll(p_task)) {
+	}
+
+	thread_load_mutex->lock();
+	p_task->polling = false;
+	thread_load_mutex->unlock();
+}
+
+RES ResourceLoader::_thread_load_wait(ThreadLoadTask *p_task, bool p_release_request, Error *r_error) {
+
+	//called with thread_load_mutex held, returns with it released
+	Thread::ID caller = Thread::get_caller_ID();
+	p_task->users++;
+
+	while (p_task->status == THREAD_LOAD_IN_PROGRESS) {
+
+		if (!p_task->polling) {
+			//nobody is working on it right now, finish it from this thread
+			p_task->loader_id = caller;
+			p_task->polling = true;
+			thread_load_mutex->unlock();
+			_thread_load_run(p_task);
+			thread_load_mutex->lock();
+			continue;
+		}
+
+		if (p_task->loader_id == caller)
+			break; //requested from inside its own load
+
+		if (!p_task->semaphore)
+			p_task->semaphore = Semaphore::create();
+
+		bool main_thread = thread_load_wait_notify && caller == Thread::get_main_ID();
+		if (main_thread)
+			thread_load_main_wait = p_task;
+		p_task->waiters++;
+
+		thread_load_mutex->unlock();
+
+		if (main_thread) {
+			//the worker may be waiting on calls queued to the main thread, it wakes us up when it queues more
+			thread_load_wait_notify();
+		}
+
+		if (p_task->semaphore)
+			p_task->semaphore->wait();
+		else
+			OS::get_singleton()->delay_usec(1000);
+
+		thread_load_mutex->lock();
+
+		p_task->waiters--;
+		if (main_thread)
+			thread_load_main_wait = NULL;
+	}
+
+	RES resource = p_task->resource;
+	Error err = p_task->status == THREAD_LOAD_IN_PROGRESS ? ERR_BUSY : p_task->error;
+
+	p_task->users--;
+	if (p_release_request && p_task->requests > 0)
+		p_task->requests--;
+	_thread_load_release(p_task);
+
+	thread_load_mutex->unlock();
+
+	if (r_error)
+		*r_error = err;
+
+	return resource;
+}
+
+void ResourceLoader::_thread_load_release(ThreadLoadTask *p_task) {
+
+	//called with thread_load_mutex held
+	if (p_task->status == THREAD_LOAD_IN_PROGRESS || p_task->requests > 0 || p_task->users > 0)
+		return;
+
+	thread_load_tasks.erase(p_task->local_path);
+	if (p_task->semaphore)
+		memdelete(p_task->semaphore);
+	memdelete(p_task);
+}
+
+void ResourceLoader::_thread_load_wake(ThreadLoadTask *p_task) {
+
+	//called with thread_load_mutex held, once the task is done or nobody is polling it anymore
+	if (!p_task->semaphore)
+		return;
+
+	for (int i = 0; i < p_task->waiters; i++) {
+		p_task->semaphore->post();
+	}
+}
+
+void ResourceLoader::wake_thread_load_wait() {
+
+	if (!thread_load_mutex)
+		return;
+
+	thread_load_mutex->lock();
+	if (thread_load_main_wait && thread_load_main_wait->semaphore)
+		thread_load_main_wait->semaphore->post();
+	thread_load_mutex->unlock();
+}
+
+void ResourceLoader::_thread_load_worker(void *p_ud) {
+
+	Thread::set_name("ResourceLoader");
+
+	while (true) {
+
+		thread_load_semaphore->wait();
+		thread_load_mutex->lock();
+
+		if (thread_load_exit) {
+			thread_load_mutex->unlock();
+			break;
+		}
+
+		if (thread_load_queue.empty()) {
+			thread_load_mutex->unlock();
+			continue;
+		}
+
+		String path = thread_load_queue.front()->get();
+		thread_load_queue.pop_front();
+
+		ThreadLoadTask **existing = thread_load_tasks.getptr(path);
+		if (!existing || (*existing)->status != THREAD_LOAD_IN_PROGRESS || (*existing)->polling) {
+			//already loaded, or being loaded by a thread that needed it first
+			thread_load_mutex->unlock();
+			continue;
+		}
+
+		ThreadLoadTask *task = *existing;
+		task->loader_id = Thread::get_caller_ID();
+		task->polling = true;
+		task->users++;
+
+		thread_load_mutex->unlock();
+
+		_thread_load_run(task);
+
+		thread_load_mutex->lock();
+		task->users--;
+		_thread_load_release(task);
+		thread_load_mutex->unlock();
+	}
+}
+
+Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint) {
+
+	ERR_FAIL_COND_V(!thread_load_mutex, ERR_UNCONFIGURED);
+
+	String local_path = find_complete_path(_get_local_path(p_path), p_type_hint);
+	ERR_FAIL_COND_V(local_path == "", ERR_FILE_NOT_FOUND);
+
+	thread_load_mutex->lock();
+	_thread_load_start();
+	ThreadLoadTask *task = _thread_load_get_task(local_path, p_type_hint, true);
+	task->requests++;
+	thread_load_mutex->unlock();
+
+	return OK;
+}
+
+ResourceLoader::ThreadLoadStatus ResourceLoader::load_threaded_get_status(const String &p_path, float *r_progress) {
+
+	if (r_progress)
+		*r_progress = 0;
+
+	ERR_FAIL_COND_V(!thread_load_mutex, THREAD_LOAD_INVALID_RESOURCE);
+
+	String local_path = find_complete_path(_get_local_path(p_path), "");
+
+	thread_load_mutex->lock();
+
+	ThreadLoadTask **existing = thread_load_tasks.getptr(local_path);
+	if (!existing) {
+		thread_load_mutex->unlock();
+		return THREAD_LOAD_INVALID_RESOURCE;
+	}
+
+	ThreadLoadTask *task = *existing;
+
+	if (task->status == THREAD_LOAD_IN_PROGRESS && !task->polling && thread_load_workers.empty()) {
+		//no worker threads, advance the load a stage per query
+		task->loader_id = Thread::get_caller_ID();
+		task->polling = true;
+		task->users++;
+		thread_load_mutex->unlock();
+
+		_thread_load_poll(task);
+
+		thread_load_mutex->lock();
+		task->polling = false;
+		task->users--;
+		_thread_load_wake(task); //a waiting thread can take over the load
+	}
+
+	ThreadLoadStatus status = task->status;
+	if (r_progress) {
+		if (status == THREAD_LOAD_LOADED)
+			*r_progress = 1.0;
+		else if (task->stage_count > 0)
+			*r_progress = float(task->stage) / float(task->stage_count);
+	}
+
+	_thread_load_release(task);
+	thread_load_mutex->unlock();
+
+	return status;
+}
+
+RES ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
+
+	if (r_error)
+		*r_error = ERR_INVALID_PARAMETER;
+
+	ERR_FAIL_COND_V(!thread_load_mutex, RES());
+
+	String local_path = find_complete_path(_get_local_path(p_path), "");
+
+	thread_load_mutex->lock();
+
+	ThreadLoadTask **existing = thread_load_tasks.getptr(local_path);
+	if (!existing) {
+		thread_load_mutex->unlock();
+		ERR_EXPLAIN("Resource was not requested for threaded loading: " + p_path);
+		ERR_FAIL_V(RES());
+	}
+
+	return _thread_load_wait(*existing, true, r_error);
+}
+
+void ResourceLoader::initialize() {
+
+	if (!thread_load_mutex)
+		thread_load_mutex = Mutex::create();
+}
+
+void ResourceLoader::finalize() {
+
+	if (!thread_load_mutex)
+		return;
+
+	thread_load_mutex->lock();
+	thread_load_exit = true;
+	thread_load_mutex->unlock();
+
+	for (int i = 0; i < thread_load_workers.size(); i++) {
+		thread_load_semaphore->post();
+	}
+
+	for (int i = 0; i < thread_load_workers.size(); i++) {
+		Thread::wait_to_finish(thread_load_workers[i]);
+		memdelete(thread_load_workers[i]);
+	}
+	thread_load_workers.clear();
+
+	//requests that were never collected
+	const String *K = NULL;
+	while ((K = thread_load_tasks.next(K))) {
+		memdelete(thread_load_tasks[*K]);
+	}
+	thread_load_tasks.clear();
+	thread_load_queue.clear();
+
+	if (thread_load_semaphore) {
+		memdelete(thread_load_semaphore);
+		thread_load_semaphore = NULL;
+	}
+
+	memdelete(thread_load_mutex);
+	thread_load_mutex = NULL;
+	thread_load_started = false;
+	thread_load_exit = false;
+}
+
 ResourceLoadErrorNotify ResourceLoader::err_notify = NULL;
 void *ResourceLoader::err_notify_ud = NULL;
 
@@ -465,3 +1007,13 @@ void *ResourceLoader::dep_err_notify_ud = NULL;
 
 bool ResourceLoader::abort_on_missing_resource = true;
 bool ResourceLoader::timestamp_on_load = false;
+
+Mutex *ResourceLoader::thread_load_mutex = NULL;
+Semaphore *ResourceLoader::thread_load_semaphore = NULL;
+HashMap<String, ResourceLoader::ThreadLoadTask *> ResourceLoader::thread_load_tasks;
+List<String> ResourceLoader::thread_load_queue;
+Vector<Thread *> ResourceLoader::thread_load_workers;
+bool ResourceLoader::thread_load_started = false;
+bool ResourceLoader::thread_load_exit = false;
+ResourceLoadWaitNotify ResourceLoader::thread_load_wait_notify = NULL;
+ResourceLoader::ThreadLoadTask *ResourceLoader::thread_load_main_wait = NULL;
@@ -31,6 +31,10 @@
 #define RESOURCE_LOADER_H
 
 #include "export_data.h"
+#include "hash_map.h"
+#include "os/mutex.h"
+#include "os/semaphore.h"
+#include "os/thread.h"
 #include "resource.h"
 /**
 	@author Juan Linietsky <reduzio@gmail.com>
@@ -57,6 +61,7 @@ public:
 class ResourceFormatLoader {
 public:
 	virtual Ref<ResourceInteractiveLoader> load_interactive(const String &p_path, Error *r_error = NULL);
+	virtual bool can_load_interactive() const { return false; } //load_interactive() loads in stages, instead of wrapping load()
 	virtual RES load(const String &p_path, const String &p_original_path = "", Error *r_error = NULL);
 	virtual void get_recognized_extensions(List<String> *p_extensions) const = 0;
 	virtual void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const;
@@ -73,9 +78,18 @@ public:
 
 typedef void (*ResourceLoadErrorNotify)(void *p_ud, const String &p_text);
 typedef void (*DependencyErrorNotify)(void *p_ud, const String &p_loading, const String &p_which, const String &p_type);
+typedef void (*ResourceLoadWaitNotify)();
 
 class ResourceLoader {
+public:
+	enum ThreadLoadStatus {
+		THREAD_LOAD_INVALID_RESOURCE,
+		THREAD_LOAD_IN_PROGRESS,
+		THREAD_LOAD_FAILED,
+		THREAD_LOAD_LOADED
+	};
 
+private:
 	enum {
 		MAX_LOADERS = 64
 	};
@@ -91,10 +105,72 @@ class ResourceLoader {
 	static bool abort_on_missing_resource;
 
 	static String find_complete_path(const String &p_path, const String &p_type);
+	static void _finish_load(Resource *p_resource, const String &p_local_path, const String &p_remapped_path);
+
+	/* THREADED LOADING */
+
+	struct ThreadLoadTask {
+
+		String local_path;
+		String type_hint;
+		ThreadLoadStatus status;
+		Thread::ID loader_id; //thread that claimed the task, 0 while queued
+		bool polling; //the claiming thread is inside poll()
+		int requests; //load_threaded_request() calls and parent scenes holding on to the result
+		int users; //threads currently waiting on or running the task
+		int stage;
+		int stage_count;
+		Error error;
+		RES resource;
+		Ref<ResourceInteractiveLoader> interactive;
+		List<String> dependencies; //queued on behalf of this scene, released when it is done
+		int waiters; //threads blocked on semaphore until the task is done or unclaimed
+		Semaphore *semaphore;
+	};
+
+	static Mutex *thread_load_mutex;
+	static Semaphore *thread_load_semaphore;
+	static HashMap<String, ThreadLoadTask *> thread_load_tasks;
+	static List<String> thread_load_queue;
+	static Vector<Thread *> thread_load_workers;
+	static bool thread_load_started;
+	static bool thread_load_exit;
+	static ResourceLoadWaitNotify thread_load_wait_notify;
+	static ThreadLoadTask *thread_load_main_wait;
+
+	static String _get_local_path(const String &p_path);
+	static void _thread_load_start();
+	static ThreadLoadTask *_thread_load_get_task(const String &p_local_path, const String &p_type_hint, bool p_queue);
+	static void _thread_load_queue_dependencies(ThreadLoadTask *p_task);
+	static Error _thread_load_open(ThreadLoadTask *p_task, Ref<ResourceInteractiveLoader> &r_interactive, RES &r_resource);
+	static bool _thread_load_poll(ThreadLoadTask *p_task);
+	static void _thread_load_run(ThreadLoadTask *p_task);
+	static RES _thread_load_wait(ThreadLoadTask *p_task, bool p_release_request, Error *r_error);
+	static void _thread_load_release(ThreadLoadTask *p_task);
+	static void _thread_load_wake(ThreadLoadTask *p_task);
+	static void _thread_load_worker(void *p_ud);
 
 public:
 	static Ref<ResourceInteractiveLoader> load_interactive(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false, Error *r_error = NULL);
 	static RES load(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false, Error *r_error = NULL);
+
+	//background loading on a pool of worker threads. requests for the same path, and regular
+	//load() calls for a path that is already requested, share a single load. scene
+	//dependencies are loaded in parallel.
+	//visual server calls made by loaders are queued to the main thread by VisualServerWrapMT;
+	//with the unsafe render thread model no threads are started and loading advances on
+	//load_threaded_get_status() calls instead.
+	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "");
+	static ThreadLoadStatus load_threaded_get_status(const String &p_path, float *r_progress = NULL);
+	static RES load_threaded_get(const String &p_path, Error *r_error = NULL);
+
+	static void set_thread_load_wait_notify_func(ResourceLoadWaitNotify p_notify) { thread_load_wait_notify = p_notify; }
+	//wakes the main thread up if it is waiting on a load, so it calls the wait notify func again.
+	//to be called by loader threads that queue work for the main thread.
+	static void wake_thread_load_wait();
+
+	static void initialize();
+	static void finalize();
 	static Ref<ResourceImportMetadata> load_import_metadata(const String &p_path);
 
 	static void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions);
@@ -38,6 +38,8 @@
 #include "globals.h"
 #include "input_map.h"
 #include "io/config_file.h"
+#include "io/course_pack.h"
+#include "io/course_packer.h"
 #include "io/http_client.h"
 #include "io/packet_peer.h"
 #include "io/packet_peer_udp.h"
@@ -84,6 +86,8 @@ void register_core_types() {
 
 	StringName::setup();
 
+	ResourceLoader::initialize();
+
 	register_variant_methods();
 
 	CoreStringNames::create();
@@ -138,6 +142,8 @@ void register_core_types() {
 	ObjectTypeDB::register_type<ConfigFile>();
 
 	ObjectTypeDB::register_type<PCKPacker>();
+	ObjectTypeDB::register_type<CoursePacker>();
+	ObjectTypeDB::register_type<CoursePack>();
 
 	ObjectTypeDB::register_type<PackedDataContainer>();
 	ObjectTypeDB::register_virtual_type<PackedDataContainerRef>();
@@ -171,6 +177,8 @@ void register_core_singletons() {
 
 void unregister_core_types() {
 
+	ResourceLoader::finalize();
+
 	memdelete(_resource_loader);
 	memdelete(_resource_saver);
 	memdelete(_os);
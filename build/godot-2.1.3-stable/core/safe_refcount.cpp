@@ -51,4 +51,20 @@ long atomic_decrement(register long *pw) {
 	return InterlockedDecrement(pw);
 }
 
+uint32_t atomic_increment(volatile uint32_t *pw) {
+	return (uint32_t)InterlockedIncrement((volatile LONG *)pw);
+}
+
+uint32_t atomic_decrement(volatile uint32_t *pw) {
+	return (uint32_t)InterlockedDecrement((volatile LONG *)pw);
+}
+
+bool atomic_compare_and_swap(volatile uint32_t *pw, uint32_t p_old, uint32_t p_new) {
+	return (uint32_t)InterlockedCompareExchange((volatile LONG *)pw, (LONG)p_new, (LONG)p_old) == p_old;
+}
+
+void atomic_memory_barrier() {
+	MemoryBarrier();
+}
+
 #endif
@@ -31,6 +31,7 @@
 #define SAFE_REFCOUNT_H
 
 #include "os/mutex.h"
+#include "typedefs.h"
 /* x86/x86_64 GCC */
 
 #include "platform_config.h"
@@ -341,4 +342,65 @@ public:
 
 #endif // no thread safe
 
+/* Plain word atomics, for structures read without a lock (ie, the StringName table).
+   Increment and decrement return the new value, all of them act as full barriers. */
+
+#ifdef NO_THREADS
+
+static inline uint32_t atomic_increment(volatile uint32_t *pw) {
+
+	return ++(*pw);
+}
+
+static inline uint32_t atomic_decrement(volatile uint32_t *pw) {
+
+	return --(*pw);
+}
+
+static inline bool atomic_compare_and_swap(volatile uint32_t *pw, uint32_t p_old, uint32_t p_new) {
+
+	if (*pw != p_old)
+		return false;
+	*pw = p_new;
+	return true;
+}
+
+static inline void atomic_memory_barrier() {
+}
+
+#elif defined(__GNUC__)
+
+static inline uint32_t atomic_increment(volatile uint32_t *pw) {
+
+	return __sync_add_and_fetch(pw, 1);
+}
+
+static inline uint32_t atomic_decrement(volatile uint32_t *pw) {
+
+	return __sync_sub_and_fetch(pw, 1);
+}
+
+static inline bool atomic_compare_and_swap(volatile uint32_t *pw, uint32_t p_old, uint32_t p_new) {
+
+	return __sync_bool_compare_and_swap(pw, p_old, p_new);
+}
+
+static inline void atomic_memory_barrier() {
+
+	__sync_synchronize();
+}
+
+#elif defined(_MSC_VER)
+
+uint32_t atomic_increment(volatile uint32_t *pw);
+uint32_t atomic_decrement(volatile uint32_t *pw);
+bool atomic_compare_and_swap(volatile uint32_t *pw, uint32_t p_old, uint32_t p_new);
+void atomic_memory_barrier();
+
+#else
+
+#error This platform has no word atomics, compile with NO_THREADS or implement them.
+
+#endif
+
 #endif
@@ -29,29 +29,77 @@
 /*************************************************************************/
 #include "string_db.h"
 #include "os/os.h"
+#include "os/thread.h"
 #include "print_string.h"
+
+#include <string.h>
+
 StaticCString StaticCString::create(const char *p_ptr) {
 	StaticCString scs;
 	scs.ptr = p_ptr;
 	return scs;
 }
 
-StringName::_Data *StringName::_table[STRING_TABLE_LEN];
+StringName::_Table *volatile StringName::_table = NULL;
+volatile uint32_t StringName::_table_version = 0;
+volatile uint32_t StringName::_epoch = 1;
+StringName::_ReaderSlot StringName::_reader_slots[StringName::READER_SLOTS];
+uint32_t StringName::_count = 0;
+StringName::_Data *StringName::_retired = NULL;
+StringName::_Table *StringName::_retired_tables = NULL;
+
+bool StringName::_stats_enabled = false;
+volatile uint32_t StringName::_stat_lookups = 0;
+volatile uint32_t StringName::_stat_locked_lookups = 0;
+uint32_t StringName::_stat_resizes = 0;
+uint64_t StringName::_stat_from_usec = 0;
 
 StringName _scs_create(const char *p_chr) {
 
 	return (p_chr[0] ? StringName(StaticCString::create(p_chr)) : StringName());
 }
 
+bool StringName::_Data::is_name(const char *p_name) const {
+
+	return cname ? strcmp(cname, p_name) == 0 : name == p_name;
+}
+
+bool StringName::_Data::is_name(const CharType *p_name) const {
+
+	return cname ? String(cname) == p_name : name == p_name;
+}
+
+bool StringName::_Data::is_name(const String &p_name) const {
+
+	return cname ? p_name == cname : name == p_name;
+}
+
 bool StringName::configured = false;
 
+StringName::_Table *StringName::_alloc_table(uint32_t p_len) {
+
+	_Table *table = memnew(_Table);
+	table->mask = p_len - 1;
+	table->buckets = (_Data * volatile *)memalloc(sizeof(_Data *) * p_len);
+	for (uint32_t i = 0; i < p_len; i++) {
+		table->buckets[i] = NULL;
+	}
+	table->retired_epoch = 0;
+	table->retired_next = NULL;
+	return table;
+}
+
+void StringName::_free_table(_Table *p_table) {
+
+	memfree((void *)p_table->buckets);
+	memdelete(p_table);
+}
+
 void StringName::setup() {
 
 	ERR_FAIL_COND(configured);
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-
-		_table[i] = NULL;
-	}
+	_table = _alloc_table(1 << STRING_TABLE_BITS);
+	_count = 0;
 	configured = true;
 }
 
@@ -59,11 +107,12 @@ void StringName::cleanup() {
 
 	_global_lock();
 	int lost_strings = 0;
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
+	_Table *table = _table;
+	for (uint32_t i = 0; i <= table->mask; i++) {
 
-		while (_table[i]) {
+		while (table->buckets[i]) {
 
-			_Data *d = _table[i];
+			_Data *d = table->buckets[i];
 			lost_strings++;
 			if (OS::get_singleton()->is_stdout_verbose()) {
 
@@ -74,16 +123,261 @@ void StringName::cleanup() {
 				}
 			}
 
-			_table[i] = _table[i]->next;
+			table->buckets[i] = d->next;
 			memdelete(d);
 		}
 	}
 	if (OS::get_singleton()->is_stdout_verbose() && lost_strings) {
 		print_line("StringName: " + itos(lost_strings) + " unclaimed string names at exit.");
 	}
+
+	_collect(true);
+	_free_table(table);
+	_table = NULL;
+	_count = 0;
+	_global_unlock();
+}
+
+// claims a reader slot for a lock-free lookup, starting from one picked by the
+// thread, so the same thread keeps writing to the same cache line.
+// NULL if all are taken, the lookup then takes the lock.
+StringName::_ReaderSlot *StringName::_reader_enter() {
+
+	uint64_t id = Thread::get_caller_ID();
+	uint32_t from = uint32_t((id * 0x9E3779B97F4A7C15ULL) >> 58);
+
+	for (int i = 0; i < READER_SLOTS; i++) {
+
+		_ReaderSlot *slot = &_reader_slots[(from + i) & (READER_SLOTS - 1)];
+		// a full barrier, lookups can't read the table before the slot is seen
+		if (slot->epoch == 0 && atomic_compare_and_swap(&slot->epoch, 0, _epoch))
+			return slot;
+	}
+
+	return NULL;
+}
+
+void StringName::_reader_exit(_ReaderSlot *p_slot) {
+
+	atomic_memory_barrier();
+	p_slot->epoch = 0;
+}
+
+// called with the lock held, after unlinking something and tagging it with the current epoch.
+void StringName::_advance_epoch() {
+
+	// lookups entering from now on can't reach what was unlinked, 0 means a free slot
+	if (atomic_increment(&_epoch) == 0)
+		atomic_increment(&_epoch);
+}
+
+// frees what was retired before every lookup in flight started, everything
+// with p_all (at exit). called with the lock held.
+void StringName::_collect(bool p_all) {
+
+	if (!_retired && !_retired_tables)
+		return;
+
+	atomic_memory_barrier();
+
+	bool readers = false;
+	uint32_t oldest = 0;
+
+	if (!p_all) {
+
+		for (int i = 0; i < READER_SLOTS; i++) {
+
+			uint32_t epoch = _reader_slots[i].epoch;
+			if (epoch == 0)
+				continue;
+			if (!readers || int32_t(epoch - oldest) < 0)
+				oldest = epoch;
+			readers = true;
+		}
+	}
+
+	// both lists go from the newest to the oldest, cut them at the first freeable entry
+	_Data **dlink = &_retired;
+	if (readers) {
+		while (*dlink && int32_t((*dlink)->retired_epoch - oldest) >= 0)
+			dlink = &(*dlink)->prev;
+	}
+
+	while (*dlink) {
+		_Data *d = *dlink;
+		*dlink = d->prev;
+		memdelete(d);
+	}
+
+	_Table **tlink = &_retired_tables;
+	if (readers) {
+		while (*tlink && int32_t((*tlink)->retired_epoch - oldest) >= 0)
+			tlink = &(*tlink)->retired_next;
+	}
+
+	while (*tlink) {
+		_Table *t = *tlink;
+		*tlink = t->retired_next;
+		_free_table(t);
+	}
+}
+
+// doubles the bucket count, called with the lock held.
+void StringName::_grow() {
+
+	_Table *old_table = _table;
+	_Table *table = _alloc_table((old_table->mask + 1) << 1);
+
+	// lookups running meanwhile may be carried over to the new chains and
+	// miss, an odd version tells them to retry with the lock
+	atomic_increment(&_table_version);
+
+	for (uint32_t i = 0; i <= old_table->mask; i++) {
+
+		_Data *d = old_table->buckets[i];
+		while (d) {
+
+			_Data *next = d->next;
+			uint32_t idx = d->hash & table->mask;
+			d->prev = NULL;
+			d->next = table->buckets[idx];
+			if (table->buckets[idx])
+				table->buckets[idx]->prev = d;
+			table->buckets[idx] = d;
+			d = next;
+		}
+	}
+
+	atomic_memory_barrier();
+	_table = table;
+	atomic_increment(&_table_version);
+
+	old_table->retired_epoch = _epoch;
+	old_table->retired_next = _retired_tables;
+	_retired_tables = old_table;
+	_advance_epoch();
+	_stat_resizes++;
+	_collect();
+}
+
+template <class T>
+StringName::_Data *StringName::_find(const T &p_name, uint32_t p_hash, bool &r_sure) {
+
+	if (_stats_enabled)
+		atomic_increment(&_stat_lookups);
+
+	_Data *found = NULL;
+	r_sure = false;
+
+	_ReaderSlot *slot = _reader_enter();
+	if (!slot)
+		return NULL;
+
+	uint32_t version = _table_version;
+
+	if (!(version & 1)) {
+
+		_Table *table = _table;
+		_Data *d = table->buckets[p_hash & table->mask];
+
+		while (d) {
+
+			// compare hash first, a node whose refcount already dropped to zero
+			// is being removed, a live copy of the name may follow it
+			if (d->hash == p_hash && d->is_name(p_name) && d->refcount.ref()) {
+				found = d;
+				break;
+			}
+			d = d->next;
+		}
+
+		atomic_memory_barrier();
+		r_sure = found || _table_version == version;
+	}
+
+	_reader_exit(slot);
+	return found;
+}
+
+template <class T>
+StringName::_Data *StringName::_find_locked(const T &p_name, uint32_t p_hash) {
+
+	if (_stats_enabled)
+		atomic_increment(&_stat_locked_lookups);
+
+	_Data *d = _table->buckets[p_hash & _table->mask];
+
+	while (d) {
+
+		if (d->hash == p_hash && d->is_name(p_name) && d->refcount.ref())
+			return d;
+		d = d->next;
+	}
+
+	return NULL;
+}
+
+template <class T>
+void StringName::_intern(const T &p_name, uint32_t p_hash, const char *p_cname) {
+
+	bool sure;
+	_data = _find(p_name, p_hash, sure);
+	if (_data)
+		return;
+
+	_global_lock();
+
+	// it may have been added since
+	_data = _find_locked(p_name, p_hash);
+	if (_data) {
+		_global_unlock();
+		return;
+	}
+
+	_data = memnew(_Data);
+	if (p_cname)
+		_data->cname = p_cname;
+	else
+		_data->name = p_name;
+	_data->refcount.init();
+	_data->hash = p_hash;
+
+	_Table *table = _table;
+	uint32_t idx = p_hash & table->mask;
+	_data->prev = NULL;
+	_data->next = table->buckets[idx];
+
+	// the node must be complete before lookups can reach it
+	atomic_memory_barrier();
+	if (table->buckets[idx])
+		table->buckets[idx]->prev = _data;
+	table->buckets[idx] = _data;
+
+	_count++;
+	if (_count > (table->mask + 1) * STRING_TABLE_MAX_LOAD)
+		_grow();
+
 	_global_unlock();
 }
 
+template <class T>
+StringName StringName::_search(const T &p_name, uint32_t p_hash) {
+
+	bool sure;
+	_Data *d = _find(p_name, p_hash, sure);
+
+	if (!d && !sure) {
+		_global_lock();
+		d = _find_locked(p_name, p_hash);
+		_global_unlock();
+	}
+
+	if (d)
+		return StringName(d);
+
+	return StringName(); //does not exist
+}
+
 void StringName::unref() {
 
 	ERR_FAIL_COND(!configured);
@@ -95,16 +389,25 @@ void StringName::unref() {
 		if (_data->prev) {
 			_data->prev->next = _data->next;
 		} else {
-			if (_table[_data->idx] != _data) {
+			uint32_t idx = _data->hash & _table->mask;
+			if (_table->buckets[idx] != _data) {
 				ERR_PRINT("BUG!");
 			}
-			_table[_data->idx] = _data->next;
+			_table->buckets[idx] = _data->next;
 		}
 
 		if (_data->next) {
 			_data->next->prev = _data->prev;
 		}
-		memdelete(_data);
+
+		// lookups may still be standing on it, so keep next intact until collected
+		_data->retired_epoch = _epoch;
+		_data->prev = _retired;
+		_retired = _data;
+		_advance_epoch();
+		_count--;
+		_collect();
+
 		_global_unlock();
 	}
 
@@ -182,44 +485,7 @@ StringName::StringName(const char *p_name) {
 
 	ERR_FAIL_COND(!p_name || !p_name[0]);
 
-	_global_lock();
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
-	}
-
-	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			_global_unlock();
-			return;
-		} else {
-		}
-	}
-
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = NULL;
-	_data->next = _table[idx];
-	_data->prev = NULL;
-	if (_table[idx])
-		_table[idx]->prev = _data;
-	_table[idx] = _data;
-
-	_global_unlock();
+	_intern(p_name, String::hash(p_name), NULL);
 }
 
 StringName::StringName(const StaticCString &p_static_string) {
@@ -230,44 +496,7 @@ StringName::StringName(const StaticCString &p_static_string) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	_global_lock();
-
-	uint32_t hash = String::hash(p_static_string.ptr);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_static_string.ptr)
-			break;
-		_data = _data->next;
-	}
-
-	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			_global_unlock();
-			return;
-		} else {
-		}
-	}
-
-	_data = memnew(_Data);
-
-	_data->refcount.init();
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = NULL;
-	if (_table[idx])
-		_table[idx]->prev = _data;
-	_table[idx] = _data;
-
-	_global_unlock();
+	_intern(p_static_string.ptr, String::hash(p_static_string.ptr), p_static_string.ptr);
 }
 
 StringName::StringName(const String &p_name) {
@@ -279,43 +508,19 @@ StringName::StringName(const String &p_name) {
 	if (p_name.empty())
 		return;
 
-	_global_lock();
-
-	uint32_t hash = p_name.hash();
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
+	_intern(p_name, p_name.hash(), NULL);
+}
 
-	while (_data) {
+StringName::StringName(const String &p_name, uint32_t p_hash) {
 
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
-	}
+	_data = NULL;
 
-	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			_global_unlock();
-			return;
-		} else {
-		}
-	}
+	ERR_FAIL_COND(!configured);
 
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = NULL;
-	_data->next = _table[idx];
-	_data->prev = NULL;
-	if (_table[idx])
-		_table[idx]->prev = _data;
-	_table[idx] = _data;
+	if (p_name.empty())
+		return;
 
-	_global_unlock();
+	_intern(p_name, p_hash, NULL);
 }
 
 StringName StringName::search(const char *p_name) {
@@ -326,29 +531,7 @@ StringName StringName::search(const char *p_name) {
 	if (!p_name[0])
 		return StringName();
 
-	_global_lock();
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		_global_unlock();
-		return StringName(_data);
-	}
-
-	_global_unlock();
-	return StringName(); //does not exist
+	return _search(p_name, String::hash(p_name));
 }
 
 StringName StringName::search(const CharType *p_name) {
@@ -359,65 +542,73 @@ StringName StringName::search(const CharType *p_name) {
 	if (!p_name[0])
 		return StringName();
 
-	_global_lock();
-
-	uint32_t hash = String::hash(p_name);
+	return _search(p_name, String::hash(p_name));
+}
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+StringName StringName::search(const String &p_name) {
 
-	_Data *_data = _table[idx];
+	ERR_FAIL_COND_V(p_name == "", StringName());
 
-	while (_data) {
+	return _search(p_name, p_name.hash());
+}
 
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
-	}
+StringName StringName::search(const String &p_name, uint32_t p_hash) {
 
-	if (_data && _data->refcount.ref()) {
-		_global_unlock();
-		return StringName(_data);
-	}
+	ERR_FAIL_COND_V(p_name == "", StringName());
 
-	_global_unlock();
-	return StringName(); //does not exist
+	return _search(p_name, p_hash);
 }
-StringName StringName::search(const String &p_name) {
 
-	ERR_FAIL_COND_V(p_name == "", StringName());
+StringName::StringName() {
 
-	_global_lock();
+	_data = NULL;
+}
 
-	uint32_t hash = p_name.hash();
+StringName::~StringName() {
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	unref();
+}
 
-	_Data *_data = _table[idx];
+void StringName::set_stats_enabled(bool p_enabled) {
 
-	while (_data) {
+	_stat_lookups = 0;
+	_stat_locked_lookups = 0;
+	_stat_from_usec = OS::get_singleton()->get_ticks_usec();
+	_stats_enabled = p_enabled;
+}
 
-		// compare hash first
-		if (_data->hash == hash && p_name == _data->get_name())
-			break;
-		_data = _data->next;
-	}
+void StringName::get_stats(Stats *r_stats) {
 
-	if (_data && _data->refcount.ref()) {
-		_global_unlock();
-		return StringName(_data);
-	}
+	ERR_FAIL_COND(!configured);
 
-	_global_unlock();
-	return StringName(); //does not exist
-}
+	_global_lock();
 
-StringName::StringName() {
+	_Table *table = _table;
+	int longest = 0;
+	for (uint32_t i = 0; i <= table->mask; i++) {
 
-	_data = NULL;
-}
+		int len = 0;
+		for (_Data *d = table->buckets[i]; d; d = d->next)
+			len++;
+		if (len > longest)
+			longest = len;
+	}
 
-StringName::~StringName() {
+	r_stats->names = _count;
+	r_stats->buckets = table->mask + 1;
+	r_stats->load_factor = float(_count) / float(table->mask + 1);
+	r_stats->longest_chain = longest;
+	r_stats->resizes = _stat_resizes;
+	r_stats->retired = 0;
+	for (_Data *d = _retired; d; d = d->prev)
+		r_stats->retired++;
+	for (_Table *t = _retired_tables; t; t = t->retired_next)
+		r_stats->retired++;
 
-	unref();
+	_global_unlock();
+
+	r_stats->lookups = _stat_lookups;
+	r_stats->locked_lookups = _stat_locked_lookups;
+	uint64_t usec = OS::get_singleton()->get_ticks_usec() - _stat_from_usec;
+	r_stats->lookups_per_second = usec ? double(r_stats->lookups) * 1000000.0 / double(usec) : 0.0;
 }
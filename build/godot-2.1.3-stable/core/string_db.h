@@ -48,9 +48,9 @@ class StringName {
 
 	enum {
 
-		STRING_TABLE_BITS = 12,
-		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_BITS = 12, // initial size, grows as names are added
+		STRING_TABLE_MAX_LOAD = 2, // names per bucket before the table doubles
+		READER_SLOTS = 64 // lookups running at once without the lock
 	};
 
 	struct _Data {
@@ -59,18 +59,51 @@ class StringName {
 		String name;
 
 		String get_name() const { return cname ? String(cname) : name; }
-		int idx;
+		bool is_name(const char *p_name) const;
+		bool is_name(const CharType *p_name) const;
+		bool is_name(const String &p_name) const;
 		uint32_t hash;
-		_Data *prev;
-		_Data *next;
+		uint32_t retired_epoch;
+		_Data *prev; // also links the retired list once unlinked
+		_Data *volatile next;
 		_Data() {
 			cname = NULL;
 			next = prev = NULL;
 			hash = 0;
+			retired_epoch = 0;
 		}
 	};
 
-	static _Data *_table[STRING_TABLE_LEN];
+	// Lookups walk the chains without locking, only insertion, removal and
+	// resize take the lock. Unlinked nodes and old bucket arrays are retired
+	// with the current epoch, which then advances. Each lookup holds a reader
+	// slot with the epoch it started in, what was retired before the oldest
+	// of those is freed.
+	struct _Table {
+		uint32_t mask;
+		_Data *volatile *buckets;
+		uint32_t retired_epoch;
+		_Table *retired_next;
+	};
+
+	struct _ReaderSlot {
+		volatile uint32_t epoch; // 0 while free
+		uint8_t pad[60]; // a cache line each, so lookups from different threads don't share one
+	};
+
+	static _Table *volatile _table;
+	static volatile uint32_t _table_version; // odd while a resize relinks the chains
+	static volatile uint32_t _epoch;
+	static _ReaderSlot _reader_slots[READER_SLOTS];
+	static uint32_t _count;
+	static _Data *_retired;
+	static _Table *_retired_tables;
+
+	static bool _stats_enabled;
+	static volatile uint32_t _stat_lookups;
+	static volatile uint32_t _stat_locked_lookups;
+	static uint32_t _stat_resizes;
+	static uint64_t _stat_from_usec;
 
 	_Data *_data;
 
@@ -80,6 +113,23 @@ class StringName {
 		uint32_t hash;
 	};
 
+	template <class T>
+	static _Data *_find(const T &p_name, uint32_t p_hash, bool &r_sure);
+	template <class T>
+	static _Data *_find_locked(const T &p_name, uint32_t p_hash);
+	template <class T>
+	void _intern(const T &p_name, uint32_t p_hash, const char *p_cname);
+	template <class T>
+	static StringName _search(const T &p_name, uint32_t p_hash);
+
+	static _Table *_alloc_table(uint32_t p_len);
+	static void _free_table(_Table *p_table);
+	static _ReaderSlot *_reader_enter();
+	static void _reader_exit(_ReaderSlot *p_slot);
+	static void _advance_epoch();
+	static void _grow();
+	static void _collect(bool p_all = false);
+
 	void unref();
 	friend void register_core_types();
 	friend void unregister_core_types();
@@ -129,6 +179,7 @@ public:
 	static StringName search(const char *p_name);
 	static StringName search(const CharType *p_name);
 	static StringName search(const String &p_name);
+	static StringName search(const String &p_name, uint32_t p_hash); // p_hash must be p_name.hash()
 
 	struct AlphCompare {
 
@@ -142,9 +193,26 @@ public:
 	StringName(const char *p_name);
 	StringName(const StringName &p_name);
 	StringName(const String &p_name);
+	StringName(const String &p_name, uint32_t p_hash); // p_hash must be p_name.hash()
 	StringName(const StaticCString &p_static_string);
 	StringName();
 	~StringName();
+
+	struct Stats {
+
+		int names;
+		int buckets;
+		float load_factor;
+		int longest_chain;
+		int resizes;
+		int retired; // unlinked names and bucket arrays not freed yet
+		uint32_t lookups; // counted only while stats are enabled
+		uint32_t locked_lookups; // lookups that missed and fell back to the lock
+		double lookups_per_second;
+	};
+
+	static void set_stats_enabled(bool p_enabled); // also resets the counters
+	static void get_stats(Stats *r_stats);
 };
 
 struct StringNameHasher {
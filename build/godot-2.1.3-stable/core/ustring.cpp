@@ -85,14 +85,11 @@ void String::copy_from(const char *p_cstr) {
 
 void String::copy_from(const CharType *p_cstr, int p_clip_to) {
 
+	//don't scan past the clip, callers pass ranges inside much longer buffers
 	int len = 0;
-	const CharType *ptr = p_cstr;
-	while (*(ptr++) != 0)
+	while (len != p_clip_to && p_cstr[len] != 0)
 		len++;
 
-	if (p_clip_to >= 0 && len > p_clip_to)
-		len = p_clip_to;
-
 	if (len == 0) {
 
 		resize(0);
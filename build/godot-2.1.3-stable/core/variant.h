@@ -153,6 +153,28 @@ private:
 	void reference(const Variant &p_variant);
 	void clear();
 
+	_FORCE_INLINE_ void _set_bool(bool p_bool) {
+		if (type != BOOL) {
+			clear();
+			type = BOOL;
+		}
+		_data._bool = p_bool;
+	}
+	_FORCE_INLINE_ void _set_int(int p_int) {
+		if (type != INT) {
+			clear();
+			type = INT;
+		}
+		_data._int = p_int;
+	}
+	_FORCE_INLINE_ void _set_real(double p_real) {
+		if (type != REAL) {
+			clear();
+			type = REAL;
+		}
+		_data._real = p_real;
+	}
+
 public:
 	_FORCE_INLINE_ Type get_type() const { return type; }
 	static String get_type_name(Variant::Type p_type);
@@ -344,6 +366,42 @@ public:
 
 	static String get_operator_name(Operator p_op);
 	static void evaluate(const Operator &p_op, const Variant &p_a, const Variant &p_b, Variant &r_ret, bool &r_valid);
+
+#define _VARIANT_NUMERIC_OPS(m_set)                                 \
+	switch (p_op) {                                                 \
+		case OP_ADD: r_ret.m_set(a + b); return true;               \
+		case OP_SUBSTRACT: r_ret.m_set(a - b); return true;         \
+		case OP_MULTIPLY: r_ret.m_set(a * b); return true;          \
+		case OP_EQUAL: r_ret._set_bool(a == b); return true;        \
+		case OP_NOT_EQUAL: r_ret._set_bool(a != b); return true;    \
+		case OP_LESS: r_ret._set_bool(a < b); return true;          \
+		case OP_LESS_EQUAL: r_ret._set_bool(a <= b); return true;   \
+		case OP_GREATER: r_ret._set_bool(a > b); return true;       \
+		case OP_GREATER_EQUAL: r_ret._set_bool(a >= b); return true; \
+		default: return false;                                      \
+	}
+
+	// inline fast path for evaluate() with two ints or two reals, returns false if the generic evaluate() is needed.
+	// r_ret may alias an operand.
+	static _FORCE_INLINE_ bool evaluate_numeric(const Operator &p_op, const Variant &p_a, const Variant &p_b, Variant &r_ret) {
+
+		if (p_a.type != p_b.type)
+			return false;
+
+		if (p_a.type == INT) {
+			int a = p_a._data._int;
+			int b = p_b._data._int;
+			_VARIANT_NUMERIC_OPS(_set_int);
+		} else if (p_a.type == REAL) {
+			double a = p_a._data._real;
+			double b = p_b._data._real;
+			_VARIANT_NUMERIC_OPS(_set_real);
+		}
+
+		return false;
+	}
+
+#undef _VARIANT_NUMERIC_OPS
 	static _FORCE_INLINE_ Variant evaluate(const Operator &p_op, const Variant &p_a, const Variant &p_b) {
 
 		bool valid = true;
@@ -371,6 +429,15 @@ public:
 	};
 
 	void call_ptr(const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, CallError &r_error);
+
+	// resolved built-in method, stays valid until variant methods are unregistered (lets scripts cache lookups)
+	struct BuiltInMethod {
+		Type base_type;
+	};
+
+	static const BuiltInMethod *get_builtin_method(Type p_type, const StringName &p_method);
+	void call_builtin(const BuiltInMethod *p_method, const Variant **p_args, int p_argcount, Variant *r_ret, CallError &r_error);
+
 	Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, CallError &r_error);
 	Variant call(const StringName &p_method, const Variant &p_arg1 = Variant(), const Variant &p_arg2 = Variant(), const Variant &p_arg3 = Variant(), const Variant &p_arg4 = Variant(), const Variant &p_arg5 = Variant());
 
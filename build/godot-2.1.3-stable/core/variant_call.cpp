@@ -46,7 +46,7 @@ struct _VariantCall {
 		r_ret = reinterpret_cast<Vector3 *>(p_self._data._mem)->dot(*reinterpret_cast<const Vector3 *>(p_args[0]->_data._mem));
 	}
 
-	struct FuncData {
+	struct FuncData : public Variant::BuiltInMethod {
 
 		int arg_count;
 		Vector<Variant> default_args;
@@ -59,12 +59,12 @@ struct _VariantCall {
 #endif
 		VariantFunc func;
 
-		_FORCE_INLINE_ bool verify_arguments(const Variant **p_args, Variant::CallError &r_error) {
+		_FORCE_INLINE_ bool verify_arguments(const Variant **p_args, Variant::CallError &r_error) const {
 
 			if (arg_count == 0)
 				return true;
 
-			Variant::Type *tptr = &arg_types[0];
+			const Variant::Type *tptr = arg_types.ptr();
 
 			for (int i = 0; i < arg_count; i++) {
 
@@ -80,7 +80,7 @@ struct _VariantCall {
 			return true;
 		}
 
-		_FORCE_INLINE_ void call(Variant &r_ret, Variant &p_self, const Variant **p_args, int p_argcount, Variant::CallError &r_error) {
+		_FORCE_INLINE_ void call(Variant &r_ret, Variant &p_self, const Variant **p_args, int p_argcount, Variant::CallError &r_error) const {
 #ifdef DEBUG_ENABLED
 			if (p_argcount > arg_count) {
 				r_error.error = Variant::CallError::CALL_ERROR_TOO_MANY_ARGUMENTS;
@@ -123,6 +123,50 @@ struct _VariantCall {
 	struct TypeFunc {
 
 		Map<StringName, FuncData> functions;
+
+		// Open addressed index over functions, keyed by the StringName hash.
+		// Built once after registration, the Map stays the owner and keeps
+		// the ordered list for get_method_list().
+		struct Slot {
+			StringName name;
+			FuncData *func;
+			Slot() { func = NULL; }
+		};
+
+		Vector<Slot> slots;
+		uint32_t slot_mask;
+
+		void build_index() {
+
+			slots.clear();
+			uint32_t size = nearest_power_of_2(MAX(functions.size() * 2, 2)); // load factor <= 0.5
+			slots.resize(size);
+			slot_mask = size - 1;
+
+			Slot *w = slots.ptr();
+			for (Map<StringName, FuncData>::Element *E = functions.front(); E; E = E->next()) {
+
+				uint32_t idx = E->key().hash() & slot_mask;
+				while (w[idx].func)
+					idx = (idx + 1) & slot_mask;
+				w[idx].name = E->key();
+				w[idx].func = &E->get();
+			}
+		}
+
+		_FORCE_INLINE_ const FuncData *lookup(const StringName &p_name) const {
+
+			const Slot *r = slots.ptr();
+			uint32_t idx = p_name.hash() & slot_mask;
+			while (r[idx].func) {
+				if (r[idx].name == p_name)
+					return r[idx].func;
+				idx = (idx + 1) & slot_mask;
+			}
+			return NULL;
+		}
+
+		TypeFunc() { slot_mask = 0; }
 	};
 
 	static TypeFunc *type_funcs;
@@ -141,6 +185,7 @@ struct _VariantCall {
 	static void addfunc(Variant::Type p_type, Variant::Type p_return, const StringName &p_name, VariantFunc p_func, const Vector<Variant> &p_defaultarg, const Arg &p_argtype1 = Arg(), const Arg &p_argtype2 = Arg(), const Arg &p_argtype3 = Arg(), const Arg &p_argtype4 = Arg(), const Arg &p_argtype5 = Arg()) {
 
 		FuncData funcdata;
+		funcdata.base_type = p_type;
 		funcdata.func = p_func;
 		funcdata.default_args = p_defaultarg;
 #ifdef DEBUG_ENABLED
@@ -444,6 +489,7 @@ struct _VariantCall {
 	VCALL_LOCALMEM0R(Dictionary, keys);
 	VCALL_LOCALMEM0R(Dictionary, values);
 	VCALL_LOCALMEM1R(Dictionary, parse_json);
+	VCALL_LOCALMEM1R(Dictionary, parse_json_file);
 	VCALL_LOCALMEM0R(Dictionary, to_json);
 
 	VCALL_LOCALMEM2(Array, set);
@@ -987,21 +1033,39 @@ void Variant::call_ptr(const StringName &p_method, const Variant **p_args, int p
 
 		r_error.error = Variant::CallError::CALL_OK;
 
-		Map<StringName, _VariantCall::FuncData>::Element *E = _VariantCall::type_funcs[type].functions.find(p_method);
-#ifdef DEBUG_ENABLED
-		if (!E) {
+		const _VariantCall::FuncData *funcdata = _VariantCall::type_funcs[type].lookup(p_method);
+		if (!funcdata) {
 			r_error.error = Variant::CallError::CALL_ERROR_INVALID_METHOD;
 			return;
 		}
-#endif
-		_VariantCall::FuncData &funcdata = E->get();
-		funcdata.call(ret, *this, p_args, p_argcount, r_error);
+		funcdata->call(ret, *this, p_args, p_argcount, r_error);
 	}
 
 	if (r_error.error == Variant::CallError::CALL_OK && r_ret)
 		*r_ret = ret;
 }
 
+const Variant::BuiltInMethod *Variant::get_builtin_method(Variant::Type p_type, const StringName &p_method) {
+
+	ERR_FAIL_INDEX_V(p_type, VARIANT_MAX, NULL);
+	if (p_type == OBJECT)
+		return NULL; // objects dispatch through their own method binds
+
+	return _VariantCall::type_funcs[p_type].lookup(p_method);
+}
+
+void Variant::call_builtin(const BuiltInMethod *p_method, const Variant **p_args, int p_argcount, Variant *r_ret, CallError &r_error) {
+
+	ERR_FAIL_COND(!p_method || p_method->base_type != type);
+
+	Variant ret;
+	r_error.error = Variant::CallError::CALL_OK;
+	static_cast<const _VariantCall::FuncData *>(p_method)->call(ret, *this, p_args, p_argcount, r_error);
+
+	if (r_error.error == Variant::CallError::CALL_OK && r_ret)
+		*r_ret = ret;
+}
+
 #define VCALL(m_type, m_method) _VariantCall::_call_##m_type##_##m_method
 
 Variant Variant::construct(const Variant::Type p_type, const Variant **p_args, int p_argcount, CallError &r_error, bool p_strict) {
@@ -1168,7 +1232,7 @@ bool Variant::has_method(const StringName &p_method) const {
 	}
 
 	const _VariantCall::TypeFunc &fd = _VariantCall::type_funcs[type];
-	return fd.functions.has(p_method);
+	return fd.lookup(p_method) != NULL;
 }
 
 void Variant::get_method_list(List<MethodInfo> *p_list) const {
@@ -1491,6 +1555,7 @@ void register_variant_methods() {
 	ADDFUNC0(DICTIONARY, ARRAY, Dictionary, values, varray());
 
 	ADDFUNC1(DICTIONARY, INT, Dictionary, parse_json, STRING, "json", varray());
+	ADDFUNC1(DICTIONARY, INT, Dictionary, parse_json_file, STRING, "path", varray());
 	ADDFUNC0(DICTIONARY, STRING, Dictionary, to_json, varray());
 
 	ADDFUNC0(ARRAY, INT, Array, size, varray());
@@ -1746,6 +1811,10 @@ void register_variant_methods() {
 	_VariantCall::add_constant(Variant::IMAGE, "INTERPOLATE_NEAREST", Image::INTERPOLATE_NEAREST);
 	_VariantCall::add_constant(Variant::IMAGE, "INTERPOLATE_BILINEAR", Image::INTERPOLATE_BILINEAR);
 	_VariantCall::add_constant(Variant::IMAGE, "INTERPOLATE_CUBIC", Image::INTERPOLATE_CUBIC);
+
+	for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+		_VariantCall::type_funcs[i].build_index();
+	}
 }
 
 void unregister_variant_methods() {
@@ -1057,6 +1057,48 @@ void RasterizerGLES2::texture_set_data(RID p_texture, const Image &p_image, VS::
 	//texture_set_flags(p_texture,texture->flags);
 }
 
+void RasterizerGLES2::texture_set_data_partial(RID p_texture, const Image &p_image, int p_dst_x, int p_dst_y, VS::CubeMapSide p_cube_side) {
+
+	Texture *texture = texture_owner.get(p_texture);
+
+	ERR_FAIL_COND(!texture);
+	ERR_FAIL_COND(!texture->active);
+	ERR_FAIL_COND(texture->render_target);
+	ERR_FAIL_COND(texture->format != p_image.get_format());
+	ERR_FAIL_COND(p_image.empty());
+	ERR_FAIL_COND(texture->data_size == 0); // texture_set_data() must have been called before
+	ERR_FAIL_COND(texture->compressed);
+	ERR_FAIL_COND(texture->alloc_width != texture->width || texture->alloc_height != texture->height); // was resized on upload
+	ERR_FAIL_COND(p_dst_x < 0 || p_dst_y < 0 || p_dst_x + p_image.get_width() > texture->width || p_dst_y + p_image.get_height() > texture->height);
+
+	if (keep_copies && !(texture->flags & VS::TEXTURE_FLAG_VIDEO_SURFACE) && !(use_reload_hooks && texture->reloader)) {
+		texture->image[p_cube_side].blit_rect(p_image, Rect2(0, 0, p_image.get_width(), p_image.get_height()), Point2(p_dst_x, p_dst_y));
+	}
+
+	int components;
+	GLenum format;
+	GLenum internal_format;
+	bool alpha;
+	bool compressed;
+
+	Image img = _get_gl_image_and_format(p_image, p_image.get_format(), texture->flags, format, internal_format, components, alpha, compressed);
+
+	GLenum blit_target = (texture->target == GL_TEXTURE_CUBE_MAP) ? _cube_side_enum[p_cube_side] : GL_TEXTURE_2D;
+
+	DVector<uint8_t>::Read read = img.get_data().read();
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(texture->target, texture->tex_id);
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexSubImage2D(blit_target, 0, p_dst_x, p_dst_y, img.get_width(), img.get_height(), format, GL_UNSIGNED_BYTE, &read[0]);
+
+	if (texture->flags & VS::TEXTURE_FLAG_MIPMAPS && !texture->ignore_mipmaps) {
+		//only the base level was written, rebuild the rest
+		glGenerateMipmap(texture->target);
+	}
+}
+
 Image RasterizerGLES2::texture_get_data(RID p_texture, VS::CubeMapSide p_cube_side) const {
 
 	Texture *texture = texture_owner.get(p_texture);
@@ -3962,6 +4004,8 @@ void RasterizerGLES2::begin_frame() {
 	_rinfo.ci_draw_commands = 0;
 	_rinfo.surface_count = 0;
 	_rinfo.draw_calls = 0;
+	_rinfo.ci_draw_calls = 0;
+	_rinfo.ci_batches = 0;
 
 	_update_fixed_materials();
 	while (_shader_dirty_list.first()) {
@@ -7670,6 +7714,7 @@ void RasterizerGLES2::canvas_draw_line(const Point2 &p_from, const Point2 &p_to,
 	glLineWidth(p_width);
 	_draw_primitive(2, verts, 0, 0, 0);
 	_rinfo.ci_draw_commands++;
+	_rinfo.ci_draw_calls++;
 }
 
 void RasterizerGLES2::_draw_gui_primitive(int p_points, const Vector2 *p_vertices, const Color *p_colors, const Vector2 *p_uvs) {
@@ -7875,6 +7920,48 @@ void RasterizerGLES2::canvas_draw_rect(const Rect2 &p_rect, int p_flags, const R
 	}
 
 	_rinfo.ci_draw_commands++;
+	_rinfo.ci_draw_calls++;
+}
+
+static int _style_box_get_quads(const Rect2 &p_rect, const Rect2 &p_region, const float *p_margin, bool p_draw_center, Rect2 *r_rects, Rect2 *r_sources) {
+
+	Rect2 rect_center(p_rect.pos + Point2(p_margin[MARGIN_LEFT], p_margin[MARGIN_TOP]), Size2(p_rect.size.width - p_margin[MARGIN_LEFT] - p_margin[MARGIN_RIGHT], p_rect.size.height - p_margin[MARGIN_TOP] - p_margin[MARGIN_BOTTOM]));
+	Rect2 src_center(Point2(p_region.pos.x + p_margin[MARGIN_LEFT], p_region.pos.y + p_margin[MARGIN_TOP]), Size2(p_region.size.width - p_margin[MARGIN_LEFT] - p_margin[MARGIN_RIGHT], p_region.size.height - p_margin[MARGIN_TOP] - p_margin[MARGIN_BOTTOM]));
+
+	/* CORNERS */
+	// top left
+	r_rects[0] = Rect2(p_rect.pos, Size2(p_margin[MARGIN_LEFT], p_margin[MARGIN_TOP]));
+	r_sources[0] = Rect2(p_region.pos, Size2(p_margin[MARGIN_LEFT], p_margin[MARGIN_TOP]));
+	// top right
+	r_rects[1] = Rect2(Point2(p_rect.pos.x + p_rect.size.width - p_margin[MARGIN_RIGHT], p_rect.pos.y), Size2(p_margin[MARGIN_RIGHT], p_margin[MARGIN_TOP]));
+	r_sources[1] = Rect2(Point2(p_region.pos.x + p_region.size.width - p_margin[MARGIN_RIGHT], p_region.pos.y), Size2(p_margin[MARGIN_RIGHT], p_margin[MARGIN_TOP]));
+	// bottom left
+	r_rects[2] = Rect2(Point2(p_rect.pos.x, p_rect.pos.y + p_rect.size.height - p_margin[MARGIN_BOTTOM]), Size2(p_margin[MARGIN_LEFT], p_margin[MARGIN_BOTTOM]));
+	r_sources[2] = Rect2(Point2(p_region.pos.x, p_region.pos.y + p_region.size.height - p_margin[MARGIN_BOTTOM]), Size2(p_margin[MARGIN_LEFT], p_margin[MARGIN_BOTTOM]));
+	// bottom right
+	r_rects[3] = Rect2(Point2(p_rect.pos.x + p_rect.size.width - p_margin[MARGIN_RIGHT], p_rect.pos.y + p_rect.size.height - p_margin[MARGIN_BOTTOM]), Size2(p_margin[MARGIN_RIGHT], p_margin[MARGIN_BOTTOM]));
+	r_sources[3] = Rect2(Point2(p_region.pos.x + p_region.size.width - p_margin[MARGIN_RIGHT], p_region.pos.y + p_region.size.height - p_margin[MARGIN_BOTTOM]), Size2(p_margin[MARGIN_RIGHT], p_margin[MARGIN_BOTTOM]));
+
+	/* SIDES */
+	// top
+	r_rects[4] = Rect2(Point2(rect_center.pos.x, p_rect.pos.y), Size2(rect_center.size.width, p_margin[MARGIN_TOP]));
+	r_sources[4] = Rect2(Point2(src_center.pos.x, p_region.pos.y), Size2(src_center.size.width, p_margin[MARGIN_TOP]));
+	// bottom
+	r_rects[5] = Rect2(Point2(rect_center.pos.x, rect_center.pos.y + rect_center.size.height), Size2(rect_center.size.width, p_margin[MARGIN_BOTTOM]));
+	r_sources[5] = Rect2(Point2(src_center.pos.x, src_center.pos.y + src_center.size.height), Size2(src_center.size.width, p_margin[MARGIN_BOTTOM]));
+	// left
+	r_rects[6] = Rect2(Point2(p_rect.pos.x, rect_center.pos.y), Size2(p_margin[MARGIN_LEFT], rect_center.size.height));
+	r_sources[6] = Rect2(Point2(p_region.pos.x, p_region.pos.y + p_margin[MARGIN_TOP]), Size2(p_margin[MARGIN_LEFT], src_center.size.height));
+	// right
+	r_rects[7] = Rect2(Point2(rect_center.pos.x + rect_center.size.width, rect_center.pos.y), Size2(p_margin[MARGIN_RIGHT], rect_center.size.height));
+	r_sources[7] = Rect2(Point2(src_center.pos.x + src_center.size.width, p_region.pos.y + p_margin[MARGIN_TOP]), Size2(p_margin[MARGIN_RIGHT], src_center.size.height));
+
+	if (!p_draw_center)
+		return 8;
+
+	r_rects[8] = rect_center;
+	r_sources[8] = src_center;
+	return 9;
 }
 
 void RasterizerGLES2::canvas_draw_style_box(const Rect2 &p_rect, const Rect2 &p_src_region, RID p_texture, const float *p_margin, bool p_draw_center, const Color &p_modulate) {
@@ -7891,60 +7978,171 @@ void RasterizerGLES2::canvas_draw_style_box(const Rect2 &p_rect, const Rect2 &p_
 		region.size.width = texture->width;
 	if (region.size.height <= 0)
 		region.size.height = texture->height;
-	/* CORNERS */
-	_draw_textured_quad( // top left
-			Rect2(p_rect.pos, Size2(p_margin[MARGIN_LEFT], p_margin[MARGIN_TOP])),
-			Rect2(region.pos, Size2(p_margin[MARGIN_LEFT], p_margin[MARGIN_TOP])),
-			Size2(texture->width, texture->height));
-
-	_draw_textured_quad( // top right
-			Rect2(Point2(p_rect.pos.x + p_rect.size.width - p_margin[MARGIN_RIGHT], p_rect.pos.y), Size2(p_margin[MARGIN_RIGHT], p_margin[MARGIN_TOP])),
-			Rect2(Point2(region.pos.x + region.size.width - p_margin[MARGIN_RIGHT], region.pos.y), Size2(p_margin[MARGIN_RIGHT], p_margin[MARGIN_TOP])),
-			Size2(texture->width, texture->height));
-
-	_draw_textured_quad( // bottom left
-			Rect2(Point2(p_rect.pos.x, p_rect.pos.y + p_rect.size.height - p_margin[MARGIN_BOTTOM]), Size2(p_margin[MARGIN_LEFT], p_margin[MARGIN_BOTTOM])),
-			Rect2(Point2(region.pos.x, region.pos.y + region.size.height - p_margin[MARGIN_BOTTOM]), Size2(p_margin[MARGIN_LEFT], p_margin[MARGIN_BOTTOM])),
-			Size2(texture->width, texture->height));
-
-	_draw_textured_quad( // bottom right
-			Rect2(Point2(p_rect.pos.x + p_rect.size.width - p_margin[MARGIN_RIGHT], p_rect.pos.y + p_rect.size.height - p_margin[MARGIN_BOTTOM]), Size2(p_margin[MARGIN_RIGHT], p_margin[MARGIN_BOTTOM])),
-			Rect2(Point2(region.pos.x + region.size.width - p_margin[MARGIN_RIGHT], region.pos.y + region.size.height - p_margin[MARGIN_BOTTOM]), Size2(p_margin[MARGIN_RIGHT], p_margin[MARGIN_BOTTOM])),
-			Size2(texture->width, texture->height));
 
-	Rect2 rect_center(p_rect.pos + Point2(p_margin[MARGIN_LEFT], p_margin[MARGIN_TOP]), Size2(p_rect.size.width - p_margin[MARGIN_LEFT] - p_margin[MARGIN_RIGHT], p_rect.size.height - p_margin[MARGIN_TOP] - p_margin[MARGIN_BOTTOM]));
+	Rect2 rects[9];
+	Rect2 sources[9];
+	int quads = _style_box_get_quads(p_rect, region, p_margin, p_draw_center, rects, sources);
 
-	Rect2 src_center(Point2(region.pos.x + p_margin[MARGIN_LEFT], region.pos.y + p_margin[MARGIN_TOP]), Size2(region.size.width - p_margin[MARGIN_LEFT] - p_margin[MARGIN_RIGHT], region.size.height - p_margin[MARGIN_TOP] - p_margin[MARGIN_BOTTOM]));
+	for (int i = 0; i < quads; i++) {
 
-	_draw_textured_quad( // top
-			Rect2(Point2(rect_center.pos.x, p_rect.pos.y), Size2(rect_center.size.width, p_margin[MARGIN_TOP])),
-			Rect2(Point2(src_center.pos.x, region.pos.y), Size2(src_center.size.width, p_margin[MARGIN_TOP])),
-			Size2(texture->width, texture->height));
+		_draw_textured_quad(rects[i], sources[i], Size2(texture->width, texture->height));
+	}
 
-	_draw_textured_quad( // bottom
-			Rect2(Point2(rect_center.pos.x, rect_center.pos.y + rect_center.size.height), Size2(rect_center.size.width, p_margin[MARGIN_BOTTOM])),
-			Rect2(Point2(src_center.pos.x, src_center.pos.y + src_center.size.height), Size2(src_center.size.width, p_margin[MARGIN_BOTTOM])),
-			Size2(texture->width, texture->height));
+	_rinfo.ci_draw_commands++;
+	_rinfo.ci_draw_calls += quads;
+}
 
-	_draw_textured_quad( // left
-			Rect2(Point2(p_rect.pos.x, rect_center.pos.y), Size2(p_margin[MARGIN_LEFT], rect_center.size.height)),
-			Rect2(Point2(region.pos.x, region.pos.y + p_margin[MARGIN_TOP]), Size2(p_margin[MARGIN_LEFT], src_center.size.height)),
-			Size2(texture->width, texture->height));
+void RasterizerGLES2::_canvas_batch_begin(const RID &p_texture) {
 
-	_draw_textured_quad( // right
-			Rect2(Point2(rect_center.pos.x + rect_center.size.width, rect_center.pos.y), Size2(p_margin[MARGIN_RIGHT], rect_center.size.height)),
-			Rect2(Point2(src_center.pos.x + src_center.size.width, region.pos.y + p_margin[MARGIN_TOP]), Size2(p_margin[MARGIN_RIGHT], src_center.size.height)),
-			Size2(texture->width, texture->height));
+	canvas_batch_buffer.texture_size = Size2();
 
-	if (p_draw_center) {
+	if (p_texture.is_valid()) {
 
-		_draw_textured_quad(
-				rect_center,
-				src_center,
-				Size2(texture->width, texture->height));
+		Texture *texture = texture_owner.get(p_texture);
+		if (texture)
+			canvas_batch_buffer.texture_size = Size2(texture->width, texture->height);
 	}
+}
 
-	_rinfo.ci_draw_commands++;
+void RasterizerGLES2::_canvas_batch_add_quad(const Rect2 &p_rect, const Rect2 &p_src_region, const Color &p_color, bool p_h_flip, bool p_v_flip, bool p_transpose) {
+
+	//Rasterizer draws the batch before it can overflow
+	ERR_FAIL_COND(canvas_batch.quads >= CANVAS_BATCH_MAX_QUADS);
+
+	CanvasBatchVertex *v = &canvas_batch_buffer.vertices[canvas_batch.quads * 4];
+
+	v[0].vertex = Vector2(p_rect.pos.x, p_rect.pos.y);
+	v[1].vertex = Vector2(p_rect.pos.x + p_rect.size.width, p_rect.pos.y);
+	v[2].vertex = Vector2(p_rect.pos.x + p_rect.size.width, p_rect.pos.y + p_rect.size.height);
+	v[3].vertex = Vector2(p_rect.pos.x, p_rect.pos.y + p_rect.size.height);
+
+	if (canvas_batch_buffer.texture_size.width > 0 && canvas_batch_buffer.texture_size.height > 0) {
+
+		Vector2 texcoords[4] = {
+			Vector2(p_src_region.pos.x / canvas_batch_buffer.texture_size.width,
+					p_src_region.pos.y / canvas_batch_buffer.texture_size.height),
+
+			Vector2((p_src_region.pos.x + p_src_region.size.width) / canvas_batch_buffer.texture_size.width,
+					p_src_region.pos.y / canvas_batch_buffer.texture_size.height),
+
+			Vector2((p_src_region.pos.x + p_src_region.size.width) / canvas_batch_buffer.texture_size.width,
+					(p_src_region.pos.y + p_src_region.size.height) / canvas_batch_buffer.texture_size.height),
+
+			Vector2(p_src_region.pos.x / canvas_batch_buffer.texture_size.width,
+					(p_src_region.pos.y + p_src_region.size.height) / canvas_batch_buffer.texture_size.height)
+		};
+
+		if (p_transpose) {
+			SWAP(texcoords[1], texcoords[3]);
+		}
+		if (p_h_flip) {
+			SWAP(texcoords[0], texcoords[1]);
+			SWAP(texcoords[2], texcoords[3]);
+		}
+		if (p_v_flip) {
+			SWAP(texcoords[1], texcoords[2]);
+			SWAP(texcoords[0], texcoords[3]);
+		}
+
+		for (int i = 0; i < 4; i++) {
+			v[i].uv = texcoords[i];
+		}
+	} else {
+
+		//untextured, the white texture is bound on flush
+		for (int i = 0; i < 4; i++) {
+			v[i].uv = Vector2();
+		}
+	}
+
+	for (int i = 0; i < 4; i++) {
+		v[i].color = p_color;
+	}
+
+	canvas_batch.quads++;
+}
+
+void RasterizerGLES2::_canvas_batch_add_rect(const CanvasItem::CommandRect *p_rect) {
+
+	Color m = p_rect->modulate;
+	m.a *= canvas_opacity;
+
+	if (canvas_batch_buffer.texture_size == Size2()) {
+
+		_canvas_batch_add_quad(p_rect->rect, Rect2(), m);
+		return;
+	}
+
+	int flags = p_rect->flags;
+	Rect2 region = (flags & CANVAS_RECT_REGION) ? p_rect->source : Rect2(Point2(), canvas_batch_buffer.texture_size);
+	_canvas_batch_add_quad(p_rect->rect, region, m, flags & CANVAS_RECT_FLIP_H, flags & CANVAS_RECT_FLIP_V, flags & CANVAS_RECT_TRANSPOSE);
+}
+
+void RasterizerGLES2::_canvas_batch_add_style_box(const CanvasItem::CommandStyle *p_style) {
+
+	ERR_FAIL_COND(canvas_batch_buffer.texture_size == Size2());
+
+	Color m = p_style->color;
+	m.a *= canvas_opacity;
+
+	Rect2 region = p_style->source;
+	if (region.size.width <= 0)
+		region.size.width = canvas_batch_buffer.texture_size.width;
+	if (region.size.height <= 0)
+		region.size.height = canvas_batch_buffer.texture_size.height;
+
+	Rect2 rects[9];
+	Rect2 sources[9];
+	int quads = _style_box_get_quads(p_style->rect, region, p_style->margin, p_style->draw_center, rects, sources);
+
+	for (int i = 0; i < quads; i++) {
+
+		_canvas_batch_add_quad(rects[i], sources[i], m);
+	}
+}
+
+void RasterizerGLES2::_canvas_batch_add(const CanvasItem::Command *p_command) {
+
+	if (p_command->type == CanvasItem::Command::TYPE_RECT)
+		_canvas_batch_add_rect(static_cast<const CanvasItem::CommandRect *>(p_command));
+	else
+		_canvas_batch_add_style_box(static_cast<const CanvasItem::CommandStyle *>(p_command));
+}
+
+void RasterizerGLES2::_canvas_batch_draw() {
+
+	_bind_canvas_texture(canvas_batch.texture);
+
+#ifndef GLES_NO_CLIENT_ARRAYS
+	const uint8_t *vertices = (const uint8_t *)canvas_batch_buffer.vertices;
+	const uint16_t *indices = canvas_batch_buffer.indices;
+#else
+	glBindBuffer(GL_ARRAY_BUFFER, canvas_batch_vertex_buffer);
+	glBufferData(GL_ARRAY_BUFFER, canvas_batch.quads * 4 * sizeof(CanvasBatchVertex), canvas_batch_buffer.vertices, GL_STREAM_DRAW);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, canvas_batch_index_buffer);
+	const uint8_t *vertices = NULL;
+	const uint16_t *indices = NULL;
+#endif
+
+	glEnableVertexAttribArray(VS::ARRAY_VERTEX);
+	glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, false, sizeof(CanvasBatchVertex), vertices);
+	glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
+	glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(CanvasBatchVertex), vertices + sizeof(Vector2));
+	glEnableVertexAttribArray(VS::ARRAY_COLOR);
+	glVertexAttribPointer(VS::ARRAY_COLOR, 4, GL_FLOAT, false, sizeof(CanvasBatchVertex), vertices + sizeof(Vector2) * 2);
+
+	glDrawElements(GL_TRIANGLES, canvas_batch.quads * 6, GL_UNSIGNED_SHORT, indices);
+
+	glDisableVertexAttribArray(VS::ARRAY_TEX_UV);
+	glDisableVertexAttribArray(VS::ARRAY_COLOR);
+
+#ifdef GLES_NO_CLIENT_ARRAYS
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+#endif
+
+	_rinfo.ci_draw_calls++;
+	_rinfo.ci_batches++;
 }
 
 void RasterizerGLES2::canvas_draw_primitive(const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture, float p_width) {
@@ -7955,6 +8153,7 @@ void RasterizerGLES2::canvas_draw_primitive(const Vector<Point2> &p_points, cons
 	_draw_gui_primitive(p_points.size(), p_points.ptr(), p_colors.ptr(), p_uvs.ptr());
 
 	_rinfo.ci_draw_commands++;
+	_rinfo.ci_draw_calls++;
 }
 
 void RasterizerGLES2::canvas_draw_polygon(int p_vertex_count, const int *p_indices, const Vector2 *p_vertices, const Vector2 *p_uvs, const Color *p_colors, const RID &p_texture, bool p_singlecolor) {
@@ -8075,6 +8274,7 @@ void RasterizerGLES2::canvas_draw_polygon(int p_vertex_count, const int *p_indic
 #endif
 
 	_rinfo.ci_draw_commands++;
+	_rinfo.ci_draw_calls++;
 };
 
 void RasterizerGLES2::canvas_set_transform(const Matrix32 &p_transform) {
@@ -8545,6 +8745,12 @@ void RasterizerGLES2::_canvas_item_render_commands(CanvasItem *p_item, CanvasIte
 
 		CanvasItem::Command *c = commands[i];
 
+		//normal mapped passes set the flip per command, so they are not batched
+		if (!use_normalmap && _canvas_batch_add_command(c))
+			continue;
+
+		_canvas_batch_flush();
+
 		switch (c->type) {
 			case CanvasItem::Command::TYPE_LINE: {
 
@@ -8684,6 +8890,8 @@ void RasterizerGLES2::_canvas_item_render_commands(CanvasItem *p_item, CanvasIte
 			} break;
 		}
 	}
+
+	_canvas_batch_end_item();
 }
 
 void RasterizerGLES2::_canvas_item_setup_shader_params(CanvasItemMaterial *material, Shader *shader) {
@@ -10386,6 +10594,16 @@ void RasterizerGLES2::init() {
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indices_buffer);
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, 16 * 1024, NULL, GL_DYNAMIC_DRAW);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); // unbind
+
+	glGenBuffers(1, &canvas_batch_vertex_buffer);
+	glBindBuffer(GL_ARRAY_BUFFER, canvas_batch_vertex_buffer);
+	glBufferData(GL_ARRAY_BUFFER, CANVAS_BATCH_MAX_QUADS * 4 * sizeof(CanvasBatchVertex), NULL, GL_STREAM_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glGenBuffers(1, &canvas_batch_index_buffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, canvas_batch_index_buffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, CANVAS_BATCH_MAX_QUADS * 6 * sizeof(uint16_t), canvas_batch_buffer.indices, GL_STATIC_DRAW);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 #endif
 
 	shader_time_rollback = GLOBAL_DEF("rasterizer/shader_time_rollback", 300);
@@ -10428,6 +10646,14 @@ int RasterizerGLES2::get_render_info(VS::RenderInfo p_info) {
 
 			return _rinfo.draw_calls;
 		} break;
+		case VS::INFO_2D_DRAW_CALLS_IN_FRAME: {
+
+			return _rinfo.ci_draw_calls;
+		} break;
+		case VS::INFO_2D_BATCHES_IN_FRAME: {
+
+			return _rinfo.ci_batches;
+		} break;
 		case VS::INFO_SURFACE_CHANGES_IN_FRAME: {
 
 			return _rinfo.surface_count;
@@ -10686,6 +10912,20 @@ RasterizerGLES2::RasterizerGLES2(bool p_compress_arrays, bool p_keep_ram_copy, b
 	skinned_buffer_size *= 1024;
 	skinned_buffer = memnew_arr(uint8_t, skinned_buffer_size);
 
+	canvas_batch_buffer.vertices = memnew_arr(CanvasBatchVertex, CANVAS_BATCH_MAX_QUADS * 4);
+	canvas_batch_buffer.indices = memnew_arr(uint16_t, CANVAS_BATCH_MAX_QUADS * 6);
+	for (int i = 0; i < CANVAS_BATCH_MAX_QUADS; i++) {
+
+		//two triangles per quad, same winding as the fan used for single rects
+		uint16_t *idx = &canvas_batch_buffer.indices[i * 6];
+		idx[0] = i * 4 + 0;
+		idx[1] = i * 4 + 1;
+		idx[2] = i * 4 + 2;
+		idx[3] = i * 4 + 0;
+		idx[4] = i * 4 + 2;
+		idx[5] = i * 4 + 3;
+	}
+
 	keep_copies = p_keep_ram_copy;
 	use_reload_hooks = p_use_reload_hooks;
 	pack_arrays = p_compress_arrays;
@@ -10737,6 +10977,8 @@ void RasterizerGLES2::restore_framebuffer() {
 RasterizerGLES2::~RasterizerGLES2() {
 
 	memdelete_arr(skinned_buffer);
+	memdelete_arr(canvas_batch_buffer.vertices);
+	memdelete_arr(canvas_batch_buffer.indices);
 };
 
 #endif
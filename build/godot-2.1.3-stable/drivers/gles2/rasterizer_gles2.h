@@ -1173,6 +1173,8 @@ class RasterizerGLES2 : public Rasterizer {
 		int shader_change_count;
 		int ci_draw_commands;
 		int draw_calls;
+		int ci_draw_calls;
+		int ci_batches;
 
 	} _rinfo;
 
@@ -1233,6 +1235,35 @@ class RasterizerGLES2 : public Rasterizer {
 	_FORCE_INLINE_ Texture *_bind_canvas_texture(const RID &p_texture);
 	VS::MaterialBlendMode canvas_blend_mode;
 
+	/* CANVAS BATCHING */
+
+	struct CanvasBatchVertex {
+
+		Vector2 vertex;
+		Vector2 uv;
+		Color color;
+	};
+
+	//vertices of the batch Rasterizer is building, CANVAS_BATCH_MAX_QUADS at most
+	struct CanvasBatchBuffer {
+
+		Size2 texture_size; //zero if untextured
+		CanvasBatchVertex *vertices;
+		uint16_t *indices;
+
+	} canvas_batch_buffer;
+
+	GLuint canvas_batch_vertex_buffer;
+	GLuint canvas_batch_index_buffer;
+
+	_FORCE_INLINE_ void _canvas_batch_add_quad(const Rect2 &p_rect, const Rect2 &p_src_region, const Color &p_color, bool p_h_flip = false, bool p_v_flip = false, bool p_transpose = false);
+	void _canvas_batch_add_rect(const CanvasItem::CommandRect *p_rect);
+	void _canvas_batch_add_style_box(const CanvasItem::CommandStyle *p_style);
+
+	virtual void _canvas_batch_begin(const RID &p_texture);
+	virtual void _canvas_batch_add(const CanvasItem::Command *p_command);
+	virtual void _canvas_batch_draw();
+
 	int _setup_geometry_vinfo;
 
 	bool pack_arrays;
@@ -1298,6 +1329,7 @@ public:
 	virtual RID texture_create();
 	virtual void texture_allocate(RID p_texture, int p_width, int p_height, Image::Format p_format, uint32_t p_flags = VS::TEXTURE_FLAGS_DEFAULT);
 	virtual void texture_set_data(RID p_texture, const Image &p_image, VS::CubeMapSide p_cube_side = VS::CUBEMAP_LEFT);
+	virtual void texture_set_data_partial(RID p_texture, const Image &p_image, int p_dst_x, int p_dst_y, VS::CubeMapSide p_cube_side = VS::CUBEMAP_LEFT);
 	virtual Image texture_get_data(RID p_texture, VS::CubeMapSide p_cube_side = VS::CUBEMAP_LEFT) const;
 	virtual void texture_set_flags(RID p_texture, uint32_t p_flags);
 	virtual uint32_t texture_get_flags(RID p_texture) const;
@@ -123,6 +123,12 @@ static String unescape_cmdline(const String &p_str) {
 #define MAIN_PRINT(m_txt)
 #endif
 
+static void _resource_thread_load_wait() {
+
+	//loader threads queue their visual server calls, flush them while the main thread waits
+	VisualServer::get_singleton()->sync();
+}
+
 void Main::print_help(const char *p_binary) {
 
 	OS::get_singleton()->print(VERSION_FULL_NAME " (c) 2008-2017 Juan Linietsky, Ariel Manzur.\n");
@@ -939,6 +945,8 @@ Error Main::setup2() {
 	register_scene_types();
 	register_server_types();
 
+	ResourceLoader::set_thread_load_wait_notify_func(_resource_thread_load_wait);
+
 	GLOBAL_DEF("display/custom_mouse_cursor", String());
 	GLOBAL_DEF("display/custom_mouse_cursor_hotspot", Vector2());
 	Globals::get_singleton()->set_custom_property_info("display/custom_mouse_cursor", PropertyInfo(Variant::STRING, "display/custom_mouse_cursor", PROPERTY_HINT_FILE, "*.png,*.webp"));
@@ -1632,6 +1640,8 @@ void Main::cleanup() {
 		memdelete(script_debugger);
 	}
 
+	ResourceLoader::finalize();
+
 	OS::get_singleton()->delete_main_loop();
 
 	OS::get_singleton()->_cmdline.clear();
@@ -67,6 +67,8 @@ void Performance::_bind_methods() {
 	BIND_CONSTANT(PHYSICS_3D_ACTIVE_OBJECTS);
 	BIND_CONSTANT(PHYSICS_3D_COLLISION_PAIRS);
 	BIND_CONSTANT(PHYSICS_3D_ISLAND_COUNT);
+	BIND_CONSTANT(RENDER_2D_DRAW_CALLS_IN_FRAME);
+	BIND_CONSTANT(RENDER_2D_BATCHES_IN_FRAME);
 
 	BIND_CONSTANT(MONITOR_MAX);
 }
@@ -103,6 +105,8 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"physics_3d/active_objects",
 		"physics_3d/collision_pairs",
 		"physics_3d/islands",
+		"raster/2d_draw_calls",
+		"raster/2d_batches",
 
 	};
 
@@ -148,6 +152,8 @@ float Performance::get_monitor(Monitor p_monitor) const {
 		case PHYSICS_3D_ACTIVE_OBJECTS: return PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_ACTIVE_OBJECTS);
 		case PHYSICS_3D_COLLISION_PAIRS: return PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_COLLISION_PAIRS);
 		case PHYSICS_3D_ISLAND_COUNT: return PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_ISLAND_COUNT);
+		case RENDER_2D_DRAW_CALLS_IN_FRAME: return VS::get_singleton()->get_render_info(VS::INFO_2D_DRAW_CALLS_IN_FRAME);
+		case RENDER_2D_BATCHES_IN_FRAME: return VS::get_singleton()->get_render_info(VS::INFO_2D_BATCHES_IN_FRAME);
 
 		default: {}
 	}
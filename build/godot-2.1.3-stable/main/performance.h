@@ -76,6 +76,8 @@ public:
 		PHYSICS_3D_COLLISION_PAIRS,
 		PHYSICS_3D_ISLAND_COUNT,
 		//physics
+		RENDER_2D_DRAW_CALLS_IN_FRAME,
+		RENDER_2D_BATCHES_IN_FRAME,
 		MONITOR_MAX
 	};
 
@@ -0,0 +1,210 @@
+/*************************************************************************/
+/*  test_bytebuf.cpp                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2017 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+#include "test_bytebuf.h"
+
+#include "modules/network/bytebuf.h"
+#include "os/os.h"
+
+namespace TestByteBuf {
+
+// "张三 Zhang", two 3-byte UTF-8 characters followed by ascii
+#define NON_ASCII_NAME "\xe5\xbc\xa0\xe4\xb8\x89 Zhang"
+#define NON_ASCII_NAME_BYTES 12
+
+static bool _check(bool p_ok, const String &p_what) {
+
+	OS::get_singleton()->print("\t%s: %s\n", p_ok ? "PASS" : "FAILED", p_what.utf8().get_data());
+	return p_ok;
+}
+
+static Array _fields() {
+
+	// same shape as the FIELDS schema emitted into the .pb.gd scripts
+	Array fields;
+	fields.push_back("name");
+	fields.push_back("string");
+	fields.push_back("score");
+	fields.push_back("int");
+	fields.push_back("time");
+	fields.push_back("long");
+	return fields;
+}
+
+static Dictionary _message(const String &p_name, int p_score) {
+
+	Dictionary d;
+	d["name"] = p_name;
+	d["score"] = p_score;
+	d["time"] = 1500000000;
+	return d;
+}
+
+static bool _same_message(const Dictionary &p_a, const Dictionary &p_b) {
+
+	return String(p_a["name"]) == String(p_b["name"]) && int(p_a["score"]) == int(p_b["score"]) && int64_t(p_a["time"]) == int64_t(p_b["time"]);
+}
+
+static bool _test_string() {
+
+	OS::get_singleton()->print("\n*** UTF-8 strings ***\n");
+
+	bool ok = true;
+	String name = String::utf8(NON_ASCII_NAME);
+
+	Ref<ByteBuf> buf = memnew(ByteBuf);
+	buf->write_string(name);
+
+	// the prefix is the UTF-8 byte count, not the character count, which is
+	// what the server's message.write_string()/read_string() use as well
+	ok = _check(buf->get_size() == 4 + NON_ASCII_NAME_BYTES, "encoded size is prefix + UTF-8 bytes") && ok;
+	ok = _check(buf->read_i32() == NON_ASCII_NAME_BYTES, "length prefix is the UTF-8 byte count") && ok;
+	buf->seek(0);
+	ok = _check(buf->read_string() == name, "round trip") && ok;
+	ok = _check(buf->get_available() == 0, "nothing left to read") && ok;
+
+	return ok;
+}
+
+static bool _test_message() {
+
+	OS::get_singleton()->print("\n*** write_message/read_message ***\n");
+
+	bool ok = true;
+	Array fields = _fields();
+	Dictionary msg = _message(String::utf8(NON_ASCII_NAME), 42);
+
+	Ref<ByteBuf> buf = memnew(ByteBuf);
+	ok = _check(buf->write_message(9, fields, msg) == OK, "write_message") && ok;
+
+	int payload = 4 + NON_ASCII_NAME_BYTES + 4 + 8;
+	ok = _check(buf->get_size() == ByteBuf::FRAME_HEADER_SIZE + payload + ByteBuf::FRAME_TRAILER_SIZE, "frame size") && ok;
+	ok = _check(buf->read_i32() == 9, "frame id") && ok;
+	ok = _check(buf->read_i32() == payload, "payload length counts UTF-8 bytes") && ok;
+	buf->seek(buf->get_size() - 2);
+	ok = _check(buf->read_byte() == '@' && buf->read_byte() == '@', "'@@' trailer") && ok;
+	buf->seek(0);
+
+	ok = _check(buf->begin_frame() == 9, "begin_frame") && ok;
+	ok = _check(_same_message(buf->read_message(fields), msg), "read_message round trip") && ok;
+	buf->end_frame();
+	ok = _check(buf->get_available() == 0, "end_frame consumes the trailer") && ok;
+
+	return ok;
+}
+
+static bool _test_split_frames() {
+
+	OS::get_singleton()->print("\n*** Frames split across feeds ***\n");
+
+	bool ok = true;
+	Array fields = _fields();
+	Dictionary first = _message(String::utf8(NON_ASCII_NAME), 1);
+	Dictionary second = _message("ascii", 2);
+
+	Ref<ByteBuf> out = memnew(ByteBuf);
+	out->write_message(1, fields, first);
+	int first_size = out->get_size();
+	out->write_message(2, fields, second);
+	DVector<uint8_t> wire = out->raw_data();
+
+	// cut inside the first multi-byte character, then between the two '@'
+	int cuts[] = { ByteBuf::FRAME_HEADER_SIZE + 4 + 1, first_size - 1, wire.size() };
+	Ref<ByteBuf> in = memnew(ByteBuf);
+	int from = 0;
+	for (int i = 0; i < 3; i++) {
+
+		DVector<uint8_t> part;
+		part.resize(cuts[i] - from);
+		{
+			DVector<uint8_t>::Read r = wire.read();
+			DVector<uint8_t>::Write w = part.write();
+			copymem(w.ptr(), &r[from], part.size());
+		}
+		from = cuts[i];
+		in->feed(part);
+
+		if (i < 2)
+			ok = _check(in->begin_frame() == -1, "incomplete frame is not returned (cut " + itos(i) + ")") && ok;
+	}
+
+	ok = _check(in->begin_frame() == 1, "first frame") && ok;
+	ok = _check(_same_message(in->read_message(fields), first), "first frame payload") && ok;
+	in->end_frame();
+	ok = _check(in->begin_frame() == 2, "second frame") && ok;
+	ok = _check(_same_message(in->read_message(fields), second), "second frame payload") && ok;
+	in->end_frame();
+	ok = _check(in->begin_frame() == -1 && in->get_available() == 0, "stream drained") && ok;
+
+	// one byte at a time, a frame must only appear once its last '@' arrived
+	in->clear();
+	int frames = 0;
+	{
+		DVector<uint8_t>::Read r = wire.read();
+		for (int i = 0; i < wire.size(); i++) {
+
+			DVector<uint8_t> byte;
+			byte.push_back(r[i]);
+			in->feed(byte);
+
+			int id = in->begin_frame();
+			if (id < 0)
+				continue;
+
+			bool at_end = (i + 1 == first_size) || (i + 1 == wire.size());
+			ok = _check(at_end && id == frames + 1, "frame " + itos(id) + " completes on its trailer") && ok;
+			ok = _check(_same_message(in->read_message(fields), id == 1 ? first : second), "frame " + itos(id) + " payload") && ok;
+			in->end_frame();
+			frames++;
+		}
+	}
+	ok = _check(frames == 2, "both frames decoded byte by byte") && ok;
+
+	return ok;
+}
+
+MainLoop *test() {
+
+	int passed = 0;
+	int count = 0;
+
+	count++;
+	if (_test_string())
+		passed++;
+	count++;
+	if (_test_message())
+		passed++;
+	count++;
+	if (_test_split_frames())
+		passed++;
+
+	OS::get_singleton()->print("\nPassed %i of %i tests\n", passed, count);
+
+	return NULL;
+}
+}
@@ -0,0 +1,207 @@
+/*************************************************************************/
+/*  test_canvas_batch.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2017 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "test_canvas_batch.h"
+
+#include "globals.h"
+#include "os/os.h"
+#include "servers/visual/rasterizer_dummy.h"
+
+namespace TestCanvasBatch {
+
+#define MAX_QUADS 2048 // Rasterizer::CANVAS_BATCH_MAX_QUADS
+
+typedef Rasterizer::CanvasItem CanvasItem;
+
+static void _add_rect(CanvasItem *p_item, const RID &p_texture, uint8_t p_flags = 0) {
+
+	CanvasItem::CommandRect *rect = memnew(CanvasItem::CommandRect);
+	rect->rect = Rect2(0, 0, 16, 16);
+	rect->texture = p_texture;
+	rect->flags = p_flags;
+	p_item->commands.push_back(rect);
+}
+
+static void _add_style(CanvasItem *p_item, const RID &p_texture, bool p_draw_center) {
+
+	CanvasItem::CommandStyle *style = memnew(CanvasItem::CommandStyle);
+	style->rect = Rect2(0, 0, 64, 32);
+	style->texture = p_texture;
+	for (int i = 0; i < 4; i++) {
+		style->margin[i] = 4;
+	}
+	style->draw_center = p_draw_center;
+	p_item->commands.push_back(style);
+}
+
+static void _add_line(CanvasItem *p_item) {
+
+	CanvasItem::CommandLine *line = memnew(CanvasItem::CommandLine);
+	line->width = 1;
+	p_item->commands.push_back(line);
+}
+
+static void _add_transform(CanvasItem *p_item) {
+
+	p_item->commands.push_back(memnew(CanvasItem::CommandTransform));
+}
+
+static bool _check(Rasterizer *p_rasterizer, CanvasItem *p_items, const char *p_name, int p_draw_calls, int p_batches) {
+
+	p_rasterizer->begin_frame();
+	p_rasterizer->canvas_render_items(p_items, 0, Color(1, 1, 1), NULL);
+	p_rasterizer->end_frame();
+
+	int draw_calls = p_rasterizer->get_render_info(VS::INFO_2D_DRAW_CALLS_IN_FRAME);
+	int batches = p_rasterizer->get_render_info(VS::INFO_2D_BATCHES_IN_FRAME);
+	bool pass = draw_calls == p_draw_calls && batches == p_batches;
+
+	OS::get_singleton()->print("\t%s: %i draw calls, %i batches (expected %i, %i) %s\n", p_name, draw_calls, batches, p_draw_calls, p_batches, pass ? "ok" : "wrong");
+	return pass;
+}
+
+// a: a a a(style) | b | line | b(tiled) | b b(style, no center) | transform | b
+// next item: a
+static void _make_sequence(CanvasItem *p_item, CanvasItem *p_next, const RID &p_a, const RID &p_b) {
+
+	_add_rect(p_item, p_a);
+	_add_rect(p_item, p_a);
+	_add_style(p_item, p_a, true);
+	_add_rect(p_item, p_b);
+	_add_line(p_item);
+	_add_rect(p_item, p_b, Rasterizer::CANVAS_RECT_TILE);
+	_add_rect(p_item, p_b);
+	_add_style(p_item, p_b, false);
+	_add_transform(p_item);
+	_add_rect(p_item, p_b);
+
+	_add_rect(p_next, p_a);
+	p_item->next = p_next;
+}
+
+static bool _test_sequence(bool p_batching) {
+
+	OS::get_singleton()->print("\n*** Rects and style boxes, batching %s ***\n", p_batching ? "on" : "off");
+
+	// read once, when the rasterizer is created
+	Globals::get_singleton()->set("rasterizer/use_2d_batching", p_batching);
+	RasterizerDummy *rasterizer = memnew(RasterizerDummy);
+	rasterizer->init();
+
+	RID a = rasterizer->texture_create();
+	RID b = rasterizer->texture_create();
+
+	CanvasItem item;
+	CanvasItem next;
+	_make_sequence(&item, &next, a, b);
+
+	bool pass;
+	if (p_batching) {
+		// texture change, line, tiled rect, transform and the end of each item split batches
+		pass = _check(rasterizer, &item, "sequence", 7, 5);
+	} else {
+		// every rect and the line is a draw call, every style box one per slice
+		pass = _check(rasterizer, &item, "sequence", 7 + 1 + 9 + 8, 0);
+	}
+
+	// counters are per frame
+	next.clear();
+	_add_line(&next);
+	pass = _check(rasterizer, &next, "next frame", 1, 0) && pass;
+
+	rasterizer->free(a);
+	rasterizer->free(b);
+	rasterizer->finish();
+	memdelete(rasterizer);
+
+	OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+	return pass;
+}
+
+static bool _test_max_quads() {
+
+	OS::get_singleton()->print("\n*** Batches are split at %i quads ***\n", MAX_QUADS);
+
+	Globals::get_singleton()->set("rasterizer/use_2d_batching", true);
+	RasterizerDummy *rasterizer = memnew(RasterizerDummy);
+	rasterizer->init();
+
+	RID texture = rasterizer->texture_create();
+
+	bool pass = true;
+
+	// exactly full, then one more
+	CanvasItem full;
+	for (int i = 0; i < MAX_QUADS; i++) {
+		_add_rect(&full, texture);
+	}
+	pass = _check(rasterizer, &full, "full batch", 1, 1) && pass;
+	_add_rect(&full, texture);
+	pass = _check(rasterizer, &full, "one rect more", 2, 2) && pass;
+
+	// a style box that wouldn't fit starts the next batch
+	CanvasItem style;
+	for (int i = 0; i < MAX_QUADS - 8; i++) {
+		_add_rect(&style, texture);
+	}
+	_add_style(&style, texture, true);
+	pass = _check(rasterizer, &style, "style box past the end", 2, 2) && pass;
+
+	rasterizer->free(texture);
+	rasterizer->finish();
+	memdelete(rasterizer);
+
+	OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+	return pass;
+}
+
+MainLoop *test() {
+
+	Variant batching = Globals::get_singleton()->get("rasterizer/use_2d_batching");
+
+	int passed = 0;
+	int count = 0;
+
+	count++;
+	if (_test_sequence(true))
+		passed++;
+	count++;
+	if (_test_sequence(false))
+		passed++;
+	count++;
+	if (_test_max_quads())
+		passed++;
+
+	Globals::get_singleton()->set("rasterizer/use_2d_batching", batching);
+
+	OS::get_singleton()->print("\nPassed %i of %i tests\n", passed, count);
+
+	return NULL;
+}
+}
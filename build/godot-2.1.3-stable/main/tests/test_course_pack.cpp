@@ -0,0 +1,333 @@
+/*************************************************************************/
+/*  test_course_pack.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2017 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "test_course_pack.h"
+
+#include "io/course_pack.h"
+#include "io/course_packer.h"
+#include "io/file_access_pack.h"
+#include "io/json.h"
+#include "io/marshalls.h"
+#include "os/dir_access.h"
+#include "os/file_access.h"
+#include "os/os.h"
+
+namespace TestCoursePack {
+
+#define TEST_DIR "user://test_course_pack"
+#define TEST_PACK_PATH "user://test_course_pack.cpk"
+#define TEST_BAD_PATH "user://test_course_pack_bad.cpk"
+#define TEST_RES_PATH "res://courses/test_course_pack"
+#define TEST_ALIGNMENT 32
+#define TEST_MEDIA_SIZE 5000
+
+static const char *lesson_files[2] = { "unit1/first.lesson", "unit2/second.lesson" };
+static const char *lesson_texts[2] = {
+	"{\"title\":\"First\",\"words\":[\"apple\",\"pear\"],\"count\":2,\"meta\":{\"level\":1,\"done\":false}}",
+	"{\"title\":\"Second \\u4e2d\\u6587\",\"sentences\":[{\"en\":\"Hello\",\"time\":1.5},{\"en\":\"Bye\",\"time\":3}],\"empty\":{}}"
+};
+static const char *media_file = "unit1/icon.png";
+
+static bool _store(const String &p_path, const uint8_t *p_data, int p_len) {
+
+	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE);
+	if (!f)
+		return false;
+	f->store_buffer(p_data, p_len);
+	memdelete(f);
+	return true;
+}
+
+static Vector<uint8_t> _media_data() {
+
+	Vector<uint8_t> data;
+	data.resize(TEST_MEDIA_SIZE);
+	for (int i = 0; i < data.size(); i++) {
+		data[i] = (i * 7 + 3) & 0xFF;
+	}
+	return data;
+}
+
+static bool _write_course() {
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	bool ok = da->make_dir_recursive(String(TEST_DIR).plus_file("unit1")) == OK && da->make_dir_recursive(String(TEST_DIR).plus_file("unit2")) == OK;
+	memdelete(da);
+
+	for (int i = 0; i < 2 && ok; i++) {
+		CharString text = String(lesson_texts[i]).utf8();
+		ok = _store(String(TEST_DIR).plus_file(lesson_files[i]), (const uint8_t *)text.get_data(), text.length());
+	}
+
+	Vector<uint8_t> media = _media_data();
+	if (ok)
+		ok = _store(String(TEST_DIR).plus_file(media_file), media.ptr(), media.size());
+
+	if (!ok)
+		OS::get_singleton()->print("\tcan't write the test course\n");
+	return ok;
+}
+
+static void _remove_files() {
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	for (int i = 0; i < 2; i++) {
+		da->remove(String(TEST_DIR).plus_file(lesson_files[i]));
+	}
+	da->remove(String(TEST_DIR).plus_file(media_file));
+	da->remove(String(TEST_DIR).plus_file("unit1"));
+	da->remove(String(TEST_DIR).plus_file("unit2"));
+	da->remove(TEST_DIR);
+	da->remove(TEST_PACK_PATH);
+	da->remove(TEST_BAD_PATH);
+	memdelete(da);
+}
+
+// Dictionary and Array compare by reference, decoded lessons have to be walked
+static bool _same(const Variant &p_a, const Variant &p_b) {
+
+	if (p_a.get_type() != p_b.get_type())
+		return false;
+
+	if (p_a.get_type() == Variant::DICTIONARY) {
+
+		Dictionary a = p_a;
+		Dictionary b = p_b;
+		if (a.size() != b.size())
+			return false;
+
+		List<Variant> keys;
+		a.get_key_list(&keys);
+		for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
+			if (!b.has(E->get()) || !_same(a[E->get()], b[E->get()]))
+				return false;
+		}
+		return true;
+	}
+
+	if (p_a.get_type() == Variant::ARRAY) {
+
+		Array a = p_a;
+		Array b = p_b;
+		if (a.size() != b.size())
+			return false;
+
+		for (int i = 0; i < a.size(); i++) {
+			if (!_same(a[i], b[i]))
+				return false;
+		}
+		return true;
+	}
+
+	return p_a == p_b;
+}
+
+static bool _test_round_trip() {
+
+	OS::get_singleton()->print("\n*** Pack a course and read it back ***\n");
+
+	CoursePacker packer;
+	Error err = packer.pack_start(TEST_PACK_PATH, TEST_ALIGNMENT);
+	if (err == OK)
+		err = packer.add_dir(TEST_RES_PATH, TEST_DIR);
+	if (err == OK)
+		err = packer.flush();
+	if (err != OK) {
+		OS::get_singleton()->print("\tpacking failed, error %i\n\tFAILED\n", err);
+		return false;
+	}
+
+	CoursePack pack;
+	err = pack.open(TEST_PACK_PATH);
+	if (err != OK) {
+		OS::get_singleton()->print("\topening the pack failed, error %i\n\tFAILED\n", err);
+		return false;
+	}
+
+	bool pass = pack.get_lesson_list().size() == 2;
+
+	for (int i = 0; i < 2; i++) {
+
+		String src = String(TEST_DIR).plus_file(lesson_files[i]);
+		String md5 = FileAccess::get_md5(src);
+
+		Dictionary expected;
+		String err_str;
+		int err_line;
+		JSON::parse_file(src, expected, err_str, err_line);
+
+		bool same = pack.get_lesson_md5(String(TEST_RES_PATH).plus_file(lesson_files[i])) == md5 && pack.has_lesson(md5) && _same(pack.get_lesson(md5), expected);
+		OS::get_singleton()->print("\t%s: %s\n", lesson_files[i], same ? "same" : "different");
+		pass = pass && same;
+	}
+
+	// media comes back byte for byte, from an aligned offset, through FileAccessPack
+	Vector<uint8_t> media = _media_data();
+	String media_path = String(TEST_RES_PATH).plus_file(media_file);
+	ByteArray read = pack.get_media(media_path);
+	bool media_ok = pack.has_media(media_path) && read.size() == media.size();
+	if (media_ok) {
+		ByteArray::Read r = read.read();
+		media_ok = memcmp(r.ptr(), media.ptr(), media.size()) == 0;
+	}
+
+	FileAccess *f = pack.open_media(media_path);
+	if (f) {
+		// reads past the blob must stop at its end, not run into the rest of the pack
+		uint8_t tail[64];
+		f->seek(media.size() - 16);
+		media_ok = media_ok && f->get_len() == (size_t)media.size() && f->get_buffer(tail, 64) == 16 && memcmp(tail, &media[media.size() - 16], 16) == 0;
+		media_ok = media_ok && f->eof_reached();
+		memdelete(f);
+	} else {
+		media_ok = false;
+	}
+	OS::get_singleton()->print("\t%s: %s\n", media_file, media_ok ? "same" : "different");
+	pass = pass && media_ok;
+
+	// once mounted, the media opens through its res:// path like a file inside a .pck
+	if (PackedData::get_singleton() && !PackedData::get_singleton()->is_disabled()) {
+
+		bool mounted = pack.mount_media() == OK;
+		FileAccess *mf = mounted ? FileAccess::open(media_path, FileAccess::READ) : NULL;
+		if (mf) {
+			Vector<uint8_t> data;
+			data.resize(mf->get_len());
+			mounted = data.size() == media.size() && mf->get_buffer(data.ptr(), data.size()) == data.size() && memcmp(data.ptr(), media.ptr(), media.size()) == 0;
+			memdelete(mf);
+		} else {
+			mounted = false;
+		}
+		OS::get_singleton()->print("\tmounted media: %s\n", mounted ? "same" : "different");
+		pass = pass && mounted;
+	}
+
+	OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+	return pass;
+}
+
+static bool _test_missing() {
+
+	OS::get_singleton()->print("\n*** Missing lessons and media ***\n");
+
+	CoursePack pack;
+	if (pack.open(TEST_PACK_PATH) != OK) {
+		OS::get_singleton()->print("\tFAILED\n");
+		return false;
+	}
+
+	String missing = String::md5((const uint8_t *)"0123456789abcdef");
+	FileAccess *f = pack.open_media(String(TEST_RES_PATH).plus_file("unit1/missing.png"));
+	bool pass = !pack.has_lesson(missing) && pack.get_lesson(missing).empty();
+	pass = pass && pack.get_lesson_md5(String(TEST_RES_PATH).plus_file("unit1/missing.lesson")) == String();
+	pass = pass && !pack.has_media(String(TEST_RES_PATH).plus_file("unit1/missing.png")) && !f;
+	if (f)
+		memdelete(f);
+
+	OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+	return pass;
+}
+
+static bool _test_corrupt() {
+
+	OS::get_singleton()->print("\n*** Corrupt and truncated packs ***\n");
+
+	Vector<uint8_t> good = FileAccess::get_file_as_array(TEST_PACK_PATH);
+	if (good.size() < 64) {
+		OS::get_singleton()->print("\tFAILED\n");
+		return false;
+	}
+
+	struct Case {
+		const char *name;
+		int size;
+		int word; // header word to overwrite, -1 for none
+		uint32_t value;
+		Error expected;
+	};
+
+	Case cases[6] = {
+		{ "bad magic", good.size(), 0, 0x12345678, ERR_FILE_UNRECOGNIZED },
+		{ "bad version", good.size(), 1, COURSE_PACK_VERSION + 1, ERR_FILE_UNRECOGNIZED },
+		{ "truncated header", 24, -1, 0, ERR_FILE_CORRUPT },
+		{ "truncated index", 64 + 10, -1, 0, ERR_FILE_CORRUPT },
+		{ "huge lesson count", 64, 3, 0x7FFFFFFF, ERR_FILE_CORRUPT },
+		{ "bad path length", good.size(), 16, 0xFFFFFFF0, ERR_FILE_CORRUPT },
+	};
+
+	bool pass = true;
+	for (int i = 0; i < 6; i++) {
+
+		Vector<uint8_t> data = good;
+		data.resize(cases[i].size);
+		if (cases[i].word >= 0) {
+			encode_uint32(cases[i].value, &data[cases[i].word * 4]);
+		}
+		_store(TEST_BAD_PATH, data.ptr(), data.size());
+
+		// must fail without reading past the file or leaving the pack half open
+		CoursePack pack;
+		Error err = pack.open(TEST_BAD_PATH);
+		bool ok = err == cases[i].expected && !pack.is_open() && pack.get_lesson_list().size() == 0;
+		OS::get_singleton()->print("\t%s: error %i, %s\n", cases[i].name, err, ok ? "ok" : "wrong");
+		pass = pass && ok;
+	}
+
+	OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+	return pass;
+}
+
+MainLoop *test() {
+
+	int passed = 0;
+	int count = 0;
+
+	if (!_write_course()) {
+		_remove_files();
+		OS::get_singleton()->print("\nPassed %i of %i tests\n", passed, count);
+		return NULL;
+	}
+
+	count++;
+	if (_test_round_trip())
+		passed++;
+	count++;
+	if (_test_missing())
+		passed++;
+	count++;
+	if (_test_corrupt())
+		passed++;
+
+	_remove_files();
+
+	OS::get_singleton()->print("\nPassed %i of %i tests\n", passed, count);
+
+	return NULL;
+}
+}
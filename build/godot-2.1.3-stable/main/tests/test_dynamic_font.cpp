@@ -0,0 +1,180 @@
+/*************************************************************************/
+/*  test_dynamic_font.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2017 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+#include "test_dynamic_font.h"
+
+#include "os/file_access.h"
+#include "os/os.h"
+
+#ifdef FREETYPE_ENABLED
+
+#include "scene/resources/dynamic_font.h"
+#include "servers/visual_server.h"
+
+namespace TestDynamicFont {
+
+#define PAGE_CHARS 2000
+#define PAGE_LINE_CHARS 40
+#define PRERENDER_TIMEOUT_USEC 60000000
+
+// the sizes of the lesson fonts
+static const int font_sizes[] = { 16, 24, 32, 44, 64, 88, 0 };
+
+static Ref<DynamicFont> _make_font(const String &p_path, int p_size) {
+
+	// a new DynamicFontData each time, so every run starts with empty atlases
+	Ref<DynamicFontData> data;
+	data.instance();
+	data->set_font_path(p_path);
+
+	Ref<DynamicFont> font;
+	font.instance();
+	font->set_size(p_size);
+	font->set_use_mipmaps(true);
+	font->set_use_filter(true);
+	font->set_font_data(data);
+	return font;
+}
+
+static uint64_t _render_page(const Ref<DynamicFont> &p_font, const String &p_page, uint64_t *r_worst_char = NULL) {
+
+	RID canvas_item = VisualServer::get_singleton()->canvas_item_create();
+
+	Point2 pos(0, p_font->get_ascent());
+	uint64_t worst = 0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+	for (int i = 0; i < p_page.length(); i++) {
+
+		if (i > 0 && i % PAGE_LINE_CHARS == 0) {
+			pos.x = 0;
+			pos.y += p_font->get_height();
+		}
+
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		pos.x += p_font->draw_char(canvas_item, pos, p_page[i], p_page[i + 1]);
+		worst = MAX(worst, OS::get_singleton()->get_ticks_usec() - from);
+	}
+
+	uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	VisualServer::get_singleton()->free(canvas_item);
+
+	if (r_worst_char)
+		*r_worst_char = worst;
+	return usec;
+}
+
+static void _bench_size(const String &p_path, const String &p_page, int p_size) {
+
+	// glyphs rasterized and uploaded while drawing, as a lesson page shows up today
+	uint64_t cold_worst;
+	Ref<DynamicFont> font = _make_font(p_path, p_size);
+	uint64_t cold = _render_page(font, p_page, &cold_worst);
+	uint64_t cached = _render_page(font, p_page);
+	font = Ref<DynamicFont>();
+
+	// the page text handed to the worker beforehand, the first draw only packs and uploads
+	font = _make_font(p_path, p_size);
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	font->prerender_text(p_page);
+	uint64_t queue = OS::get_singleton()->get_ticks_usec() - from;
+	while (font->get_prerender_pending() && OS::get_singleton()->get_ticks_usec() - from < PRERENDER_TIMEOUT_USEC) {
+		OS::get_singleton()->delay_usec(1000);
+	}
+	uint64_t prerender = OS::get_singleton()->get_ticks_usec() - from;
+
+	uint64_t warm_worst;
+	uint64_t warm = _render_page(font, p_page, &warm_worst);
+
+	OS::get_singleton()->print("size %i\n", p_size);
+	OS::get_singleton()->print("\tfirst render: %.1f ms (worst char %.2f ms), cached render: %.1f ms\n", cold / 1000.0, cold_worst / 1000.0, cached / 1000.0);
+	OS::get_singleton()->print("\tprerendered in background: %.1f ms (%.2f ms on the calling thread)\n", prerender / 1000.0, queue / 1000.0);
+	OS::get_singleton()->print("\tfirst render after prerender: %.1f ms (worst char %.2f ms)\n", warm / 1000.0, warm_worst / 1000.0);
+}
+
+MainLoop *test() {
+
+	List<String> cmdlargs = OS::get_singleton()->get_cmdline_args();
+
+	String path;
+	String page_path;
+	for (List<String>::Element *E = cmdlargs.front(); E; E = E->next()) {
+
+		if (E->get() != "dynamic_font")
+			continue;
+		if (E->next())
+			path = E->next()->get();
+		if (E->next() && E->next()->next())
+			page_path = E->next()->next()->get();
+		break;
+	}
+
+	if (path == "") {
+		OS::get_singleton()->print("Usage: -test dynamic_font <font.ttf> [page.txt]\n");
+		return NULL;
+	}
+
+	String page;
+	if (page_path != "") {
+
+		Vector<uint8_t> buf = FileAccess::get_file_as_array(page_path);
+		if (buf.empty() || page.parse_utf8((const char *)buf.ptr(), buf.size())) {
+			OS::get_singleton()->print("Can't read page text: %ls\n", page_path.c_str());
+			return NULL;
+		}
+	} else {
+
+		// the first PAGE_CHARS CJK unified ideographs, most of them common hanzi
+		for (int i = 0; i < PAGE_CHARS; i++) {
+			page += String::chr(0x4E00 + i);
+		}
+	}
+
+	OS::get_singleton()->print("%ls, %i chars\n\n", path.c_str(), page.length());
+
+	for (int i = 0; font_sizes[i]; i++) {
+		_bench_size(path, page, font_sizes[i]);
+	}
+
+	return NULL;
+}
+}
+
+#else
+
+namespace TestDynamicFont {
+
+MainLoop *test() {
+
+	OS::get_singleton()->print("DynamicFont benchmark needs FreeType.\n");
+	return NULL;
+}
+}
+
+#endif
@@ -535,7 +535,8 @@ static String _disassemble_addr(const Ref<GDScript> &p_script, const GDFunction
 	return "<err>";
 }
 
-static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String> &p_code) {
+// prints the bytecode of every function, or only collects the opcodes each function uses when r_opcodes is given
+static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String> &p_code, Map<StringName, Set<int> > *r_opcodes = NULL) {
 
 	const Map<StringName, GDFunction *> &mf = p_class->debug_get_member_functions();
 
@@ -555,7 +556,8 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 			}
 			defargs += " ";
 		}
-		print_line("== function " + String(func.get_name()) + "() :: stack size: " + itos(func.get_max_stack_size()) + " " + defargs + "==");
+		if (!r_opcodes)
+			print_line("== function " + String(func.get_name()) + "() :: stack size: " + itos(func.get_max_stack_size()) + " " + defargs + "==");
 
 #define DADDR(m_ip) (_disassemble_addr(p_class, func, code[ip + m_ip]))
 
@@ -724,7 +726,7 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 
 					int argc = code[ip + 1];
 					if (ret) {
-						txt += DADDR(4 + argc) + "=";
+						txt += DADDR(5 + argc) + "=";
 					}
 
 					txt += DADDR(2) + ".";
@@ -734,11 +736,11 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					for (int i = 0; i < argc; i++) {
 						if (i > 0)
 							txt += ", ";
-						txt += DADDR(4 + i);
+						txt += DADDR(5 + i);
 					}
-					txt += ")";
+					txt += ") cache:" + itos(code[ip + 4]);
 
-					incr = 5 + argc;
+					incr = 6 + argc;
 
 				} break;
 				case GDFunction::OPCODE_CALL_BUILT_IN: {
@@ -827,6 +829,19 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 
 					incr = 3;
 				} break;
+				case GDFunction::OPCODE_JUMP_IF_NOT_COMPARE: {
+
+					txt += " jump-if-not ";
+					txt += DADDR(4);
+					txt += "=";
+					txt += DADDR(2);
+					txt += " " + Variant::get_operator_name(Variant::Operator(code[ip + 1])) + " ";
+					txt += DADDR(3);
+					txt += " to ";
+					txt += itos(code[ip + 5]);
+
+					incr = 6;
+				} break;
 				case GDFunction::OPCODE_JUMP_TO_DEF_ARGUMENT: {
 
 					txt += " jump-to-default-argument ";
@@ -851,6 +866,18 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					txt += " for-loop " + DADDR(4) + " in " + DADDR(2) + " counter " + DADDR(1) + " end " + itos(code[ip + 3]);
 					incr += 5;
 
+				} break;
+				case GDFunction::OPCODE_ITERATE_RANGE_BEGIN: {
+
+					txt += " for-init " + DADDR(5) + " in range " + DADDR(1) + " to " + DADDR(2) + " step " + DADDR(3) + " end " + itos(code[ip + 4]);
+					incr += 6;
+
+				} break;
+				case GDFunction::OPCODE_ITERATE_RANGE: {
+
+					txt += " for-loop " + DADDR(5) + " in range " + DADDR(1) + " to " + DADDR(2) + " step " + DADDR(3) + " end " + itos(code[ip + 4]);
+					incr += 6;
+
 				} break;
 				case GDFunction::OPCODE_LINE: {
 
@@ -881,15 +908,325 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 				ERR_BREAK(incr == 0);
 			}
 
-			ip += incr;
-			if (txt != "")
+			if (r_opcodes)
+				(*r_opcodes)[func.get_name()].insert(code[ip]);
+			else if (txt != "")
 				print_line(txt);
+			ip += incr;
+		}
+	}
+}
+
+// runs the fused range loops and compare-and-jumps, checking both their results and that the compiler emitted them
+static const char *_runtime_script =
+	"extends Reference\n"
+	"\n"
+	"static func range_n():\n"
+	"\tvar a = []\n"
+	"\tfor i in range(5):\n"
+	"\t\ta.append(i)\n"
+	"\treturn a\n"
+	"\n"
+	"static func range_a_b():\n"
+	"\tvar a = []\n"
+	"\tfor i in range(2, 6):\n"
+	"\t\ta.append(i)\n"
+	"\treturn a\n"
+	"\n"
+	"static func range_a_b_step():\n"
+	"\tvar a = []\n"
+	"\tfor i in range(1, 10, 4):\n"
+	"\t\ta.append(i)\n"
+	"\treturn a\n"
+	"\n"
+	"static func range_a_b_negative_step():\n"
+	"\tvar a = []\n"
+	"\tvar k = 3\n"
+	"\tfor i in range(10, 0, -k):\n"
+	"\t\ta.append(i)\n"
+	"\treturn a\n"
+	"\n"
+	"static func range_empty():\n"
+	"\tvar count = 0\n"
+	"\tfor i in range(0):\n"
+	"\t\tcount += 1\n"
+	"\tfor i in range(-3):\n"
+	"\t\tcount += 1\n"
+	"\tfor i in range(5, 5):\n"
+	"\t\tcount += 1\n"
+	"\tfor i in range(5, 2):\n"
+	"\t\tcount += 1\n"
+	"\tfor i in range(2, 5, -1):\n"
+	"\t\tcount += 1\n"
+	"\treturn count\n"
+	"\n"
+	"static func range_matches_array():\n"
+	"\t# the same ranges iterated through the array range() builds\n"
+	"\tvar fused = []\n"
+	"\tvar generic = []\n"
+	"\tvar args = [ [7], [-2, 3], [3, -8, -2], [0, 10, 3], [4, 4, 1] ]\n"
+	"\tfor a in args:\n"
+	"\t\tvar r\n"
+	"\t\tif a.size() == 1:\n"
+	"\t\t\tfor i in range(a[0]):\n"
+	"\t\t\t\tfused.append(i)\n"
+	"\t\t\tr = range(a[0])\n"
+	"\t\telif a.size() == 2:\n"
+	"\t\t\tfor i in range(a[0], a[1]):\n"
+	"\t\t\t\tfused.append(i)\n"
+	"\t\t\tr = range(a[0], a[1])\n"
+	"\t\telse:\n"
+	"\t\t\tfor i in range(a[0], a[1], a[2]):\n"
+	"\t\t\t\tfused.append(i)\n"
+	"\t\t\tr = range(a[0], a[1], a[2])\n"
+	"\t\tfor i in r:\n"
+	"\t\t\tgeneric.append(i)\n"
+	"\treturn str(fused) == str(generic)\n"
+	"\n"
+	"static func range_float_args():\n"
+	"\t# truncated to int, like range() does when it builds the array\n"
+	"\tvar a = []\n"
+	"\tfor i in range(2.7):\n"
+	"\t\ta.append(i)\n"
+	"\tfor i in range(0.5, 3.9, 1.5):\n"
+	"\t\ta.append(i)\n"
+	"\treturn a\n"
+	"\n"
+	"static func range_string_arg():\n"
+	"\tfor i in range(\"5\"):\n"
+	"\t\tpass\n"
+	"\treturn \"no error\"\n"
+	"\n"
+	"static func range_null_arg():\n"
+	"\tvar n\n"
+	"\tfor i in range(0, n):\n"
+	"\t\tpass\n"
+	"\treturn \"no error\"\n"
+	"\n"
+	"static func range_zero_step():\n"
+	"\tfor i in range(0, 5, 0):\n"
+	"\t\tpass\n"
+	"\treturn \"no error\"\n"
+	"\n"
+	"static func range_loop_var_modified():\n"
+	"\tvar a = []\n"
+	"\tfor i in range(5):\n"
+	"\t\ti += 10\n"
+	"\t\ta.append(i)\n"
+	"\treturn a\n"
+	"\n"
+	"static func range_end_evaluated_once():\n"
+	"\tvar n = 5\n"
+	"\tvar count = 0\n"
+	"\tfor i in range(n):\n"
+	"\t\tn -= 1\n"
+	"\t\tcount += 1\n"
+	"\treturn count\n"
+	"\n"
+	"static func range_break_continue():\n"
+	"\tvar a = []\n"
+	"\tfor i in range(10):\n"
+	"\t\tif i % 2 == 1:\n"
+	"\t\t\tcontinue\n"
+	"\t\tif i > 6:\n"
+	"\t\t\tbreak\n"
+	"\t\ta.append(i)\n"
+	"\treturn a\n"
+	"\n"
+	"static func range_nested():\n"
+	"\tvar a = []\n"
+	"\tfor i in range(4):\n"
+	"\t\tfor j in range(i, 0, -1):\n"
+	"\t\t\ta.append(i * 10 + j)\n"
+	"\treturn a\n"
+	"\n"
+	"static func compare_int():\n"
+	"\tvar a = 1\n"
+	"\tvar b = 2\n"
+	"\tvar s = \"\"\n"
+	"\tif a < b:\n"
+	"\t\ts += \"lt \"\n"
+	"\tif a > b:\n"
+	"\t\ts += \"gt \"\n"
+	"\tif a <= 1:\n"
+	"\t\ts += \"le \"\n"
+	"\tif b >= 3:\n"
+	"\t\ts += \"ge \"\n"
+	"\tif a == 1:\n"
+	"\t\ts += \"eq \"\n"
+	"\tif a != 1:\n"
+	"\t\ts += \"ne \"\n"
+	"\tvar i = 0\n"
+	"\twhile i < 10:\n"
+	"\t\ti += 3\n"
+	"\treturn s + str(i)\n"
+	"\n"
+	"static func compare_real():\n"
+	"\tvar a = 1.5\n"
+	"\tvar b = 2.5\n"
+	"\tvar s = \"\"\n"
+	"\tif a < b:\n"
+	"\t\ts += \"lt \"\n"
+	"\tif a >= b:\n"
+	"\t\ts += \"ge \"\n"
+	"\tif a == 1.5:\n"
+	"\t\ts += \"eq \"\n"
+	"\tif b != 2.5:\n"
+	"\t\ts += \"ne \"\n"
+	"\tvar x = 0.0\n"
+	"\twhile x < 1.0:\n"
+	"\t\tx += 0.25\n"
+	"\treturn s + str(x)\n"
+	"\n"
+	"static func compare_mixed():\n"
+	"\tvar i = 2\n"
+	"\tvar r = 2.0\n"
+	"\tvar s = \"\"\n"
+	"\tif i == r:\n"
+	"\t\ts += \"eq \"\n"
+	"\tif i < 2.5:\n"
+	"\t\ts += \"lt \"\n"
+	"\tif 3 > r:\n"
+	"\t\ts += \"gt \"\n"
+	"\tif i != r:\n"
+	"\t\ts += \"ne \"\n"
+	"\treturn s\n"
+	"\n"
+	"static func compare_non_numeric():\n"
+	"\t# operands are variables, constant operands would be folded by the parser\n"
+	"\tvar x = \"abc\"\n"
+	"\tvar y = \"abd\"\n"
+	"\tvar v = Vector2(1, 2)\n"
+	"\tvar w = Vector2(2, 1)\n"
+	"\tvar n\n"
+	"\tvar s = \"\"\n"
+	"\tif x < y:\n"
+	"\t\ts += \"str_lt \"\n"
+	"\tif x == \"abc\":\n"
+	"\t\ts += \"str_eq \"\n"
+	"\tif v == Vector2(1, 2):\n"
+	"\t\ts += \"vec_eq \"\n"
+	"\tif v != w:\n"
+	"\t\ts += \"vec_ne \"\n"
+	"\tif n == null:\n"
+	"\t\ts += \"nil_eq \"\n"
+	"\treturn s\n"
+	"\n"
+	"static func compare_invalid_operands():\n"
+	"\tvar x = \"a\"\n"
+	"\tvar one = 1\n"
+	"\tif x < one:\n"
+	"\t\treturn \"taken\"\n"
+	"\treturn \"not taken\"\n"
+	"\n"
+	"static func compare_and_ternary():\n"
+	"\tvar a = 1\n"
+	"\tvar b = 2\n"
+	"\tvar s = \"\"\n"
+	"\tif a < b and b < 3:\n"
+	"\t\ts += \"and \"\n"
+	"\tif a < b and b > 3:\n"
+	"\t\ts += \"and_false \"\n"
+	"\tif a > b or b == 2:\n"
+	"\t\ts += \"or \"\n"
+	"\ts += \"yes \" if a < b else \"no \"\n"
+	"\ts += \"yes \" if a > b else \"no \"\n"
+	"\tvar lt = a < b\n"
+	"\tif lt:\n"
+	"\t\ts += \"stored \"\n"
+	"\tif (a < b) == (b > a):\n"
+	"\t\ts += \"nested \"\n"
+	"\treturn s\n";
+
+struct RuntimeCheck {
+
+	const char *function;
+	const char *expected; // NULL when the call must stop with a runtime error
+	int opcode; // fused opcode the function must be compiled with, or -1
+};
+
+static const RuntimeCheck _runtime_checks[] = {
+	{ "range_n", "[0, 1, 2, 3, 4]", GDFunction::OPCODE_ITERATE_RANGE_BEGIN },
+	{ "range_a_b", "[2, 3, 4, 5]", GDFunction::OPCODE_ITERATE_RANGE_BEGIN },
+	{ "range_a_b_step", "[1, 5, 9]", GDFunction::OPCODE_ITERATE_RANGE_BEGIN },
+	{ "range_a_b_negative_step", "[10, 7, 4, 1]", GDFunction::OPCODE_ITERATE_RANGE_BEGIN },
+	{ "range_empty", "0", GDFunction::OPCODE_ITERATE_RANGE_BEGIN },
+	{ "range_matches_array", "True", GDFunction::OPCODE_ITERATE_RANGE_BEGIN },
+	{ "range_float_args", "[0, 1, 0, 1, 2]", GDFunction::OPCODE_ITERATE_RANGE_BEGIN },
+	{ "range_string_arg", NULL, GDFunction::OPCODE_ITERATE_RANGE_BEGIN },
+	{ "range_null_arg", NULL, GDFunction::OPCODE_ITERATE_RANGE_BEGIN },
+	{ "range_zero_step", NULL, GDFunction::OPCODE_ITERATE_RANGE_BEGIN },
+	{ "range_loop_var_modified", "[10, 11, 12, 13, 14]", GDFunction::OPCODE_ITERATE_RANGE_BEGIN },
+	{ "range_end_evaluated_once", "5", GDFunction::OPCODE_ITERATE_RANGE_BEGIN },
+	{ "range_break_continue", "[0, 2, 4, 6]", GDFunction::OPCODE_ITERATE_RANGE_BEGIN },
+	{ "range_nested", "[11, 22, 21, 33, 32, 31]", GDFunction::OPCODE_ITERATE_RANGE_BEGIN },
+	{ "compare_int", "lt le eq 12", GDFunction::OPCODE_JUMP_IF_NOT_COMPARE },
+	{ "compare_real", "lt eq 1", GDFunction::OPCODE_JUMP_IF_NOT_COMPARE },
+	{ "compare_mixed", "eq lt gt ", GDFunction::OPCODE_JUMP_IF_NOT_COMPARE },
+	{ "compare_non_numeric", "str_lt str_eq vec_eq vec_ne nil_eq ", GDFunction::OPCODE_JUMP_IF_NOT_COMPARE },
+	{ "compare_invalid_operands", NULL, GDFunction::OPCODE_JUMP_IF_NOT_COMPARE },
+	{ "compare_and_ternary", "and or yes no stored nested ", GDFunction::OPCODE_JUMP_IF_NOT_COMPARE },
+	{ NULL, NULL, -1 }
+};
+
+static MainLoop *_test_runtime() {
+
+	Ref<GDScript> script = memnew(GDScript);
+	script->set_source_code(_runtime_script);
+	if (script->reload() != OK) {
+
+		print_line("FAILED: the runtime test script doesn't compile");
+		return NULL;
+	}
+
+	Map<StringName, Set<int> > opcodes;
+	_disassemble_class(script, Vector<String>(), &opcodes);
+
+	print_line("(the cases expecting a runtime error print it)");
+
+	int passed = 0;
+	int count = 0;
+
+	for (const RuntimeCheck *c = _runtime_checks; c->function; c++) {
+
+		count++;
+		String error;
+
+		if (c->opcode >= 0 && !opcodes[c->function].has(c->opcode))
+			error = "not compiled to the fused opcode";
+
+		// static functions are called on the script itself
+		Variant::CallError ce;
+		Variant ret = static_cast<Object *>(script.ptr())->call(c->function, NULL, 0, ce);
+
+		if (ce.error != Variant::CallError::CALL_OK) {
+			error = "call failed";
+		} else if (!c->expected) {
+			// a runtime error leaves the function returning nil
+			if (ret.get_type() != Variant::NIL)
+				error = "expected a runtime error, got '" + String(ret) + "'";
+		} else if (ret.get_type() == Variant::NIL || String(ret) != c->expected) {
+			error = "got '" + String(ret) + "', expected '" + c->expected + "'";
+		}
+
+		if (error == "") {
+			passed++;
+			print_line("PASS: " + String(c->function));
+		} else {
+			print_line("FAILED: " + String(c->function) + ": " + error);
 		}
 	}
+
+	print_line("Passed " + itos(passed) + " of " + itos(count) + " tests");
+
+	return NULL;
 }
 
 MainLoop *test(TestType p_test) {
 
+	if (p_test == TEST_RUNTIME)
+		return _test_runtime();
+
 	List<String> cmdlargs = OS::get_singleton()->get_cmdline_args();
 
 	if (cmdlargs.empty()) {
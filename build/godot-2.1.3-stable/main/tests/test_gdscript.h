@@ -38,6 +38,7 @@ enum TestType {
 	TEST_PARSER,
 	TEST_COMPILER,
 	TEST_BYTECODE,
+	TEST_RUNTIME,
 };
 
 MainLoop *test(TestType p_type);
@@ -0,0 +1,409 @@
+/*************************************************************************/
+/*  test_json.cpp                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2017 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+#include "test_json.h"
+
+#include "core/bind/core_bind.h"
+#include "io/json.h"
+#include "os/dir_access.h"
+#include "os/file_access.h"
+#include "os/os.h"
+
+namespace TestJSON {
+
+#define BENCH_ITERATIONS 100
+#define TEST_PATH "user://test_json.json"
+// JSON_STREAM_CHUNK_SIZE, parse_file reads the document in chunks this big
+#define TEST_CHUNK_SIZE 16384
+
+static bool _store(const CharString &p_doc) {
+
+	FileAccess *f = FileAccess::open(TEST_PATH, FileAccess::WRITE);
+	if (!f)
+		return false;
+	f->store_buffer((const uint8_t *)p_doc.get_data(), p_doc.length());
+	memdelete(f);
+	return true;
+}
+
+// parses from memory and streamed from a file, both have to agree
+static Error _parse(const CharString &p_doc, Dictionary &r_dict, String &r_err_str, int &r_err_line) {
+
+	Dictionary mem_dict(true);
+	String mem_err_str;
+	int mem_err_line = 0;
+	Error mem_err = JSON::parse_utf8((const uint8_t *)p_doc.get_data(), p_doc.length(), mem_dict, mem_err_str, mem_err_line);
+
+	if (!_store(p_doc)) {
+		r_err_str = "Can't write " TEST_PATH;
+		r_err_line = -1;
+		return ERR_CANT_CREATE;
+	}
+
+	r_dict = Dictionary(true);
+	r_err_line = 0;
+	Error err = JSON::parse_file(TEST_PATH, r_dict, r_err_str, r_err_line);
+
+	if (err != mem_err || r_err_line != mem_err_line || r_err_str != mem_err_str || JSON::print(r_dict) != JSON::print(mem_dict)) {
+		OS::get_singleton()->print("	parse_utf8 and parse_file disagree: '%ls' at line %i vs '%ls' at line %i\n", mem_err_str.c_str(), mem_err_line, r_err_str.c_str(), r_err_line);
+		return ERR_BUG;
+	}
+
+	return err;
+}
+
+// raw bytes, String would take them as latin-1
+static CharString _bytes(const char *p_str) {
+
+	CharString bytes;
+	bytes.resize(strlen(p_str) + 1);
+	memcpy(bytes.ptr(), p_str, bytes.size());
+	return bytes;
+}
+
+static String _chars(const CharType *p_chars, int p_len) {
+
+	String str;
+	for (int i = 0; i < p_len; i++) {
+		str += p_chars[i];
+	}
+	return str;
+}
+
+static bool _test_chunk_boundary() {
+
+	OS::get_singleton()->print("\n*** Chunk boundary ***\n");
+
+	// plain text, escapes, \uXXXX, a surrogate pair and raw UTF-8, then a number and an identifier
+	const char *tail = "\"value\":\"plain \\\" \\\\ \\n \\u00e9\\u4E2D \\ud83d\\ude00 \xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80 end\",\"number\":-12.5e1,\"flag\":true}";
+	String expected = String::utf8("plain \" \\ \n \xC3\xA9\xE4\xB8\xAD \xF0\x9F\x98\x80 \xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80 end");
+	const char *head = "{\"pad\":\"";
+	int head_len = strlen(head);
+	int tail_len = strlen(tail);
+
+	bool pass = true;
+
+	// slide the chunk boundary over every byte of the tail
+	for (int split = 0; split < tail_len; split++) {
+
+		int pad_len = TEST_CHUNK_SIZE - head_len - 2 - split;
+
+		CharString doc;
+		doc.resize(head_len + pad_len + 2 + tail_len + 1);
+		char *dst = doc.ptr();
+		memcpy(dst, head, head_len);
+		memset(&dst[head_len], 'x', pad_len);
+		memcpy(&dst[head_len + pad_len], "\",", 2);
+		memcpy(&dst[head_len + pad_len + 2], tail, tail_len + 1);
+
+		Dictionary dict;
+		String err_str;
+		int err_line;
+		Error err = _parse(doc, dict, err_str, err_line);
+
+		bool ok = err == OK && String(dict["value"]) == expected && double(dict["number"]) == -125.0 && dict["flag"].get_type() == Variant::BOOL && bool(dict["flag"]) && String(dict["pad"]).length() == pad_len;
+		if (!ok) {
+			OS::get_singleton()->print("\tsplit before '%c' (tail byte %i): '%ls'\n", tail[split], split, err_str.c_str());
+			pass = false;
+		}
+	}
+
+	OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+	return pass;
+}
+
+static bool _test_surrogates() {
+
+	OS::get_singleton()->print("\n*** Surrogate pairs ***\n");
+
+	static const CharType lead[1] = { 0xD83D };
+	static const CharType lead_x[2] = { 0xD83D, 'x' };
+	static const CharType trail_lead[2] = { 0xDE00, 0xD83D };
+
+	struct {
+		const char *json;
+		String expected;
+	} cases[] = {
+		{ "\\ud83d\\ude00", String::utf8("\xF0\x9F\x98\x80") },
+		{ "\\uD834\\uDD1E\\uDBFF\\uDFFF", String::utf8("\xF0\x9D\x84\x9E\xF4\x8F\xBF\xBF") },
+		{ "a\\ud83d\\ude00b\\u00e9", String::utf8("a\xF0\x9F\x98\x80" "b\xC3\xA9") },
+		// unpaired halves are kept as they are, like JSON::parse does
+		{ "\\ud83d", _chars(lead, 1) },
+		{ "\\ud83dx", _chars(lead_x, 2) },
+		{ "\\ude00\\ud83d", _chars(trail_lead, 2) },
+		{ NULL, String() }
+	};
+
+	bool pass = true;
+
+	for (int i = 0; cases[i].json; i++) {
+
+		// the same string as a value and as a key
+		String json = String("{\"value\":\"") + cases[i].json + "\",\"" + cases[i].json + "\":1}";
+
+		Dictionary dict;
+		String err_str;
+		int err_line;
+		Error err = _parse(json.utf8(), dict, err_str, err_line);
+
+		bool ok = err == OK && String(dict["value"]) == cases[i].expected && dict.has(cases[i].expected);
+		if (!ok) {
+			OS::get_singleton()->print("\t%s: '%ls'\n", cases[i].json, err_str.c_str());
+			pass = false;
+		}
+	}
+
+	OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+	return pass;
+}
+
+static bool _test_bom() {
+
+	OS::get_singleton()->print("\n*** Byte order mark ***\n");
+
+	bool pass = true;
+
+	const char *docs[] = {
+		"\xEF\xBB\xBF{\"a\":1,\"b\":\"\xC3\xA9\"}",
+		"\xEF\xBB\xBF\n  {\"a\":1,\"b\":\"\xC3\xA9\"}",
+		NULL
+	};
+
+	for (int i = 0; docs[i]; i++) {
+
+		Dictionary dict;
+		String err_str;
+		int err_line;
+		Error err = _parse(_bytes(docs[i]), dict, err_str, err_line);
+
+		if (err != OK || int(dict["a"]) != 1 || String(dict["b"]) != String::utf8("\xC3\xA9")) {
+			OS::get_singleton()->print("\tdocument %i: '%ls'\n", i, err_str.c_str());
+			pass = false;
+		}
+	}
+
+	// only at the very start, anywhere else it is garbage
+	Dictionary dict;
+	String err_str;
+	int err_line;
+	if (_parse(_bytes("{\"a\":\xEF\xBB\xBF" "1}"), dict, err_str, err_line) != ERR_PARSE_ERROR) {
+		OS::get_singleton()->print("\ta byte order mark inside the document was accepted\n");
+		pass = false;
+	}
+
+	OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+	return pass;
+}
+
+static bool _test_errors() {
+
+	OS::get_singleton()->print("\n*** Truncated and invalid input ***\n");
+
+	// lines count from 0, like JSON::parse
+	struct {
+		const char *json;
+		int line;
+	} cases[] = {
+		{ "", 0 },
+		{ "[1, 2]", 0 },
+		{ "{\n\"a\": 1,\n\"b\": [1, 2", 2 },
+		{ "{\n\"a\": 1,\n\"b\": {\"c\": 1", 2 },
+		{ "{\n\"a\":\n\n\n", 4 },
+		{ "{\n\"a\": \"abc", 1 },
+		{ "{\n\"a\": \"abc\\", 1 },
+		{ "{\n\"a\": \"\\u12", 1 },
+		{ "{\n\"a\": \"line\nbreak", 2 },
+		{ "{\n\"a\": \"\\uZZZZ\"}", 1 },
+		{ "{\n\"a\": 1\n\"b\": 2}", 2 },
+		{ "{\n\"a\": 1,\n\n\"b\": tru }", 3 },
+		{ "{\n\"a\" 1}", 1 },
+		{ "{\n1: 2}", 1 },
+		{ "{\n\"a\": [1,,2]}", 1 },
+		{ "{\n\"a\": #}", 1 },
+		{ NULL, 0 }
+	};
+
+	bool pass = true;
+
+	for (int i = 0; cases[i].json; i++) {
+
+		Dictionary dict;
+		String err_str;
+		int err_line;
+		Error err = _parse(_bytes(cases[i].json), dict, err_str, err_line);
+
+		bool ok = err == ERR_PARSE_ERROR && err_line == cases[i].line && err_str != "";
+		OS::get_singleton()->print("\tcase %i: '%ls' at line %i%s\n", i, err_str.c_str(), err_line, ok ? "" : " FAILED");
+		pass = pass && ok;
+	}
+
+	OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+	return pass;
+}
+
+static void _find_files(const String &p_dir, List<String> *r_files) {
+
+	DirAccess *da = DirAccess::open(p_dir);
+	if (!da)
+		return;
+
+	da->list_dir_begin();
+	String entry;
+	while ((entry = da->get_next()) != "") {
+
+		if (entry.begins_with("."))
+			continue;
+
+		String path = p_dir.plus_file(entry);
+		if (da->current_is_dir())
+			_find_files(path, r_files);
+		else if (entry.extension() == "lesson" || entry.extension() == "json")
+			r_files->push_back(path);
+	}
+	da->list_dir_end();
+	memdelete(da);
+}
+
+static bool _bench_file(const String &p_path, uint64_t &r_old_usec, uint64_t &r_new_usec) {
+
+	Dictionary old_dict;
+	Dictionary new_dict;
+	String err_str;
+	int err_line;
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+
+		// what the lesson scripts did: File.get_as_text() then Dictionary.parse_json()
+		_File f;
+		f.open(p_path, _File::READ);
+		String text = f.get_as_text();
+		f.close();
+
+		old_dict = Dictionary(true);
+		if (JSON::parse(text, old_dict, err_str, err_line) != OK) {
+			OS::get_singleton()->print("\tJSON::parse failed: %ls at line %i\n", err_str.c_str(), err_line);
+			return false;
+		}
+	}
+	r_old_usec += OS::get_singleton()->get_ticks_usec() - from;
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+
+		new_dict = Dictionary(true);
+		if (JSON::parse_file(p_path, new_dict, err_str, err_line) != OK) {
+			OS::get_singleton()->print("\tJSON::parse_file failed: %ls at line %i\n", err_str.c_str(), err_line);
+			return false;
+		}
+	}
+	r_new_usec += OS::get_singleton()->get_ticks_usec() - from;
+
+	return JSON::print(old_dict) == JSON::print(new_dict);
+}
+
+static void _bench(const String &p_path) {
+
+	List<String> cmdlargs = OS::get_singleton()->get_cmdline_args();
+
+	// a directory (searched for .lesson and .json files) or a single file
+	String path = p_path;
+	if (!cmdlargs.empty() && cmdlargs.back()->get() != "json")
+		path = cmdlargs.back()->get();
+
+	List<String> files;
+	if (FileAccess::exists(path))
+		files.push_back(path);
+	else
+		_find_files(path, &files);
+
+	if (files.empty()) {
+		OS::get_singleton()->print("\nNo JSON files found in: %ls\n", path.c_str());
+		return;
+	}
+
+	OS::get_singleton()->print("\n*** Benchmark ***\n");
+
+	int passed = 0;
+	uint64_t old_usec = 0;
+	uint64_t new_usec = 0;
+
+	for (List<String>::Element *E = files.front(); E; E = E->next()) {
+
+		uint64_t file_old = 0;
+		uint64_t file_new = 0;
+		bool pass = _bench_file(E->get(), file_old, file_new);
+		if (pass)
+			passed++;
+
+		OS::get_singleton()->print("%ls\n", E->get().c_str());
+		OS::get_singleton()->print("\tget_as_text + parse: %i usec, parse_file: %i usec\n", int(file_old / BENCH_ITERATIONS), int(file_new / BENCH_ITERATIONS));
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		old_usec += file_old;
+		new_usec += file_new;
+	}
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i files\n", passed, files.size());
+	OS::get_singleton()->print("get_as_text + parse: %i usec, parse_file: %i usec (%i iterations)\n", int(old_usec), int(new_usec), BENCH_ITERATIONS);
+}
+
+MainLoop *test() {
+
+	int passed = 0;
+	int count = 0;
+
+	count++;
+	if (_test_chunk_boundary())
+		passed++;
+	count++;
+	if (_test_surrogates())
+		passed++;
+	count++;
+	if (_test_bom())
+		passed++;
+	count++;
+	if (_test_errors())
+		passed++;
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	da->remove(TEST_PATH);
+	memdelete(da);
+
+	OS::get_singleton()->print("\nPassed %i of %i tests\n", passed, count);
+
+	_bench("courses/cet4");
+
+	return NULL;
+}
+}
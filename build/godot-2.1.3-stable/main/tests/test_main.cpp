@@ -31,12 +31,17 @@
 
 #ifdef DEBUG_ENABLED
 
+#include "test_bytebuf.h"
+#include "test_canvas_batch.h"
 #include "test_containers.h"
+#include "test_course_pack.h"
 #include "test_detailer.h"
+#include "test_dynamic_font.h"
 #include "test_gdscript.h"
 #include "test_gui.h"
 #include "test_image.h"
 #include "test_io.h"
+#include "test_json.h"
 #include "test_math.h"
 #include "test_misc.h"
 #include "test_particles.h"
@@ -44,14 +49,20 @@
 #include "test_physics_2d.h"
 #include "test_python.h"
 #include "test_render.h"
+#include "test_resource_loader.h"
 #include "test_shader_lang.h"
 #include "test_sound.h"
 #include "test_string.h"
+#include "test_string_name.h"
+#include "test_variant_call.h"
+#include "test_video.h"
+#include "test_yuv2rgb.h"
 
 const char **tests_get_names() {
 
 	static const char *test_names[] = {
 		"string",
+		"string_name",
 		"containers",
 		"math",
 		"render",
@@ -59,8 +70,17 @@ const char **tests_get_names() {
 		"multimesh",
 		"gui",
 		"io",
+		"json",
+		"variant_call",
 		"shaderlang",
 		"physics",
+		"video",
+		"dynamic_font",
+		"bytebuf",
+		"resource_loader",
+		"course_pack",
+		"canvas_batch",
+		"yuv2rgb",
 		NULL
 	};
 
@@ -74,6 +94,11 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestString::test();
 	}
 
+	if (p_test == "string_name") {
+
+		return TestStringName::test();
+	}
+
 	if (p_test == "containers") {
 
 		return TestContainers::test();
@@ -121,6 +146,16 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestIO::test();
 	}
 
+	if (p_test == "json") {
+
+		return TestJSON::test();
+	}
+
+	if (p_test == "variant_call") {
+
+		return TestVariantCall::test();
+	}
+
 	if (p_test == "particles") {
 
 		return TestParticles::test();
@@ -156,6 +191,46 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestGDScript::test(TestGDScript::TEST_BYTECODE);
 	}
 
+	if (p_test == "gd_runtime") {
+
+		return TestGDScript::test(TestGDScript::TEST_RUNTIME);
+	}
+
+	if (p_test == "dynamic_font") {
+
+		return TestDynamicFont::test();
+	}
+
+	if (p_test == "video") {
+
+		return TestVideo::test();
+	}
+
+	if (p_test == "resource_loader") {
+
+		return TestResourceLoader::test();
+	}
+
+	if (p_test == "course_pack") {
+
+		return TestCoursePack::test();
+	}
+
+	if (p_test == "canvas_batch") {
+
+		return TestCanvasBatch::test();
+	}
+
+	if (p_test == "yuv2rgb") {
+
+		return TestYUV2RGB::test();
+	}
+
+	if (p_test == "bytebuf") {
+
+		return TestByteBuf::test();
+	}
+
 	if (p_test == "image") {
 
 		return TestImage::test();
@@ -0,0 +1,169 @@
+/*************************************************************************/
+/*  test_resource_loader.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2017 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "test_resource_loader.h"
+
+#include "image.h"
+#include "io/resource_loader.h"
+#include "os/dir_access.h"
+#include "os/file_access.h"
+#include "os/os.h"
+#include "path_remap.h"
+
+namespace TestResourceLoader {
+
+#define TEST_IMAGE_PATH "user://test_resource_loader.png"
+#define TEST_REMAP_PATH "user://test_resource_loader_remap.png"
+#define TEST_SCRIPT_PATH "user://test_resource_loader.gd"
+#define TEST_PLAIN_PATH "user://test_resource_loader_plain.png"
+#define TEST_SCRIPT_COPY_PATH "user://test_resource_loader_copy.gd"
+
+static bool _write_files() {
+
+	Image image(8, 8, false, Image::FORMAT_RGBA);
+	for (int y = 0; y < 8; y++) {
+		for (int x = 0; x < 8; x++) {
+			image.put_pixel(x, y, Color(x / 8.0, y / 8.0, 0.5, 1.0));
+		}
+	}
+
+	if (image.save_png(TEST_IMAGE_PATH) != OK || image.save_png(TEST_PLAIN_PATH) != OK) {
+		OS::get_singleton()->print("\tcan't write the test images\n");
+		return false;
+	}
+
+	const char *scripts[2] = { TEST_SCRIPT_PATH, TEST_SCRIPT_COPY_PATH };
+	for (int i = 0; i < 2; i++) {
+
+		FileAccess *f = FileAccess::open(scripts[i], FileAccess::WRITE);
+		if (!f) {
+			OS::get_singleton()->print("\tcan't write the test scripts\n");
+			return false;
+		}
+		f->store_string("extends Reference\n\nfunc get_value():\n\treturn 1\n");
+		memdelete(f);
+	}
+
+	return true;
+}
+
+static void _remove_files() {
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	da->remove(TEST_IMAGE_PATH);
+	da->remove(TEST_PLAIN_PATH);
+	da->remove(TEST_SCRIPT_PATH);
+	da->remove(TEST_SCRIPT_COPY_PATH);
+	memdelete(da);
+}
+
+static bool _test_threaded_then_plain(const String &p_path) {
+
+	OS::get_singleton()->print("\n*** Threaded load, then plain load: %ls ***\n", p_path.c_str());
+
+	Error err = ResourceLoader::load_threaded_request(p_path);
+	RES threaded = err == OK ? ResourceLoader::load_threaded_get(p_path, &err) : RES();
+	if (threaded.is_null()) {
+		OS::get_singleton()->print("\tthreaded load failed, error %i\n\tFAILED\n", err);
+		return false;
+	}
+
+	// the threaded result must be cached like a plain load() would cache it
+	RES plain = ResourceLoader::load(p_path);
+	bool pass = plain == threaded && threaded->get_path() == p_path;
+
+	OS::get_singleton()->print("\tpath: %ls, same instance: %s\n", threaded->get_path().c_str(), plain == threaded ? "yes" : "no");
+	OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+	return pass;
+}
+
+static bool _test_plain_during_threaded(const String &p_path) {
+
+	OS::get_singleton()->print("\n*** Plain load while a threaded load runs: %ls ***\n", p_path.c_str());
+
+	// the plain load waits for the requested one instead of loading the file again
+	Error err = ResourceLoader::load_threaded_request(p_path);
+	RES plain = err == OK ? ResourceLoader::load(p_path) : RES();
+	RES threaded = err == OK ? ResourceLoader::load_threaded_get(p_path, &err) : RES();
+	bool pass = plain.is_valid() && plain == threaded && plain->get_path() == p_path;
+
+	OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+	return pass;
+}
+
+static bool _test_plain_while_threaded() {
+
+	OS::get_singleton()->print("\n*** Plain loads while the loader threads run ***\n");
+
+	// plain loads of paths that weren't requested don't go through the loader threads
+	RES first = ResourceLoader::load(TEST_PLAIN_PATH);
+	RES second = ResourceLoader::load(TEST_PLAIN_PATH);
+	bool pass = first.is_valid() && first == second && first->get_path() == TEST_PLAIN_PATH;
+
+	OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+	return pass;
+}
+
+MainLoop *test() {
+
+	int passed = 0;
+	int count = 0;
+
+	if (!_write_files()) {
+		_remove_files();
+		OS::get_singleton()->print("\nPassed %i of %i tests\n", passed, count);
+		return NULL;
+	}
+
+	PathRemap::get_singleton()->add_remap(TEST_REMAP_PATH, TEST_IMAGE_PATH);
+
+	count++;
+	if (_test_threaded_then_plain(TEST_IMAGE_PATH))
+		passed++;
+	count++;
+	if (_test_threaded_then_plain(TEST_REMAP_PATH))
+		passed++;
+	count++;
+	if (_test_threaded_then_plain(TEST_SCRIPT_PATH))
+		passed++;
+	count++;
+	if (_test_plain_during_threaded(TEST_SCRIPT_COPY_PATH))
+		passed++;
+	count++;
+	if (_test_plain_while_threaded())
+		passed++;
+
+	PathRemap::get_singleton()->erase_remap(TEST_REMAP_PATH);
+	_remove_files();
+
+	OS::get_singleton()->print("\nPassed %i of %i tests\n", passed, count);
+
+	return NULL;
+}
+}
@@ -0,0 +1,316 @@
+/*************************************************************************/
+/*  test_string_name.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2017 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+#include "test_string_name.h"
+
+#include "os/mutex.h"
+#include "os/os.h"
+#include "os/thread.h"
+#include "string_db.h"
+
+namespace TestStringName {
+
+#define GROWTH_NAMES 50000
+#define STRESS_THREADS 8
+#define STRESS_POOL 4000
+#define STRESS_ITERATIONS 200000
+// most iterations retire a node, a scheme that waits for a quiet moment piles up far more than this
+#define STRESS_MAX_RETIRED 20000
+#define BENCH_NAMES 5000
+#define BENCH_LOOKUPS 1000000
+
+static double _per_sec(int p_count, uint64_t p_usec) {
+
+	return p_usec ? double(p_count) * 1000000.0 / double(p_usec) : 0.0;
+}
+
+static uint32_t _rand(uint32_t &r_seed) {
+
+	r_seed = r_seed * 1103515245 + 12345;
+	return r_seed >> 8;
+}
+
+static void _print_stats() {
+
+	StringName::Stats stats;
+	StringName::get_stats(&stats);
+	OS::get_singleton()->print("\tnames: %i, buckets: %i, load factor: %.2f, longest chain: %i, resizes: %i, retired: %i\n", stats.names, stats.buckets, stats.load_factor, stats.longest_chain, stats.resizes, stats.retired);
+	if (stats.lookups)
+		OS::get_singleton()->print("\tlookups: %u (%u locked), %.0f lookups/s\n", stats.lookups, stats.locked_lookups, stats.lookups_per_second);
+}
+
+static bool _test_growth() {
+
+	OS::get_singleton()->print("\n*** Growth ***\n");
+
+	StringName::Stats stats;
+	StringName::get_stats(&stats);
+	int base_names = stats.names;
+	int base_buckets = stats.buckets;
+
+	Vector<String> strings;
+	Vector<StringName> names;
+	strings.resize(GROWTH_NAMES);
+	names.resize(GROWTH_NAMES);
+	for (int i = 0; i < GROWTH_NAMES; i++) {
+		strings[i] = "growth_" + itos(i);
+		names[i] = strings[i];
+	}
+
+	bool pass = true;
+	for (int i = 0; i < GROWTH_NAMES; i++) {
+		if (StringName::search(strings[i]) != names[i] || StringName(strings[i], strings[i].hash()) != names[i] || names[i] != strings[i]) {
+			OS::get_singleton()->print("\tlookup mismatch: %ls\n", strings[i].c_str());
+			pass = false;
+			break;
+		}
+	}
+
+	StringName::get_stats(&stats);
+	_print_stats();
+	if (stats.names != base_names + GROWTH_NAMES || stats.buckets <= base_buckets)
+		pass = false;
+
+	names.clear();
+	StringName::get_stats(&stats);
+	if (stats.names != base_names || StringName::search(strings[0]))
+		pass = false;
+
+	OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+	return pass;
+}
+
+struct StressData {
+
+	const Vector<String> *pool;
+	const Vector<StringName> *held;
+	uint32_t seed;
+	int failures;
+	int max_retired;
+};
+
+static void _stress_thread(void *p_ud) {
+
+	StressData *sd = (StressData *)p_ud;
+	const Vector<String> &pool = *sd->pool;
+	const Vector<StringName> &held = *sd->held;
+
+	for (int i = 0; i < STRESS_ITERATIONS; i++) {
+
+		int idx = _rand(sd->seed) % STRESS_POOL;
+		const String &str = pool[idx];
+
+		// names come and go all the time, the same string must always
+		// map to a single live entry
+		StringName name = str;
+		if (name != str)
+			sd->failures++;
+		if (StringName::search(str) != name)
+			sd->failures++;
+		if (StringName(str, str.hash()) != name)
+			sd->failures++;
+		if (idx < held.size() && held[idx] != name)
+			sd->failures++;
+
+		if ((i & 4095) == 0) {
+			// removals keep happening under steady lookups, what they retire must still get freed
+			StringName::Stats stats;
+			StringName::get_stats(&stats);
+			if (stats.retired > sd->max_retired)
+				sd->max_retired = stats.retired;
+		}
+
+		if ((i & 255) == 0) {
+			// unique names, so inserts and resizes run against the lookups
+			StringName unique = "stress_" + itos(sd->seed) + "_" + itos(i);
+			if (StringName::search(String(unique)) != unique)
+				sd->failures++;
+		}
+	}
+}
+
+static bool _test_stress() {
+
+	OS::get_singleton()->print("\n*** Stress, %i threads ***\n", STRESS_THREADS);
+
+	StringName::Stats stats;
+	StringName::get_stats(&stats);
+	int base_names = stats.names;
+
+	Vector<String> pool;
+	Vector<StringName> held;
+	pool.resize(STRESS_POOL);
+	for (int i = 0; i < STRESS_POOL; i++) {
+		pool[i] = "stress_pool_" + itos(i);
+	}
+	// a quarter stays referenced for the whole run, the rest is created and freed by the threads
+	held.resize(STRESS_POOL / 4);
+	for (int i = 0; i < held.size(); i++) {
+		held[i] = pool[i];
+	}
+
+	StressData data[STRESS_THREADS];
+	Thread *threads[STRESS_THREADS];
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < STRESS_THREADS; i++) {
+		data[i].pool = &pool;
+		data[i].held = &held;
+		data[i].seed = i + 1;
+		data[i].failures = 0;
+		data[i].max_retired = 0;
+		threads[i] = Thread::create(_stress_thread, &data[i]);
+		if (!threads[i]) {
+			// no thread support, run inline
+			_stress_thread(&data[i]);
+		}
+	}
+
+	int failures = 0;
+	int max_retired = 0;
+	for (int i = 0; i < STRESS_THREADS; i++) {
+		if (threads[i]) {
+			Thread::wait_to_finish(threads[i]);
+			memdelete(threads[i]);
+		}
+		failures += data[i].failures;
+		max_retired = MAX(max_retired, data[i].max_retired);
+	}
+	uint64_t usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	held.clear();
+	StringName::get_stats(&stats);
+	// with no lookups left running, the last removal frees everything retired
+	bool pass = failures == 0 && stats.names == base_names && stats.retired == 0 && max_retired < STRESS_MAX_RETIRED;
+
+	OS::get_singleton()->print("\t%i iterations in %.2f s, %i failures, %i names left over\n", STRESS_THREADS * STRESS_ITERATIONS, usec / 1000000.0, failures, stats.names - base_names);
+	OS::get_singleton()->print("\tretired: at most %i while running, %i after\n", max_retired, stats.retired);
+	OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+	return pass;
+}
+
+struct BenchData {
+
+	const Vector<String> *strings;
+	Mutex *mutex;
+	int lookups;
+	uint32_t seed;
+};
+
+static void _bench_thread(void *p_ud) {
+
+	BenchData *bd = (BenchData *)p_ud;
+	const Vector<String> &strings = *bd->strings;
+
+	for (int i = 0; i < bd->lookups; i++) {
+
+		const String &str = strings[_rand(bd->seed) % BENCH_NAMES];
+		if (bd->mutex) {
+			// what every lookup paid before, the whole table behind one lock
+			bd->mutex->lock();
+			StringName name = str;
+			bd->mutex->unlock();
+		} else {
+			StringName name = str;
+		}
+	}
+}
+
+static uint64_t _bench_lookups(const Vector<String> &p_strings, int p_threads, Mutex *p_mutex) {
+
+	BenchData data[STRESS_THREADS];
+	Thread *threads[STRESS_THREADS];
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_threads; i++) {
+		data[i].strings = &p_strings;
+		data[i].mutex = p_mutex;
+		data[i].lookups = BENCH_LOOKUPS / p_threads;
+		data[i].seed = i + 1;
+		threads[i] = Thread::create(_bench_thread, &data[i]);
+		if (!threads[i])
+			_bench_thread(&data[i]);
+	}
+	for (int i = 0; i < p_threads; i++) {
+		if (threads[i]) {
+			Thread::wait_to_finish(threads[i]);
+			memdelete(threads[i]);
+		}
+	}
+	return OS::get_singleton()->get_ticks_usec() - from;
+}
+
+static void _bench() {
+
+	OS::get_singleton()->print("\n*** Lookups of existing names, %i names, %i lookups ***\n", BENCH_NAMES, BENCH_LOOKUPS);
+
+	Vector<String> strings;
+	Vector<StringName> names;
+	strings.resize(BENCH_NAMES);
+	names.resize(BENCH_NAMES);
+	for (int i = 0; i < BENCH_NAMES; i++) {
+		strings[i] = "bench/name_" + itos(i);
+		names[i] = strings[i];
+	}
+
+	Mutex *mutex = Mutex::create();
+
+	for (int threads = 1; threads <= STRESS_THREADS; threads *= 2) {
+
+		uint64_t locked_usec = mutex ? _bench_lookups(strings, threads, mutex) : 0;
+
+		StringName::set_stats_enabled(true);
+		uint64_t usec = _bench_lookups(strings, threads, NULL);
+
+		OS::get_singleton()->print("%i thread(s): lock-free %.0f/s, serialized %.0f/s\n", threads, _per_sec(BENCH_LOOKUPS, usec), _per_sec(BENCH_LOOKUPS, locked_usec));
+		_print_stats();
+		StringName::set_stats_enabled(false);
+	}
+
+	if (mutex)
+		memdelete(mutex);
+}
+
+MainLoop *test() {
+
+	int passed = 0;
+	int count = 0;
+
+	count++;
+	if (_test_growth())
+		passed++;
+	count++;
+	if (_test_stress())
+		passed++;
+
+	_bench();
+
+	OS::get_singleton()->print("\nPassed %i of %i tests\n", passed, count);
+
+	return NULL;
+}
+}
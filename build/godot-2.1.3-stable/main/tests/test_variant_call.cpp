@@ -0,0 +1,153 @@
+/*************************************************************************/
+/*  test_variant_call.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2017 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+#include "test_variant_call.h"
+
+#include "map.h"
+#include "os/os.h"
+#include "variant.h"
+
+namespace TestVariantCall {
+
+#define BENCH_LOOKUPS 200000
+#define BENCH_CALLS 1000000
+
+static double _per_sec(int p_count, uint64_t p_usec) {
+
+	return p_usec ? double(p_count) * 1000000.0 / double(p_usec) : 0.0;
+}
+
+static void _bench_lookup(const String &p_name, const Variant &p_base) {
+
+	List<MethodInfo> method_list;
+	p_base.get_method_list(&method_list);
+
+	// the per type table Variant::call used before, a Map keyed by method name
+	Map<StringName, int> tree;
+	Vector<StringName> names;
+	for (List<MethodInfo>::Element *E = method_list.front(); E; E = E->next()) {
+		tree[E->get().name] = names.size();
+		names.push_back(E->get().name);
+	}
+
+	if (names.empty())
+		return;
+
+	int found = 0;
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < BENCH_LOOKUPS; i++) {
+		if (tree.find(names[i % names.size()]))
+			found++;
+	}
+	uint64_t tree_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < BENCH_LOOKUPS; i++) {
+		if (Variant::get_builtin_method(p_base.get_type(), names[i % names.size()]))
+			found++;
+	}
+	uint64_t hash_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	OS::get_singleton()->print("%ls (%i methods)\n", p_name.c_str(), names.size());
+	OS::get_singleton()->print("\tMap lookup: %.0f/s, hashed lookup: %.0f/s\n", _per_sec(BENCH_LOOKUPS, tree_usec), _per_sec(BENCH_LOOKUPS, hash_usec));
+	OS::get_singleton()->print("\t%s\n", found == BENCH_LOOKUPS * 2 ? "PASS" : "FAILED");
+}
+
+static bool _bench_call(const String &p_name, Variant p_base, const StringName &p_method, const Variant &p_arg = Variant()) {
+
+	const Variant *args[1] = { &p_arg };
+	int argc = p_arg.get_type() == Variant::NIL ? 0 : 1;
+	Variant ret;
+	Variant::CallError err;
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < BENCH_CALLS; i++) {
+		p_base.call_ptr(p_method, args, argc, &ret, err);
+	}
+	uint64_t name_usec = OS::get_singleton()->get_ticks_usec() - from;
+	Variant name_ret = ret;
+
+	// what a GDScript call site does once its inline cache is filled
+	const Variant::BuiltInMethod *method = Variant::get_builtin_method(p_base.get_type(), p_method);
+	if (!method) {
+		OS::get_singleton()->print("%ls: method not found\n", p_name.c_str());
+		return false;
+	}
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < BENCH_CALLS; i++) {
+		p_base.call_builtin(method, args, argc, &ret, err);
+	}
+	uint64_t cached_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	bool pass = err.error == Variant::CallError::CALL_OK && ret == name_ret;
+
+	OS::get_singleton()->print("%ls\n", p_name.c_str());
+	OS::get_singleton()->print("\tcall by name: %.0f calls/s, cached call: %.0f calls/s\n", _per_sec(BENCH_CALLS, name_usec), _per_sec(BENCH_CALLS, cached_usec));
+	OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+	return pass;
+}
+
+MainLoop *test() {
+
+	Dictionary dict;
+	Array array;
+	for (int i = 0; i < 64; i++) {
+		dict["key" + itos(i)] = i;
+		array.push_back(i);
+	}
+	String str = "The quick brown fox jumps over the lazy dog";
+
+	OS::get_singleton()->print("\n*** Method lookup ***\n");
+	_bench_lookup("String", str);
+	_bench_lookup("Dictionary", dict);
+	_bench_lookup("Array", array);
+	_bench_lookup("Vector2", Vector2());
+
+	OS::get_singleton()->print("\n*** Method calls ***\n");
+	int passed = 0;
+	int count = 0;
+
+	count++;
+	if (_bench_call("Dictionary.has", dict, "has", "key32"))
+		passed++;
+	count++;
+	if (_bench_call("Dictionary.size", dict, "size"))
+		passed++;
+	count++;
+	if (_bench_call("Array.size", array, "size"))
+		passed++;
+	count++;
+	if (_bench_call("String.find", str, "find", "lazy"))
+		passed++;
+
+	OS::get_singleton()->print("\nPassed %i of %i calls\n", passed, count);
+
+	return NULL;
+}
+}
@@ -0,0 +1,136 @@
+/*************************************************************************/
+/*  test_video.cpp                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2016 Juan Linietsky, Ariel Manzur.                 */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "test_video.h"
+
+#include "globals.h"
+#include "io/resource_loader.h"
+#include "os/os.h"
+#include "scene/resources/video_stream.h"
+
+namespace TestVideo {
+
+#define BENCH_SECONDS 30
+#define BENCH_LOOP_FPS 60
+
+struct BenchConfig {
+
+	const char *name;
+	bool decode_thread;
+	bool planar_yuv;
+};
+
+static const BenchConfig bench_configs[] = {
+	{ "main thread, rgba", false, false },
+	{ "main thread, planar", false, true },
+	{ "decode thread, rgba", true, false },
+	{ "decode thread, planar", true, true },
+	{ NULL, false, false }
+};
+
+static void _bench_playback(Ref<VideoStream> p_stream, const BenchConfig &p_config) {
+
+	Globals::get_singleton()->set("render/theora_decode_thread", p_config.decode_thread);
+	Globals::get_singleton()->set("render/theora_planar_yuv", p_config.planar_yuv);
+
+	Ref<VideoStreamPlayback> playback = p_stream->instance_playback();
+	playback->play();
+
+	// a main loop at BENCH_LOOP_FPS, updating the video like VideoPlayer does
+	const uint64_t loop_usec = 1000000 / BENCH_LOOP_FPS;
+
+	int frames = 0;
+	int loops = 0;
+	int loops_late = 0;
+	uint64_t frame_usec = 0;
+	uint64_t frame_usec_max = 0;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	uint64_t last = begin;
+
+	while (playback->is_playing() && last - begin < BENCH_SECONDS * 1000000) {
+
+		uint64_t now = OS::get_singleton()->get_ticks_usec();
+		float delta = (now - last) / 1000000.0;
+		last = now;
+
+		int drawn = playback->get_frames_drawn();
+		playback->update(delta);
+		uint64_t took = OS::get_singleton()->get_ticks_usec() - now;
+
+		if (playback->get_frames_drawn() != drawn) {
+			frames++;
+			frame_usec += took;
+			frame_usec_max = MAX(frame_usec_max, took);
+		}
+
+		loops++;
+		if (took > loop_usec)
+			loops_late++;
+		else
+			OS::get_singleton()->delay_usec(loop_usec - took);
+	}
+
+	playback->stop();
+
+	float seconds = (OS::get_singleton()->get_ticks_usec() - begin) / 1000000.0;
+
+	OS::get_singleton()->print("%s\n", p_config.name);
+	OS::get_singleton()->print("\t%i frames in %.2f sec: %.2f fps\n", frames, seconds, frames / seconds);
+	OS::get_singleton()->print("\tupdate() per frame: %i usec avg, %i usec max\n", frames ? int(frame_usec / frames) : 0, int(frame_usec_max));
+	OS::get_singleton()->print("\t%i of %i main loop iterations over the %i fps budget\n", loops_late, loops, BENCH_LOOP_FPS);
+}
+
+MainLoop *test() {
+
+	List<String> cmdlargs = OS::get_singleton()->get_cmdline_args();
+
+	String path;
+	if (!cmdlargs.empty() && cmdlargs.back()->get() != "video")
+		path = cmdlargs.back()->get();
+
+	if (path == "") {
+		OS::get_singleton()->print("Usage: -test video <file.ogv>\n");
+		return NULL;
+	}
+
+	Ref<VideoStream> stream = ResourceLoader::load(path);
+	if (stream.is_null()) {
+		OS::get_singleton()->print("Can't load video: %ls\n", path.c_str());
+		return NULL;
+	}
+
+	OS::get_singleton()->print("%ls, up to %i seconds per run\n\n", path.c_str(), BENCH_SECONDS);
+
+	for (int i = 0; bench_configs[i].name; i++) {
+		_bench_playback(stream, bench_configs[i]);
+	}
+
+	return NULL;
+}
+}
@@ -0,0 +1,290 @@
+/*************************************************************************/
+/*  test_yuv2rgb.cpp                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2017 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "test_yuv2rgb.h"
+
+#include "math_funcs.h"
+#include "os/os.h"
+#include "vector.h"
+
+#ifdef THEORA_ENABLED
+#include "modules/theora/yuv2rgb.h"
+#include "modules/theora/yuv2rgb_simd.h"
+#endif
+
+namespace TestYUV2RGB {
+
+#ifdef THEORA_ENABLED
+
+// the 6 bit fixed point converters may be this far off the exact BT.601 values
+#define REFERENCE_TOLERANCE 3
+// the packed tables round the blue coefficient a bit further
+#define TABLE_TOLERANCE 6
+#define PAD_BYTE 0x5A
+
+struct Frame {
+
+	int width;
+	int height;
+	int shift_x;
+	int shift_y;
+	int y_span;
+	int uv_span;
+	Vector<uint8_t> y;
+	Vector<uint8_t> u;
+	Vector<uint8_t> v;
+};
+
+struct Size {
+
+	int width;
+	int height;
+};
+
+// widths that leave a tail after the 16 pixel SIMD loop, and odd ones for the subsampled formats
+static const Size sizes[] = {
+	{ 16, 4 },
+	{ 37, 7 },
+	{ 45, 10 },
+	{ 3, 1 },
+	{ 0, 0 }
+};
+
+static uint32_t _rand(uint32_t &r_seed) {
+
+	r_seed = r_seed * 1103515245 + 12345;
+	return r_seed >> 16;
+}
+
+// legal BT.601 input is y 16-235 and chroma 16-240, decoders may still produce the full 0-255
+static void _make_frame(Frame &r_frame, int p_width, int p_height, int p_shift_x, int p_shift_y, bool p_full_range, uint32_t p_seed) {
+
+	r_frame.width = p_width;
+	r_frame.height = p_height;
+	r_frame.shift_x = p_shift_x;
+	r_frame.shift_y = p_shift_y;
+
+	int uv_width = (p_width + (1 << p_shift_x) - 1) >> p_shift_x;
+	int uv_height = (p_height + (1 << p_shift_y) - 1) >> p_shift_y;
+
+	// spans wider than the rows, like theora's padded planes
+	r_frame.y_span = p_width + 7;
+	r_frame.uv_span = uv_width + 5;
+
+	r_frame.y.resize(r_frame.y_span * p_height);
+	r_frame.u.resize(r_frame.uv_span * uv_height);
+	r_frame.v.resize(r_frame.uv_span * uv_height);
+
+	int y_min = p_full_range ? 0 : 16;
+	int y_range = p_full_range ? 256 : 220;
+	int uv_min = p_full_range ? 0 : 16;
+	int uv_range = p_full_range ? 256 : 225;
+
+	for (int i = 0; i < r_frame.y.size(); i++) {
+		r_frame.y[i] = y_min + _rand(p_seed) % y_range;
+	}
+	for (int i = 0; i < r_frame.u.size(); i++) {
+		r_frame.u[i] = uv_min + _rand(p_seed) % uv_range;
+		r_frame.v[i] = uv_min + _rand(p_seed) % uv_range;
+	}
+
+	// black, white and the most saturated colors at the start of the first row
+	uint8_t ys[4] = { 16, 235, uint8_t(y_min), uint8_t(y_min + y_range - 1) };
+	uint8_t uvs[4] = { 128, 128, uint8_t(uv_min), uint8_t(uv_min + uv_range - 1) };
+	for (int i = 0; i < 4 && i < p_width; i++) {
+		r_frame.y[i] = ys[i];
+		r_frame.u[i >> p_shift_x] = uvs[i];
+		r_frame.v[i >> p_shift_x] = uvs[3 - i];
+	}
+}
+
+static uint8_t _reference_clamp(float p_v) {
+
+	return CLAMP(Math::fast_ftoi(p_v), 0, 255);
+}
+
+// exact BT.601 video range conversion
+static void _reference(const Frame &p_frame, int p_x, int p_y, uint8_t *r_rgba) {
+
+	int uv = (p_y >> p_frame.shift_y) * p_frame.uv_span + (p_x >> p_frame.shift_x);
+
+	float c = 1.164383f * (p_frame.y[p_y * p_frame.y_span + p_x] - 16);
+	float d = p_frame.u[uv] - 128;
+	float e = p_frame.v[uv] - 128;
+
+	r_rgba[0] = _reference_clamp(c + 1.596027f * e);
+	r_rgba[1] = _reference_clamp(c - 0.391762f * d - 0.812968f * e);
+	r_rgba[2] = _reference_clamp(c + 2.017232f * d);
+	r_rgba[3] = 255;
+}
+
+enum Converter {
+	CONVERTER_SIMD,
+	CONVERTER_C,
+	CONVERTER_TABLES,
+};
+
+static Vector<uint8_t> _convert(const Frame &p_frame, Converter p_converter, int p_dst_span) {
+
+	Vector<uint8_t> dst;
+	dst.resize(p_dst_span * p_frame.height);
+	for (int i = 0; i < dst.size(); i++) {
+		dst[i] = PAD_BYTE;
+	}
+
+	const uint8_t *y = p_frame.y.ptr();
+	const uint8_t *u = p_frame.u.ptr();
+	const uint8_t *v = p_frame.v.ptr();
+
+	switch (p_converter) {
+
+		case CONVERTER_SIMD: {
+
+			yuv2rgba8888(dst.ptr(), y, u, v, p_frame.width, p_frame.height, p_frame.y_span, p_frame.uv_span, p_dst_span, p_frame.shift_x, p_frame.shift_y);
+		} break;
+		case CONVERTER_C: {
+
+			yuv2rgba8888_c(dst.ptr(), y, u, v, p_frame.width, p_frame.height, p_frame.y_span, p_frame.uv_span, p_dst_span, p_frame.shift_x, p_frame.shift_y);
+		} break;
+		case CONVERTER_TABLES: {
+
+			if (p_frame.shift_y)
+				yuv420_2_rgb8888(dst.ptr(), y, u, v, p_frame.width, p_frame.height, p_frame.y_span, p_frame.uv_span, p_dst_span, 0);
+			else if (p_frame.shift_x)
+				yuv422_2_rgb8888(dst.ptr(), y, u, v, p_frame.width, p_frame.height, p_frame.y_span, p_frame.uv_span, p_dst_span, 0);
+			else
+				yuv444_2_rgb8888(dst.ptr(), y, u, v, p_frame.width, p_frame.height, p_frame.y_span, p_frame.uv_span, p_dst_span, 0);
+		} break;
+	}
+
+	return dst;
+}
+
+// every pixel close to the reference, and nothing written past the end of a row
+static bool _check(const Frame &p_frame, const Vector<uint8_t> &p_dst, int p_dst_span, int p_tolerance, int &r_max_error) {
+
+	r_max_error = 0;
+
+	for (int y = 0; y < p_frame.height; y++) {
+
+		const uint8_t *row = &p_dst[y * p_dst_span];
+
+		for (int x = 0; x < p_frame.width; x++) {
+
+			uint8_t ref[4];
+			_reference(p_frame, x, y, ref);
+
+			for (int i = 0; i < 4; i++) {
+				r_max_error = MAX(r_max_error, ABS(int(row[x * 4 + i]) - int(ref[i])));
+			}
+		}
+
+		for (int i = p_frame.width * 4; i < p_dst_span; i++) {
+			if (row[i] != PAD_BYTE)
+				return false;
+		}
+	}
+
+	return r_max_error <= p_tolerance;
+}
+
+static bool _test_format(const char *p_name, int p_shift_x, int p_shift_y) {
+
+	OS::get_singleton()->print("\n*** %s ***\n", p_name);
+
+	static const char *converter_names[3] = { "yuv2rgba8888", "yuv2rgba8888_c", "table fallback" };
+
+	bool pass = true;
+
+	for (int i = 0; sizes[i].width; i++) {
+
+		for (int full_range = 0; full_range < 2; full_range++) {
+
+			Frame frame;
+			_make_frame(frame, sizes[i].width, sizes[i].height, p_shift_x, p_shift_y, full_range, i + 1);
+			int dst_span = frame.width * 4 + 12;
+
+			// the tables only cover legal input, out of range samples wrap around
+			int converters = full_range ? 2 : 3;
+
+			Vector<uint8_t> results[3];
+			for (int j = 0; j < converters; j++) {
+
+				results[j] = _convert(frame, Converter(j), dst_span);
+
+				int max_error;
+				bool ok = _check(frame, results[j], dst_span, j == CONVERTER_TABLES ? TABLE_TOLERANCE : REFERENCE_TOLERANCE, max_error);
+				OS::get_singleton()->print("\t%ix%i%s %s: max error %i %s\n", frame.width, frame.height, full_range ? " full range" : "", converter_names[j], max_error, ok ? "ok" : "wrong");
+				pass = pass && ok;
+			}
+
+			// the SIMD rows have to give the same bytes as the C rows they finish with
+			bool same = memcmp(results[CONVERTER_SIMD].ptr(), results[CONVERTER_C].ptr(), results[CONVERTER_C].size()) == 0;
+			if (!same)
+				OS::get_singleton()->print("\t%ix%i yuv2rgba8888 differs from yuv2rgba8888_c\n", frame.width, frame.height);
+			pass = pass && same;
+		}
+	}
+
+	OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+	return pass;
+}
+
+MainLoop *test() {
+
+	OS::get_singleton()->print("SIMD: %s\n", yuv2rgba_simd_get_name());
+
+	int passed = 0;
+	int count = 0;
+
+	count++;
+	if (_test_format("4:2:0", 1, 1))
+		passed++;
+	count++;
+	if (_test_format("4:2:2", 1, 0))
+		passed++;
+	count++;
+	if (_test_format("4:4:4", 0, 0))
+		passed++;
+
+	OS::get_singleton()->print("\nPassed %i of %i tests\n", passed, count);
+
+	return NULL;
+}
+
+#else
+
+MainLoop *test() {
+
+	OS::get_singleton()->print("The theora module is disabled, nothing to test\n");
+	return NULL;
+}
+
+#endif
+}
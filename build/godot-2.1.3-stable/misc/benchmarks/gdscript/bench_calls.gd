@@ -0,0 +1,45 @@
+# Script and built-in method calls.
+extends Reference
+
+const N = 300000
+
+var counter = 0
+
+func _add(a, b):
+	return a + b
+
+func _inc():
+	counter += 1
+
+func bench_script_call():
+	var sum = 0
+	for i in range(N):
+		sum = _add(sum, i)
+	return sum
+
+func bench_member_access():
+	counter = 0
+	for i in range(N):
+		_inc()
+	return counter
+
+func bench_builtin_methods():
+	var arr = [1, 2, 3, 4, 5, 6, 7, 8]
+	var dict = { "a": 1, "b": 2, "c": 3 }
+	var s = "the quick brown fox"
+	var sum = 0
+	for i in range(N):
+		sum += arr.size()
+		if dict.has("b"):
+			sum += 1
+		sum += s.find("fox")
+	return sum
+
+func bench_vector_math():
+	var p = Vector2()
+	var d = Vector2(0.5, 0.25)
+	for i in range(N):
+		p += d
+		if p.length() > 100:
+			p = Vector2()
+	return int(p.x * 1000)
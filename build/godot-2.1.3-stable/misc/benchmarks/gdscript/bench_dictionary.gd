@@ -0,0 +1,45 @@
+# Dictionary access, the pattern used by the lesson and catalogue data.
+extends Reference
+
+const N = 200000
+
+func bench_set_get_string_keys():
+	var keys = []
+	for i in range(100):
+		keys.append("key" + str(i))
+	var dict = {}
+	for i in range(N):
+		var k = keys[i % 100]
+		dict[k] = i
+	var sum = 0
+	for i in range(N):
+		sum += dict[keys[i % 100]]
+	return sum
+
+func bench_int_keys():
+	var dict = {}
+	for i in range(N):
+		dict[i % 1000] = i
+	var sum = 0
+	for i in range(N):
+		sum += dict[i % 1000]
+	return sum
+
+func bench_has_and_iterate():
+	var dict = {}
+	for i in range(500):
+		dict["item" + str(i)] = { "id": i, "answer": "a" }
+	var found = 0
+	for i in range(N / 500):
+		for k in dict:
+			if dict[k]["id"] % 7 == 0:
+				found += 1
+		if dict.has("item" + str(i)):
+			found += 1
+	return found
+
+func bench_named_index():
+	var item = { "question": "q", "answer": "a", "score": 0 }
+	for i in range(N):
+		item.score += 1
+	return item.score
@@ -0,0 +1,62 @@
+# Loops, int/real arithmetic and branches.
+extends Reference
+
+const N = 1000000
+
+func bench_for_range():
+	var sum = 0
+	for i in range(N):
+		sum += i
+	return sum
+
+func bench_for_range_step():
+	var sum = 0
+	for i in range(N, 0, -3):
+		sum += i
+	return sum
+
+func bench_for_array():
+	var arr = []
+	arr.resize(1000)
+	for i in range(arr.size()):
+		arr[i] = i
+	var sum = 0
+	for j in range(N / 1000):
+		for v in arr:
+			sum += v
+	return sum
+
+func bench_while_int():
+	var i = 0
+	var sum = 0
+	while i < N:
+		sum += i
+		i += 1
+	return sum
+
+func bench_branches():
+	var even = 0
+	var big = 0
+	for i in range(N):
+		if i % 2 == 0:
+			even += 1
+		if i >= N / 2 and i != N - 1:
+			big += 1
+	return even + big
+
+func bench_real_math():
+	var x = 0.0
+	var v = 0.5
+	for i in range(N):
+		x = x * 0.999 + v
+		if x > 100.0:
+			x -= 100.0
+	return int(x * 1000)
+
+func bench_fibonacci():
+	return _fib(24)
+
+func _fib(n):
+	if n < 2:
+		return n
+	return _fib(n - 1) + _fib(n - 2)
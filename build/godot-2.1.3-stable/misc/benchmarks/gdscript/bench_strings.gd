@@ -0,0 +1,41 @@
+# String building and searching.
+extends Reference
+
+const N = 100000
+
+func bench_concat():
+	var s = ""
+	for i in range(N):
+		s += "a"
+	return s.length()
+
+func bench_str_numbers():
+	var total = 0
+	for i in range(N):
+		total += str(i).length()
+	return total
+
+func bench_format():
+	var total = 0
+	for i in range(N):
+		total += ("%d/%d" % [i, N]).length()
+	return total
+
+func bench_split_join():
+	var line = "one two three four five six seven eight nine ten"
+	var total = 0
+	for i in range(N / 10):
+		var words = line.split(" ")
+		var out = ""
+		for w in words:
+			out += w.capitalize()
+		total += out.length()
+	return total
+
+func bench_find_replace():
+	var text = "the quick brown fox jumps over the lazy dog. "
+	var total = 0
+	for i in range(N / 10):
+		total += text.find("lazy")
+		total += text.replace("the", "a").length()
+	return total
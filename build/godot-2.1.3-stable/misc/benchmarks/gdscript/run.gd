@@ -0,0 +1,76 @@
+# Headless GDScript interpreter benchmarks, to track the VM throughput over time.
+#
+# usage: godot_server -s misc/benchmarks/gdscript/run.gd [--filter=<text>] [--csv=<file>]
+#
+# Every bench_* function of the scripts below runs REPEAT times, the best time is
+# reported. The checksum each function returns must stay the same between
+# versions, otherwise the interpreter changed behaviour.
+extends SceneTree
+
+const REPEAT = 3
+
+const BENCHMARKS = [
+	preload("bench_loops.gd"),
+	preload("bench_calls.gd"),
+	preload("bench_dictionary.gd"),
+	preload("bench_strings.gd")
+]
+
+func _init():
+	var filter = ""
+	var csv_path = ""
+	for arg in OS.get_cmdline_args():
+		if arg.begins_with("--filter="):
+			filter = arg.substr(9, arg.length() - 9)
+		elif arg.begins_with("--csv="):
+			csv_path = arg.substr(6, arg.length() - 6)
+	
+	var results = []
+	var total = 0
+	for script in BENCHMARKS:
+		var bench = script.new()
+		var suite = script.get_path().get_file().basename().replace("bench_", "")
+		for m in bench.get_method_list():
+			var method = m["name"]
+			if not method.begins_with("bench_"):
+				continue
+			var name = suite + "." + method.substr(6, method.length() - 6)
+			if filter != "" and name.find(filter) == -1:
+				continue
+			
+			var best = -1
+			var checksum = null
+			for i in range(REPEAT):
+				var from = OS.get_ticks_msec()
+				checksum = bench.call(method)
+				var msec = OS.get_ticks_msec() - from
+				if best < 0 or msec < best:
+					best = msec
+			
+			print(name + ": " + str(best) + " ms (checksum " + str(checksum) + ")")
+			results.append([name, best, checksum])
+			total += best
+	
+	print("total: " + str(total) + " ms")
+	
+	if csv_path != "":
+		_write_csv(csv_path, results)
+	
+	quit()
+
+func _write_csv(path, results):
+	var f = File.new()
+	var exists = f.file_exists(path)
+	if f.open(path, File.READ_WRITE if exists else File.WRITE) != OK:
+		print("can't write " + path)
+		return
+	f.seek_end()
+	if not exists:
+		f.store_line("date,version,benchmark,msec,checksum")
+	
+	var date = OS.get_datetime()
+	var stamp = "%04d-%02d-%02d %02d:%02d" % [date["year"], date["month"], date["day"], date["hour"], date["minute"]]
+	var version = str(OS.get_engine_version()["string"])
+	for r in results:
+		f.store_line(stamp + "," + version + "," + r[0] + "," + str(r[1]) + "," + str(r[2]))
+	f.close()
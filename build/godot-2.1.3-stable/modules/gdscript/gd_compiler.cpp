@@ -45,6 +45,33 @@ void GDCompiler::_set_error(const String &p_error, const GDParser::Node *p_node)
 	}
 }
 
+Variant::Type GDCompiler::_get_builtin_type(const GDParser::Node *p_expression) const {
+
+	//type of the expression if it is known at compile time and is not an object, VARIANT_MAX otherwise
+	switch (p_expression->type) {
+
+		case GDParser::Node::TYPE_CONSTANT: {
+
+			Variant::Type type = static_cast<const GDParser::ConstantNode *>(p_expression)->value.get_type();
+			return type == Variant::OBJECT ? Variant::VARIANT_MAX : type;
+		}
+		case GDParser::Node::TYPE_ARRAY: return Variant::ARRAY;
+		case GDParser::Node::TYPE_DICTIONARY: return Variant::DICTIONARY;
+		case GDParser::Node::TYPE_OPERATOR: {
+
+			const GDParser::OperatorNode *on = static_cast<const GDParser::OperatorNode *>(p_expression);
+			if (on->op == GDParser::OperatorNode::OP_CALL && on->arguments.size() && on->arguments[0]->type == GDParser::Node::TYPE_TYPE) {
+				//basic type constructor
+				Variant::Type type = static_cast<const GDParser::TypeNode *>(on->arguments[0])->vtype;
+				return type == Variant::OBJECT ? Variant::VARIANT_MAX : type;
+			}
+		} break;
+		default: {}
+	}
+
+	return Variant::VARIANT_MAX;
+}
+
 bool GDCompiler::_create_unary_operator(CodeGen &codegen, const GDParser::OperatorNode *on, Variant::Operator op, int p_stack_level) {
 
 	ERR_FAIL_COND_V(on->arguments.size() != 1, false);
@@ -75,6 +102,7 @@ bool GDCompiler::_create_binary_operator(CodeGen &codegen, const GDParser::Opera
 	if (src_address_b < 0)
 		return false;
 
+	codegen.last_operator_pos = codegen.opcodes.size();
 	codegen.opcodes.push_back(GDFunction::OPCODE_OPERATOR); // perform operator
 	codegen.opcodes.push_back(op); //which operator
 	codegen.opcodes.push_back(src_address_a); // argument 1
@@ -82,6 +110,28 @@ bool GDCompiler::_create_binary_operator(CodeGen &codegen, const GDParser::Opera
 	return true;
 }
 
+int GDCompiler::_emit_jump_if_not(CodeGen &codegen, int p_test) {
+
+	//if the test is a comparison that was just emitted, turn it into a single compare-and-jump
+	int pos = codegen.last_operator_pos;
+	if (pos >= 0 && pos + 5 == codegen.opcodes.size() && codegen.opcodes[pos + 4] == p_test) {
+
+		int op = codegen.opcodes[pos + 1];
+		if (op >= Variant::OP_EQUAL && op <= Variant::OP_GREATER_EQUAL) {
+
+			codegen.opcodes[pos] = GDFunction::OPCODE_JUMP_IF_NOT_COMPARE;
+			codegen.opcodes.push_back(0); //jump address, filled by the caller
+			codegen.last_operator_pos = -1;
+			return codegen.opcodes.size() - 1;
+		}
+	}
+
+	codegen.opcodes.push_back(GDFunction::OPCODE_JUMP_IF_NOT);
+	codegen.opcodes.push_back(p_test);
+	codegen.opcodes.push_back(0); //jump address, filled by the caller
+	return codegen.opcodes.size() - 1;
+}
+
 /*
 int GDCompiler::_parse_subexpression(CodeGen& codegen,const GDParser::Node *p_expression) {
 
@@ -480,11 +530,20 @@ int GDCompiler::_parse_expression(CodeGen &codegen, const GDParser::Node *p_expr
 							arguments.push_back(ret);
 						}
 
+						// resolve the built-in method now if the base type is known, else the call site caches it at run time
+						const Variant::BuiltInMethod *method = NULL;
+						Variant::Type base_type = _get_builtin_type(instance);
+						if (base_type != Variant::VARIANT_MAX)
+							method = Variant::get_builtin_method(base_type, static_cast<const GDParser::IdentifierNode *>(on->arguments[1])->name);
+
 						codegen.opcodes.push_back(p_root ? GDFunction::OPCODE_CALL : GDFunction::OPCODE_CALL_RETURN); // perform operator
 						codegen.opcodes.push_back(on->arguments.size() - 2);
 						codegen.alloc_call(on->arguments.size() - 2);
-						for (int i = 0; i < arguments.size(); i++)
+						for (int i = 0; i < arguments.size(); i++) {
 							codegen.opcodes.push_back(arguments[i]);
+							if (i == 1)
+								codegen.opcodes.push_back(codegen.add_call_cache(method)); //call cache
+						}
 					}
 				} break;
 				case GDParser::OperatorNode::OP_YIELD: {
@@ -583,19 +642,13 @@ int GDCompiler::_parse_expression(CodeGen &codegen, const GDParser::Node *p_expr
 					int res = _parse_expression(codegen, on->arguments[0], p_stack_level);
 					if (res < 0)
 						return res;
-					codegen.opcodes.push_back(GDFunction::OPCODE_JUMP_IF_NOT);
-					codegen.opcodes.push_back(res);
-					int jump_fail_pos = codegen.opcodes.size();
-					codegen.opcodes.push_back(0);
+					int jump_fail_pos = _emit_jump_if_not(codegen, res);
 
 					res = _parse_expression(codegen, on->arguments[1], p_stack_level);
 					if (res < 0)
 						return res;
 
-					codegen.opcodes.push_back(GDFunction::OPCODE_JUMP_IF_NOT);
-					codegen.opcodes.push_back(res);
-					int jump_fail_pos2 = codegen.opcodes.size();
-					codegen.opcodes.push_back(0);
+					int jump_fail_pos2 = _emit_jump_if_not(codegen, res);
 
 					codegen.alloc_stack(p_stack_level); //it will be used..
 					codegen.opcodes.push_back(GDFunction::OPCODE_ASSIGN_TRUE);
@@ -650,10 +703,7 @@ int GDCompiler::_parse_expression(CodeGen &codegen, const GDParser::Node *p_expr
 					int res = _parse_expression(codegen, on->arguments[0], p_stack_level);
 					if (res < 0)
 						return res;
-					codegen.opcodes.push_back(GDFunction::OPCODE_JUMP_IF_NOT);
-					codegen.opcodes.push_back(res);
-					int jump_fail_pos = codegen.opcodes.size();
-					codegen.opcodes.push_back(0);
+					int jump_fail_pos = _emit_jump_if_not(codegen, res);
 
 					res = _parse_expression(codegen, on->arguments[1], p_stack_level);
 					if (res < 0)
@@ -1026,10 +1076,7 @@ Error GDCompiler::_parse_block(CodeGen &codegen, const GDParser::BlockNode *p_bl
 						if (ret < 0)
 							return ERR_PARSE_ERROR;
 
-						codegen.opcodes.push_back(GDFunction::OPCODE_JUMP_IF_NOT);
-						codegen.opcodes.push_back(ret);
-						int else_addr = codegen.opcodes.size();
-						codegen.opcodes.push_back(0); //temporary
+						int else_addr = _emit_jump_if_not(codegen, ret);
 
 						Error err = _parse_block(codegen, cf->body, p_stack_level, p_break_addr, p_continue_addr);
 						if (err)
@@ -1065,34 +1112,85 @@ Error GDCompiler::_parse_block(CodeGen &codegen, const GDParser::BlockNode *p_bl
 						codegen.push_stack_identifiers();
 						codegen.add_stack_identifier(static_cast<const GDParser::IdentifierNode *>(cf->arguments[0])->name, iter_stack_pos);
 
-						int ret = _parse_expression(codegen, cf->arguments[1], slevel, false);
-						if (ret < 0)
-							return ERR_COMPILATION_FAILED;
+						//for in range() counts in place instead of building the array
+						const GDParser::OperatorNode *range = NULL;
+						if (cf->arguments[1]->type == GDParser::Node::TYPE_OPERATOR) {
 
-						//assign container
-						codegen.opcodes.push_back(GDFunction::OPCODE_ASSIGN);
-						codegen.opcodes.push_back(container_pos);
-						codegen.opcodes.push_back(ret);
+							const GDParser::OperatorNode *on = static_cast<const GDParser::OperatorNode *>(cf->arguments[1]);
+							if (on->op == GDParser::OperatorNode::OP_CALL && on->arguments[0]->type == GDParser::Node::TYPE_BUILT_IN_FUNCTION && static_cast<const GDParser::BuiltInFunctionNode *>(on->arguments[0])->function == GDFunctions::GEN_RANGE && on->arguments.size() >= 2 && on->arguments.size() <= 4) {
+								range = on;
+							}
+						}
+
+						int step_pos = -1;
+
+						if (range) {
+
+							step_pos = (slevel++) | (GDFunction::ADDR_TYPE_STACK << GDFunction::ADDR_BITS);
+							codegen.alloc_stack(slevel);
+
+							//counter goes from the first argument to the container (used as the end) by step
+							int range_pos[3] = { counter_pos, container_pos, step_pos };
+							int argc = range->arguments.size() - 1;
+							int first = argc == 1 ? 1 : 0; //range(n) only gives the end
+
+							for (int i = 0; i < 3; i++) {
+
+								int src;
+								if (i >= first && i < first + argc) {
+									src = _parse_expression(codegen, range->arguments[i - first + 1], slevel, false);
+									if (src < 0)
+										return ERR_COMPILATION_FAILED;
+								} else {
+									//start defaults to 0, step to 1
+									src = codegen.get_constant_pos(i == 2 ? 1 : 0) | (GDFunction::ADDR_TYPE_LOCAL_CONSTANT << GDFunction::ADDR_BITS);
+								}
+
+								//assign right away, the next argument may use the same stack position
+								codegen.opcodes.push_back(GDFunction::OPCODE_ASSIGN);
+								codegen.opcodes.push_back(range_pos[i]);
+								codegen.opcodes.push_back(src);
+							}
+
+						} else {
+
+							int ret = _parse_expression(codegen, cf->arguments[1], slevel, false);
+							if (ret < 0)
+								return ERR_COMPILATION_FAILED;
+
+							//assign container
+							codegen.opcodes.push_back(GDFunction::OPCODE_ASSIGN);
+							codegen.opcodes.push_back(container_pos);
+							codegen.opcodes.push_back(ret);
+						}
 
 						//begin loop
-						codegen.opcodes.push_back(GDFunction::OPCODE_ITERATE_BEGIN);
+						codegen.opcodes.push_back(range ? GDFunction::OPCODE_ITERATE_RANGE_BEGIN : GDFunction::OPCODE_ITERATE_BEGIN);
 						codegen.opcodes.push_back(counter_pos);
 						codegen.opcodes.push_back(container_pos);
-						codegen.opcodes.push_back(codegen.opcodes.size() + 4);
+						if (range)
+							codegen.opcodes.push_back(step_pos);
+						int begin_end_pos = codegen.opcodes.size();
+						codegen.opcodes.push_back(0);
 						codegen.opcodes.push_back(iterator_pos);
 						codegen.opcodes.push_back(GDFunction::OPCODE_JUMP); //skip code for next
-						codegen.opcodes.push_back(codegen.opcodes.size() + 8);
+						int begin_skip_pos = codegen.opcodes.size();
+						codegen.opcodes.push_back(0);
 						//break loop
 						int break_pos = codegen.opcodes.size();
 						codegen.opcodes.push_back(GDFunction::OPCODE_JUMP); //skip code for next
 						codegen.opcodes.push_back(0); //skip code for next
+						codegen.opcodes[begin_end_pos] = break_pos;
 						//next loop
 						int continue_pos = codegen.opcodes.size();
-						codegen.opcodes.push_back(GDFunction::OPCODE_ITERATE);
+						codegen.opcodes.push_back(range ? GDFunction::OPCODE_ITERATE_RANGE : GDFunction::OPCODE_ITERATE);
 						codegen.opcodes.push_back(counter_pos);
 						codegen.opcodes.push_back(container_pos);
+						if (range)
+							codegen.opcodes.push_back(step_pos);
 						codegen.opcodes.push_back(break_pos);
 						codegen.opcodes.push_back(iterator_pos);
+						codegen.opcodes[begin_skip_pos] = codegen.opcodes.size();
 
 						Error err = _parse_block(codegen, cf->body, slevel, break_pos, continue_pos);
 						if (err)
@@ -1117,9 +1215,8 @@ Error GDCompiler::_parse_block(CodeGen &codegen, const GDParser::BlockNode *p_bl
 						int ret = _parse_expression(codegen, cf->arguments[0], p_stack_level, false);
 						if (ret < 0)
 							return ERR_PARSE_ERROR;
-						codegen.opcodes.push_back(GDFunction::OPCODE_JUMP_IF_NOT);
-						codegen.opcodes.push_back(ret);
-						codegen.opcodes.push_back(break_addr);
+						int jump_addr = _emit_jump_if_not(codegen, ret);
+						codegen.opcodes[jump_addr] = break_addr;
 						Error err = _parse_block(codegen, cf->body, p_stack_level, break_addr, continue_addr);
 						if (err)
 							return err;
@@ -1228,6 +1325,7 @@ Error GDCompiler::_parse_function(GDScript *p_script, const GDParser::ClassNode
 	codegen.stack_max = 0;
 	codegen.current_line = 0;
 	codegen.call_max = 0;
+	codegen.last_operator_pos = -1;
 	codegen.debug_stack = ScriptDebugger::get_singleton() != NULL;
 	Vector<StringName> argnames;
 
@@ -1355,6 +1453,18 @@ Error GDCompiler::_parse_function(GDScript *p_script, const GDParser::ClassNode
 		gdfunc->_global_names_count = 0;
 	}
 
+	//call caches
+	if (codegen.call_caches.size()) {
+
+		gdfunc->call_caches = codegen.call_caches;
+		gdfunc->_call_cache_ptr = &gdfunc->call_caches[0];
+		gdfunc->_call_cache_count = gdfunc->call_caches.size();
+
+	} else {
+		gdfunc->_call_cache_ptr = NULL;
+		gdfunc->_call_cache_count = 0;
+	}
+
 	if (codegen.opcodes.size()) {
 
 		gdfunc->code = codegen.opcodes;
@@ -113,6 +113,13 @@ class GDCompiler {
 			return pos;
 		}
 
+		Vector<const Variant::BuiltInMethod *> call_caches;
+
+		int add_call_cache(const Variant::BuiltInMethod *p_method) {
+			call_caches.push_back(p_method);
+			return call_caches.size() - 1;
+		}
+
 		Vector<int> opcodes;
 		void alloc_stack(int p_level) {
 			if (p_level >= stack_max) stack_max = p_level + 1;
@@ -124,6 +131,7 @@ class GDCompiler {
 		int current_line;
 		int stack_max;
 		int call_max;
+		int last_operator_pos; //last OPCODE_OPERATOR emitted, for the compare-and-jump peephole
 	};
 
 #if 0
@@ -142,6 +150,9 @@ class GDCompiler {
 	bool _create_unary_operator(CodeGen &codegen, const GDParser::OperatorNode *on, Variant::Operator op, int p_stack_level);
 	bool _create_binary_operator(CodeGen &codegen, const GDParser::OperatorNode *on, Variant::Operator op, int p_stack_level, bool p_initializer = false);
 
+	Variant::Type _get_builtin_type(const GDParser::Node *p_expression) const;
+	int _emit_jump_if_not(CodeGen &codegen, int p_test);
+
 	//int _parse_subexpression(CodeGen& codegen,const GDParser::BlockNode *p_block,const GDParser::Node *p_expression);
 	int _parse_assign_right_expression(CodeGen &codegen, const GDParser::OperatorNode *p_expression, int p_stack_level);
 	int _parse_expression(CodeGen &codegen, const GDParser::Node *p_expression, int p_stack_level, bool p_root = false, bool p_initializer = false);
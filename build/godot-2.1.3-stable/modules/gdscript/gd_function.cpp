@@ -3,6 +3,62 @@
 #include "gd_script.h"
 #include "os/os.h"
 
+// Labels as values (GCC, Clang) let every opcode jump straight to the next one
+// instead of going back through the switch.
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(GDSCRIPT_NO_COMPUTED_GOTO)
+#define USE_COMPUTED_GOTO
+#endif
+
+#ifdef USE_COMPUTED_GOTO
+
+#define OPCODE(m_op) \
+	m_op:
+#define OPCODE_DEFAULT \
+	opcode_illegal:
+#define OPCODE_WHILE(m_test)
+#define OPCODE_SWITCH(m_test) DISPATCH_OPCODE;
+#define OPCODES_END \
+	opcodes_exit:
+#define OPCODES_OUT \
+	opcodes_out:
+#define OPCODE_BREAK goto opcodes_exit
+#define OPCODE_OUT goto opcodes_out
+
+#define DISPATCH_OPCODE                                   \
+	{                                                     \
+		if (ip >= _code_size)                             \
+			goto opcodes_out;                             \
+		last_opcode = _code_ptr[ip];                      \
+		if (last_opcode < 0 || last_opcode >= OPCODE_MAX) \
+			goto opcode_illegal;                          \
+		goto *opcode_table[last_opcode];                  \
+	}
+
+#else
+
+#define OPCODE(m_op) case m_op:
+#define OPCODE_DEFAULT default:
+#define OPCODE_WHILE(m_test) while (m_test)
+#define OPCODE_SWITCH(m_test) \
+	last_opcode = m_test;     \
+	switch (last_opcode)
+#define OPCODES_END
+#define OPCODES_OUT
+#define OPCODE_BREAK break
+#define OPCODE_OUT break
+#define DISPATCH_OPCODE continue
+
+#endif
+
+#define GD_ERR_BREAK(m_cond)                                                                                          \
+	{                                                                                                                 \
+		if (m_cond) {                                                                                                 \
+			_err_print_error(FUNCTION_STR, __FILE__, __LINE__, "Condition ' " _STR(m_cond) " ' is true. Breaking..:"); \
+			OPCODE_BREAK;                                                                                             \
+		} else                                                                                                        \
+			_err_error_exists = false;                                                                                \
+	}
+
 Variant *GDFunction::_get_variant(int p_address, GDInstance *p_instance, GDScript *p_script, Variant &self, Variant *p_stack, String &r_error) const {
 
 	int address = p_address & ADDR_MASK;
@@ -78,6 +134,39 @@ Variant *GDFunction::_get_variant(int p_address, GDInstance *p_instance, GDScrip
 	return NULL;
 }
 
+Variant *GDFunction::_get_variant_fast(int p_address, Variant *const *p_bases, GDInstance *p_instance, GDScript *p_script, Variant &self, Variant *p_stack, String &r_error) const {
+
+	int type = (p_address & ADDR_TYPE_MASK) >> ADDR_BITS;
+
+#ifdef DEBUG_ENABLED
+	// same checks as _get_variant(), so bad code is reported instead of read out of bounds
+	Variant *base = type < ADDR_TYPE_MAX ? p_bases[type] : NULL;
+	if (base) {
+
+		int address = p_address & ADDR_MASK;
+		switch (type) {
+			case ADDR_TYPE_LOCAL_CONSTANT: {
+				ERR_FAIL_INDEX_V(address, _constant_count, NULL);
+			} break;
+			case ADDR_TYPE_STACK:
+			case ADDR_TYPE_STACK_VARIABLE: {
+				ERR_FAIL_INDEX_V(address, _stack_size, NULL);
+			} break;
+			default: {
+				return base; //self, class and nil, a single value
+			}
+		}
+		return &base[address];
+	}
+#else
+	Variant *base = p_bases[type];
+	if (base)
+		return &base[p_address & ADDR_MASK];
+#endif
+
+	return _get_variant(p_address, p_instance, p_script, self, p_stack, r_error);
+}
+
 String GDFunction::_get_call_error(const Variant::CallError &p_err, const String &p_where, const Variant **argptrs) const {
 
 	String err_text;
@@ -100,6 +189,18 @@ String GDFunction::_get_call_error(const Variant::CallError &p_err, const String
 	return err_text;
 }
 
+#ifdef DEBUG_ENABLED
+static String _get_operator_error(Variant::Operator p_op, const Variant *p_a, const Variant *p_b, const Variant &p_ret) {
+
+	if (p_ret.get_type() == Variant::STRING) {
+		//return a string when invalid with the error
+		return String(p_ret) + " in operator '" + Variant::get_operator_name(p_op) + "'.";
+	}
+
+	return "Invalid operands '" + Variant::get_type_name(p_a->get_type()) + "' and '" + Variant::get_type_name(p_b->get_type()) + "' in operator '" + Variant::get_operator_name(p_op) + "'.";
+}
+#endif
+
 static String _get_var_type(const Variant *p_type) {
 
 	String basestr;
@@ -242,22 +343,34 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 		GDScriptLanguage::get_singleton()->enter_function(p_instance, this, stack, &ip, &line);
 
 #define CHECK_SPACE(m_space) \
-	ERR_BREAK((ip + m_space) > _code_size)
+	GD_ERR_BREAK((ip + m_space) > _code_size)
 
-#define GET_VARIANT_PTR(m_v, m_code_ofs)                                                       \
-	Variant *m_v;                                                                              \
-	m_v = _get_variant(_code_ptr[ip + m_code_ofs], p_instance, _class, self, stack, err_text); \
-	if (!m_v)                                                                                  \
-		break;
+#define GET_VARIANT_PTR(m_v, m_code_ofs)                                                                          \
+	Variant *m_v;                                                                                                 \
+	m_v = _get_variant_fast(_code_ptr[ip + m_code_ofs], variant_bases, p_instance, _class, self, stack, err_text); \
+	if (!m_v)                                                                                                     \
+		OPCODE_BREAK;
 
 #else
 #define CHECK_SPACE(m_space)
 #define GET_VARIANT_PTR(m_v, m_code_ofs) \
 	Variant *m_v;                        \
-	m_v = _get_variant(_code_ptr[ip + m_code_ofs], p_instance, _class, self, stack, err_text);
+	m_v = _get_variant_fast(_code_ptr[ip + m_code_ofs], variant_bases, p_instance, _class, self, stack, err_text);
 
 #endif
 
+	// base pointers for the addressing modes that don't change during the call, the others are left NULL and go through _get_variant()
+	Variant *variant_bases[ADDR_TYPE_MAX];
+	variant_bases[ADDR_TYPE_SELF] = p_instance ? &self : NULL;
+	variant_bases[ADDR_TYPE_CLASS] = _class ? &_class->_static_ref : NULL;
+	variant_bases[ADDR_TYPE_MEMBER] = NULL; // members can be reloaded while running
+	variant_bases[ADDR_TYPE_CLASS_CONSTANT] = NULL;
+	variant_bases[ADDR_TYPE_LOCAL_CONSTANT] = _constants_ptr;
+	variant_bases[ADDR_TYPE_STACK] = stack;
+	variant_bases[ADDR_TYPE_STACK_VARIABLE] = stack;
+	variant_bases[ADDR_TYPE_GLOBAL] = NULL; // the global array grows when globals are added
+	variant_bases[ADDR_TYPE_NIL] = &nil;
+
 #ifdef DEBUG_ENABLED
 
 	uint64_t function_start_time;
@@ -271,24 +384,69 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 	}
 #endif
 	bool exit_ok = false;
+	int last_opcode = -1;
+
+#ifdef USE_COMPUTED_GOTO
+	static const void *opcode_table[] = {
+		&&OPCODE_OPERATOR,
+		&&OPCODE_EXTENDS_TEST,
+		&&OPCODE_SET,
+		&&OPCODE_GET,
+		&&OPCODE_SET_NAMED,
+		&&OPCODE_GET_NAMED,
+		&&OPCODE_ASSIGN,
+		&&OPCODE_ASSIGN_TRUE,
+		&&OPCODE_ASSIGN_FALSE,
+		&&OPCODE_CONSTRUCT,
+		&&OPCODE_CONSTRUCT_ARRAY,
+		&&OPCODE_CONSTRUCT_DICTIONARY,
+		&&OPCODE_CALL,
+		&&OPCODE_CALL_RETURN,
+		&&OPCODE_CALL_BUILT_IN,
+		&&OPCODE_CALL_SELF,
+		&&OPCODE_CALL_SELF_BASE,
+		&&OPCODE_YIELD,
+		&&OPCODE_YIELD_SIGNAL,
+		&&OPCODE_YIELD_RESUME,
+		&&OPCODE_JUMP,
+		&&OPCODE_JUMP_IF,
+		&&OPCODE_JUMP_IF_NOT,
+		&&OPCODE_JUMP_IF_NOT_COMPARE,
+		&&OPCODE_JUMP_TO_DEF_ARGUMENT,
+		&&OPCODE_RETURN,
+		&&OPCODE_ITERATE_BEGIN,
+		&&OPCODE_ITERATE,
+		&&OPCODE_ITERATE_RANGE_BEGIN,
+		&&OPCODE_ITERATE_RANGE,
+		&&OPCODE_ASSERT,
+		&&OPCODE_BREAKPOINT,
+		&&OPCODE_LINE,
+		&&OPCODE_END
+	};
+	(void)sizeof(char[(sizeof(opcode_table) / sizeof(opcode_table[0]) == OPCODE_MAX) ? 1 : -1]); //fails to compile if an opcode is missing
+#endif
 
-	while (ip < _code_size) {
+	OPCODE_WHILE(ip < _code_size) {
 
-		int last_opcode = _code_ptr[ip];
-		switch (_code_ptr[ip]) {
+		OPCODE_SWITCH(_code_ptr[ip]) {
 
-			case OPCODE_OPERATOR: {
+			OPCODE(OPCODE_OPERATOR) {
 
 				CHECK_SPACE(5);
 
 				bool valid;
 				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
-				ERR_BREAK(op >= Variant::OP_MAX);
+				GD_ERR_BREAK(op >= Variant::OP_MAX);
 
 				GET_VARIANT_PTR(a, 2);
 				GET_VARIANT_PTR(b, 3);
 				GET_VARIANT_PTR(dst, 4);
 
+				if (Variant::evaluate_numeric(op, *a, *b, *dst)) {
+					ip += 5;
+					DISPATCH_OPCODE;
+				}
+
 #ifdef DEBUG_ENABLED
 				Variant ret;
 				Variant::evaluate(op, *a, *b, ret, valid);
@@ -298,16 +456,9 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 				if (!valid) {
 #ifdef DEBUG_ENABLED
-
-					if (ret.get_type() == Variant::STRING) {
-						//return a string when invalid with the error
-						err_text = ret;
-						err_text += " in operator '" + Variant::get_operator_name(op) + "'.";
-					} else {
-						err_text = "Invalid operands '" + Variant::get_type_name(a->get_type()) + "' and '" + Variant::get_type_name(b->get_type()) + "' in operator '" + Variant::get_operator_name(op) + "'.";
-					}
+					err_text = _get_operator_error(op, a, b, ret);
 #endif
-					break;
+					OPCODE_BREAK;
 				}
 #ifdef DEBUG_ENABLED
 				*dst = ret;
@@ -315,8 +466,8 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 				ip += 5;
 			}
-				continue;
-			case OPCODE_EXTENDS_TEST: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_EXTENDS_TEST) {
 
 				CHECK_SPACE(4);
 
@@ -329,12 +480,12 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				if (a->get_type() != Variant::OBJECT || a->operator Object *() == NULL) {
 
 					err_text = "Left operand of 'extends' is not an instance of anything.";
-					break;
+					OPCODE_BREAK;
 				}
 				if (b->get_type() != Variant::OBJECT || b->operator Object *() == NULL) {
 
 					err_text = "Right operand of 'extends' is not a class.";
-					break;
+					OPCODE_BREAK;
 				}
 #endif
 
@@ -372,7 +523,7 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 					if (!nc) {
 
 						err_text = "Right operand of 'extends' is not a class (type: '" + obj_B->get_type() + "').";
-						break;
+						OPCODE_BREAK;
 					}
 
 					extends_ok = ObjectTypeDB::is_type(obj_A->get_type_name(), nc->get_name());
@@ -381,8 +532,8 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				*dst = extends_ok;
 				ip += 4;
 			}
-				continue;
-			case OPCODE_SET: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_SET) {
 
 				CHECK_SPACE(3);
 
@@ -401,13 +552,13 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 						v = "of type '" + _get_var_type(index) + "'";
 					}
 					err_text = "Invalid set index " + v + " (on base: '" + _get_var_type(dst) + "').";
-					break;
+					OPCODE_BREAK;
 				}
 
 				ip += 4;
 			}
-				continue;
-			case OPCODE_GET: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_GET) {
 
 				CHECK_SPACE(3);
 
@@ -431,15 +582,15 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 						v = "of type '" + _get_var_type(index) + "'";
 					}
 					err_text = "Invalid get index " + v + " (on base: '" + _get_var_type(src) + "').";
-					break;
+					OPCODE_BREAK;
 				}
 #ifdef DEBUG_ENABLED
 				*dst = ret;
 #endif
 				ip += 4;
 			}
-				continue;
-			case OPCODE_SET_NAMED: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_SET_NAMED) {
 
 				CHECK_SPACE(3);
 
@@ -448,7 +599,7 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 				int indexname = _code_ptr[ip + 2];
 
-				ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
 				bool valid;
@@ -457,13 +608,13 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				if (!valid) {
 					String err_type;
 					err_text = "Invalid set index '" + String(*index) + "' (on base: '" + _get_var_type(dst) + "').";
-					break;
+					OPCODE_BREAK;
 				}
 
 				ip += 4;
 			}
-				continue;
-			case OPCODE_GET_NAMED: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_GET_NAMED) {
 
 				CHECK_SPACE(3);
 
@@ -472,7 +623,7 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 				int indexname = _code_ptr[ip + 2];
 
-				ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
 				bool valid;
@@ -490,15 +641,15 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 					} else {
 						err_text = "Invalid get index '" + index->operator String() + "' (on base: '" + _get_var_type(src) + "').";
 					}
-					break;
+					OPCODE_BREAK;
 				}
 #ifdef DEBUG_ENABLED
 				*dst = ret;
 #endif
 				ip += 4;
 			}
-				continue;
-			case OPCODE_ASSIGN: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_ASSIGN) {
 
 				CHECK_SPACE(3);
 				GET_VARIANT_PTR(dst, 1);
@@ -508,8 +659,8 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 				ip += 3;
 			}
-				continue;
-			case OPCODE_ASSIGN_TRUE: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_ASSIGN_TRUE) {
 
 				CHECK_SPACE(2);
 				GET_VARIANT_PTR(dst, 1);
@@ -518,8 +669,8 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 				ip += 2;
 			}
-				continue;
-			case OPCODE_ASSIGN_FALSE: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_ASSIGN_FALSE) {
 
 				CHECK_SPACE(2);
 				GET_VARIANT_PTR(dst, 1);
@@ -528,8 +679,8 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 				ip += 2;
 			}
-				continue;
-			case OPCODE_CONSTRUCT: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_CONSTRUCT) {
 
 				CHECK_SPACE(2);
 				Variant::Type t = Variant::Type(_code_ptr[ip + 1]);
@@ -548,14 +699,14 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				if (err.error != Variant::CallError::CALL_OK) {
 
 					err_text = _get_call_error(err, "'" + Variant::get_type_name(t) + "' constructor", (const Variant **)argptrs);
-					break;
+					OPCODE_BREAK;
 				}
 
 				ip += 4 + argc;
 				//construct a basic type
 			}
-				continue;
-			case OPCODE_CONSTRUCT_ARRAY: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_CONSTRUCT_ARRAY) {
 
 				CHECK_SPACE(1);
 				int argc = _code_ptr[ip + 1];
@@ -574,8 +725,8 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 				ip += 3 + argc;
 			}
-				continue;
-			case OPCODE_CONSTRUCT_DICTIONARY: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_CONSTRUCT_DICTIONARY) {
 
 				CHECK_SPACE(1);
 				int argc = _code_ptr[ip + 1];
@@ -596,22 +747,25 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 				ip += 3 + argc * 2;
 			}
-				continue;
-			case OPCODE_CALL_RETURN:
-			case OPCODE_CALL: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_CALL_RETURN)
+			OPCODE(OPCODE_CALL) {
 
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 				bool call_ret = _code_ptr[ip] == OPCODE_CALL_RETURN;
 
 				int argc = _code_ptr[ip + 1];
 				GET_VARIANT_PTR(base, 2);
 				int nameg = _code_ptr[ip + 3];
 
-				ERR_BREAK(nameg < 0 || nameg >= _global_names_count);
+				GD_ERR_BREAK(nameg < 0 || nameg >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[nameg];
 
-				ERR_BREAK(argc < 0);
-				ip += 4;
+				int cacheg = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cacheg < 0 || cacheg >= _call_cache_count);
+
+				GD_ERR_BREAK(argc < 0);
+				ip += 5;
 				CHECK_SPACE(argc + 1);
 				Variant **argptrs = call_args;
 
@@ -629,13 +783,28 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 #endif
 				Variant::CallError err;
+				Variant *ret = NULL;
 				if (call_ret) {
 
-					GET_VARIANT_PTR(ret, argc);
-					base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
-				} else {
+					GET_VARIANT_PTR(v, argc);
+					ret = v;
+				}
+
+				const Variant::BuiltInMethod *method = NULL;
+				if (base->get_type() != Variant::OBJECT) {
 
-					base->call_ptr(*methodname, (const Variant **)argptrs, argc, NULL, err);
+					// inline cache, only refreshed when the base type changes
+					method = _call_cache_ptr[cacheg];
+					if (!method || method->base_type != base->get_type()) {
+						method = Variant::get_builtin_method(base->get_type(), *methodname);
+						_call_cache_ptr[cacheg] = method;
+					}
+				}
+
+				if (method) {
+					base->call_builtin(method, (const Variant **)argptrs, argc, ret, err);
+				} else {
+					base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
 				}
 #ifdef DEBUG_ENABLED
 				if (GDScriptLanguage::get_singleton()->profiling) {
@@ -662,29 +831,29 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 							if (base->is_ref()) {
 								err_text = "Attempted to free a reference.";
-								break;
+								OPCODE_BREAK;
 							} else if (base->get_type() == Variant::OBJECT) {
 
 								err_text = "Attempted to free a locked object (calling or emitting).";
-								break;
+								OPCODE_BREAK;
 							}
 						}
 					}
 					err_text = _get_call_error(err, "function '" + methodstr + "' in base '" + basestr + "'", (const Variant **)argptrs);
-					break;
+					OPCODE_BREAK;
 				}
 
 				//_call_func(NULL,base,*methodname,ip,argc,p_instance,stack);
 				ip += argc + 1;
 			}
-				continue;
-			case OPCODE_CALL_BUILT_IN: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_CALL_BUILT_IN) {
 
 				CHECK_SPACE(4);
 
 				GDFunctions::Function func = GDFunctions::Function(_code_ptr[ip + 1]);
 				int argc = _code_ptr[ip + 2];
-				ERR_BREAK(argc < 0);
+				GD_ERR_BREAK(argc < 0);
 
 				ip += 3;
 				CHECK_SPACE(argc + 1);
@@ -710,15 +879,15 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 					} else {
 						err_text = _get_call_error(err, "built-in function '" + methodstr + "'", (const Variant **)argptrs);
 					}
-					break;
+					OPCODE_BREAK;
 				}
 				ip += argc + 1;
 			}
-				continue;
-			case OPCODE_CALL_SELF: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_CALL_SELF) {
 
-			} break;
-			case OPCODE_CALL_SELF_BASE: {
+			} OPCODE_BREAK;
+			OPCODE(OPCODE_CALL_SELF_BASE) {
 
 				CHECK_SPACE(2);
 				int self_fun = _code_ptr[ip + 1];
@@ -727,7 +896,7 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				if (self_fun < 0 || self_fun >= _global_names_count) {
 
 					err_text = "compiler bug, function name not found";
-					break;
+					OPCODE_BREAK;
 				}
 #endif
 				const StringName *methodname = &_global_names_ptr[self_fun];
@@ -787,14 +956,14 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 					String methodstr = *methodname;
 					err_text = _get_call_error(err, "function '" + methodstr + "'", (const Variant **)argptrs);
 
-					break;
+					OPCODE_BREAK;
 				}
 
 				ip += 4 + argc;
 			}
-				continue;
-			case OPCODE_YIELD:
-			case OPCODE_YIELD_SIGNAL: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_YIELD)
+			OPCODE(OPCODE_YIELD_SIGNAL) {
 
 				int ipofs = 1;
 				if (_code_ptr[ip] == OPCODE_YIELD_SIGNAL) {
@@ -834,11 +1003,11 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 					if (argobj->get_type() != Variant::OBJECT) {
 						err_text = "First argument of yield() not of type object.";
-						break;
+						OPCODE_BREAK;
 					}
 					if (argname->get_type() != Variant::STRING) {
 						err_text = "Second argument of yield() not a string (for signal name).";
-						break;
+						OPCODE_BREAK;
 					}
 					Object *obj = argobj->operator Object *();
 					String signal = argname->operator String();
@@ -846,53 +1015,53 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 					if (!obj) {
 						err_text = "First argument of yield() is null.";
-						break;
+						OPCODE_BREAK;
 					}
 					if (ScriptDebugger::get_singleton()) {
 						if (!ObjectDB::instance_validate(obj)) {
 							err_text = "First argument of yield() is a previously freed instance.";
-							break;
+							OPCODE_BREAK;
 						}
 					}
 					if (signal.length() == 0) {
 
 						err_text = "Second argument of yield() is an empty string (for signal name).";
-						break;
+						OPCODE_BREAK;
 					}
 
 #endif
 					Error err = obj->connect(signal, gdfs.ptr(), "_signal_callback", varray(gdfs), Object::CONNECT_ONESHOT);
 					if (err != OK) {
 						err_text = "Error connecting to signal: " + signal + " during yield().";
-						break;
+						OPCODE_BREAK;
 					}
 				}
 
 				exit_ok = true;
 
-			} break;
-			case OPCODE_YIELD_RESUME: {
+			} OPCODE_BREAK;
+			OPCODE(OPCODE_YIELD_RESUME) {
 
 				CHECK_SPACE(2);
 				if (!p_state) {
 					err_text = ("Invalid Resume (bug?)");
-					break;
+					OPCODE_BREAK;
 				}
 				GET_VARIANT_PTR(result, 1);
 				*result = p_state->result;
 				ip += 2;
 			}
-				continue;
-			case OPCODE_JUMP: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_JUMP) {
 
 				CHECK_SPACE(2);
 				int to = _code_ptr[ip + 1];
 
-				ERR_BREAK(to < 0 || to > _code_size);
+				GD_ERR_BREAK(to < 0 || to > _code_size);
 				ip = to;
 			}
-				continue;
-			case OPCODE_JUMP_IF: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_JUMP_IF) {
 
 				CHECK_SPACE(3);
 
@@ -904,19 +1073,19 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				if (!valid) {
 
 					err_text = "cannot evaluate conditional expression of type: " + Variant::get_type_name(test->get_type());
-					break;
+					OPCODE_BREAK;
 				}
 #endif
 				if (result) {
 					int to = _code_ptr[ip + 2];
-					ERR_BREAK(to < 0 || to > _code_size);
+					GD_ERR_BREAK(to < 0 || to > _code_size);
 					ip = to;
-					continue;
+					DISPATCH_OPCODE;
 				}
 				ip += 3;
 			}
-				continue;
-			case OPCODE_JUMP_IF_NOT: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_JUMP_IF_NOT) {
 
 				CHECK_SPACE(3);
 
@@ -928,33 +1097,75 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				if (!valid) {
 
 					err_text = "cannot evaluate conditional expression of type: " + Variant::get_type_name(test->get_type());
-					break;
+					OPCODE_BREAK;
 				}
 #endif
 				if (!result) {
 					int to = _code_ptr[ip + 2];
-					ERR_BREAK(to < 0 || to > _code_size);
+					GD_ERR_BREAK(to < 0 || to > _code_size);
 					ip = to;
-					continue;
+					DISPATCH_OPCODE;
 				}
 				ip += 3;
 			}
-				continue;
-			case OPCODE_JUMP_TO_DEF_ARGUMENT: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_JUMP_IF_NOT_COMPARE) {
+
+				CHECK_SPACE(6);
+
+				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
+				GD_ERR_BREAK(op >= Variant::OP_MAX);
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+				GET_VARIANT_PTR(dst, 4);
+
+				bool valid;
+				if (!Variant::evaluate_numeric(op, *a, *b, *dst)) {
+
+					Variant ret;
+					Variant::evaluate(op, *a, *b, ret, valid);
+					if (!valid) {
+#ifdef DEBUG_ENABLED
+						err_text = _get_operator_error(op, a, b, ret);
+#endif
+						OPCODE_BREAK;
+					}
+					*dst = ret;
+				}
+
+				bool result = dst->booleanize(valid);
+#ifdef DEBUG_ENABLED
+				if (!valid) {
+
+					err_text = "cannot evaluate conditional expression of type: " + Variant::get_type_name(dst->get_type());
+					OPCODE_BREAK;
+				}
+#endif
+				if (!result) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+					DISPATCH_OPCODE;
+				}
+				ip += 6;
+			}
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_JUMP_TO_DEF_ARGUMENT) {
 
 				CHECK_SPACE(2);
 				ip = _default_arg_ptr[defarg];
 			}
-				continue;
-			case OPCODE_RETURN: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_RETURN) {
 
 				CHECK_SPACE(2);
 				GET_VARIANT_PTR(r, 1);
 				retvalue = *r;
 				exit_ok = true;
 
-			} break;
-			case OPCODE_ITERATE_BEGIN: {
+			} OPCODE_BREAK;
+			OPCODE(OPCODE_ITERATE_BEGIN) {
 
 				CHECK_SPACE(8); //space for this an regular iterate
 
@@ -965,25 +1176,25 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				if (!container->iter_init(*counter, valid)) {
 					if (!valid) {
 						err_text = "Unable to iterate on object of type  " + Variant::get_type_name(container->get_type()) + "'.";
-						break;
+						OPCODE_BREAK;
 					}
 					int jumpto = _code_ptr[ip + 3];
-					ERR_BREAK(jumpto < 0 || jumpto > _code_size);
+					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
-					continue;
+					DISPATCH_OPCODE;
 				}
 				GET_VARIANT_PTR(iterator, 4);
 
 				*iterator = container->iter_get(*counter, valid);
 				if (!valid) {
 					err_text = "Unable to obtain iterator object of type  " + Variant::get_type_name(container->get_type()) + "'.";
-					break;
+					OPCODE_BREAK;
 				}
 
 				ip += 5; //skip regular iterate which is always next
 			}
-				continue;
-			case OPCODE_ITERATE: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_ITERATE) {
 
 				CHECK_SPACE(4);
 
@@ -994,25 +1205,92 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				if (!container->iter_next(*counter, valid)) {
 					if (!valid) {
 						err_text = "Unable to iterate on object of type  " + Variant::get_type_name(container->get_type()) + "' (type changed since first iteration?).";
-						break;
+						OPCODE_BREAK;
 					}
 					int jumpto = _code_ptr[ip + 3];
-					ERR_BREAK(jumpto < 0 || jumpto > _code_size);
+					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
-					continue;
+					DISPATCH_OPCODE;
 				}
 				GET_VARIANT_PTR(iterator, 4);
 
 				*iterator = container->iter_get(*counter, valid);
 				if (!valid) {
 					err_text = "Unable to obtain iterator object of type  " + Variant::get_type_name(container->get_type()) + "' (but was obtained on first iteration?).";
-					break;
+					OPCODE_BREAK;
 				}
 
 				ip += 5; //loop again
 			}
-				continue;
-			case OPCODE_ASSERT: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_ITERATE_RANGE_BEGIN) {
+
+				CHECK_SPACE(12); //space for this and regular range iterate
+
+				GET_VARIANT_PTR(counter, 1);
+				GET_VARIANT_PTR(to, 2);
+				GET_VARIANT_PTR(step, 3);
+
+				if (!counter->is_num() || !to->is_num() || !step->is_num()) {
+					err_text = "Non-numeric argument in range() of for loop.";
+					OPCODE_BREAK;
+				}
+
+				int from = *counter;
+				int end = *to;
+				int incr = *step;
+				if (incr == 0) {
+					err_text = "Step argument of range() is zero.";
+					OPCODE_BREAK;
+				}
+
+				// everything is an int from here on, so ITERATE_RANGE always takes the fast path
+				*counter = from;
+				*to = end;
+				*step = incr;
+
+				if (incr > 0 ? from >= end : from <= end) {
+					int jumpto = _code_ptr[ip + 4];
+					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
+					ip = jumpto;
+					DISPATCH_OPCODE;
+				}
+				GET_VARIANT_PTR(iterator, 5);
+
+				*iterator = from;
+
+				ip += 6; //skip regular iterate which is always next
+			}
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_ITERATE_RANGE) {
+
+				CHECK_SPACE(6);
+
+				GET_VARIANT_PTR(counter, 1);
+				GET_VARIANT_PTR(to, 2);
+				GET_VARIANT_PTR(step, 3);
+
+				if (!Variant::evaluate_numeric(Variant::OP_ADD, *counter, *step, *counter)) {
+					err_text = "Range counter is not an int (bug?)";
+					OPCODE_BREAK;
+				}
+
+				int idx = *counter;
+				int end = *to;
+				if (int(*step) > 0 ? idx >= end : idx <= end) {
+					int jumpto = _code_ptr[ip + 4];
+					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
+					ip = jumpto;
+					DISPATCH_OPCODE;
+				}
+				GET_VARIANT_PTR(iterator, 5);
+
+				*iterator = idx;
+
+				ip += 6; //loop again
+			}
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_ASSERT) {
 				CHECK_SPACE(2);
 				GET_VARIANT_PTR(test, 1);
 
@@ -1023,21 +1301,21 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				if (!valid) {
 
 					err_text = "cannot evaluate conditional expression of type: " + Variant::get_type_name(test->get_type());
-					break;
+					OPCODE_BREAK;
 				}
 
 				if (!result) {
 
 					err_text = "Assertion failed.";
-					break;
+					OPCODE_BREAK;
 				}
 
 #endif
 
 				ip += 2;
 			}
-				continue;
-			case OPCODE_BREAKPOINT: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_BREAKPOINT) {
 #ifdef DEBUG_ENABLED
 				if (ScriptDebugger::get_singleton()) {
 					GDScriptLanguage::get_singleton()->debug_break("Breakpoint Statement", true);
@@ -1045,8 +1323,8 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 #endif
 				ip += 1;
 			}
-				continue;
-			case OPCODE_LINE: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_LINE) {
 				CHECK_SPACE(2);
 
 				line = _code_ptr[ip + 1];
@@ -1074,21 +1352,22 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 					ScriptDebugger::get_singleton()->line_poll();
 				}
 			}
-				continue;
-			case OPCODE_END: {
+				DISPATCH_OPCODE;
+			OPCODE(OPCODE_END) {
 
 				exit_ok = true;
-				break;
+				OPCODE_BREAK;
 
-			} break;
-			default: {
+			} OPCODE_BREAK;
+			OPCODE_DEFAULT {
 
 				err_text = "Illegal opcode " + itos(_code_ptr[ip]) + " at address " + itos(ip);
-			} break;
+			} OPCODE_BREAK;
 		}
 
+		OPCODES_END
 		if (exit_ok)
-			break;
+			OPCODE_OUT;
 		//error
 		// function, file, line, error, explanation
 		String err_file;
@@ -1112,8 +1391,9 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 			_err_print_error(err_func.utf8().get_data(), err_file.utf8().get_data(), err_line, err_text.utf8().get_data(), ERR_HANDLER_SCRIPT);
 		}
 
-		break;
+		OPCODE_OUT;
 	}
+	OPCODES_OUT
 
 #ifdef DEBUG_ENABLED
 	if (GDScriptLanguage::get_singleton()->profiling) {
@@ -1270,6 +1550,8 @@ GDFunction::GDFunction()
 
 	_stack_size = 0;
 	_call_size = 0;
+	_call_cache_ptr = NULL;
+	_call_cache_count = 0;
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
 	_func_cname = NULL;
@@ -37,14 +37,18 @@ public:
 		OPCODE_JUMP,
 		OPCODE_JUMP_IF,
 		OPCODE_JUMP_IF_NOT,
+		OPCODE_JUMP_IF_NOT_COMPARE, // OPCODE_OPERATOR + OPCODE_JUMP_IF_NOT on its result
 		OPCODE_JUMP_TO_DEF_ARGUMENT,
 		OPCODE_RETURN,
 		OPCODE_ITERATE_BEGIN,
 		OPCODE_ITERATE,
+		OPCODE_ITERATE_RANGE_BEGIN, // for in range(), without creating the array
+		OPCODE_ITERATE_RANGE,
 		OPCODE_ASSERT,
 		OPCODE_BREAKPOINT,
 		OPCODE_LINE,
-		OPCODE_END
+		OPCODE_END,
+		OPCODE_MAX
 	};
 
 	enum Address {
@@ -59,7 +63,8 @@ public:
 		ADDR_TYPE_STACK = 5,
 		ADDR_TYPE_STACK_VARIABLE = 6,
 		ADDR_TYPE_GLOBAL = 7,
-		ADDR_TYPE_NIL = 8
+		ADDR_TYPE_NIL = 8,
+		ADDR_TYPE_MAX = 9
 	};
 
 	struct StackDebug {
@@ -84,6 +89,8 @@ private:
 	int _default_arg_count;
 	const int *_code_ptr;
 	int _code_size;
+	const Variant::BuiltInMethod **_call_cache_ptr;
+	int _call_cache_count;
 	int _argument_count;
 	int _stack_size;
 	int _call_size;
@@ -96,6 +103,7 @@ private:
 	Vector<StringName> global_names;
 	Vector<int> default_arguments;
 	Vector<int> code;
+	Vector<const Variant::BuiltInMethod *> call_caches; // one per call site, filled on first call (or by the compiler if the base type is known)
 
 #ifdef TOOLS_ENABLED
 	Vector<StringName> arg_names;
@@ -104,6 +112,7 @@ private:
 	List<StackDebug> stack_debug;
 
 	_FORCE_INLINE_ Variant *_get_variant(int p_address, GDInstance *p_instance, GDScript *p_script, Variant &self, Variant *p_stack, String &r_error) const;
+	_FORCE_INLINE_ Variant *_get_variant_fast(int p_address, Variant *const *p_bases, GDInstance *p_instance, GDScript *p_script, Variant &self, Variant *p_stack, String &r_error) const;
 	_FORCE_INLINE_ String _get_call_error(const Variant::CallError &p_err, const String &p_where, const Variant **argptrs) const;
 
 	friend class GDScriptLanguage;
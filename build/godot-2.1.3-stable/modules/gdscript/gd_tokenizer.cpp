@@ -738,13 +738,16 @@ void GDTokenizerText::_advance() {
 				}
 
 				if (_is_text_char(GETCHAR(0))) {
-					// parse identifier
+					// parse identifier, hashing it along the way (same djb2 as String::hash()) so the StringName lookup doesn't walk it again
 					String str;
+					uint32_t hash = 5381;
 					str += CharType(GETCHAR(0));
+					hash = ((hash << 5) + hash) + GETCHAR(0);
 
 					int i = 1;
 					while (_is_text_char(GETCHAR(i))) {
 						str += CharType(GETCHAR(i));
+						hash = ((hash << 5) + hash) + GETCHAR(i);
 						i++;
 					}
 
@@ -901,7 +904,7 @@ void GDTokenizerText::_advance() {
 					}
 
 					if (identifier) {
-						_make_identifier(str);
+						_make_identifier(StringName(str, hash));
 					}
 					INCPOS(str.length());
 					return;
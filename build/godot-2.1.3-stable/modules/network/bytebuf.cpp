@@ -1,124 +1,560 @@
 #include "bytebuf.h"
 #include <io/marshalls.h>
 
-ByteBuf::ByteBuf() : Reference(), readIdx(0), writeIdx(0){
+ByteBuf::ByteBuf() : Reference(), readIdx(0), writeIdx(0), frameEnd(-1), big_endian(true) {
 
 }
 
 ByteBuf::~ByteBuf() {
 }
 
-void ByteBuf::write_byte(uint8_t p_val)
-{
-	data.push_back(p_val);
-	writeIdx += 1;
+uint8_t *ByteBuf::_reserve(int p_bytes) {
+
+	int needed = writeIdx + p_bytes;
+	if (needed > data.size()) {
+		// grow geometrically, a message is usually written field by field
+		data.resize(nearest_power_of_2(MAX(needed, 64)));
+	}
+
+	uint8_t *w = &data.ptr()[writeIdx];
+	writeIdx = needed;
+	return w;
 }
 
-uint8_t ByteBuf::read_byte()
-{
-	uint8_t * buf = &(data.write().ptr()[readIdx]);
-	readIdx += 1;
+const uint8_t *ByteBuf::_consume(int p_bytes) {
+
+	ERR_FAIL_COND_V(p_bytes < 0 || readIdx + p_bytes > writeIdx, NULL);
 
-	return buf[0];
+	const uint8_t *r = &data.ptr()[readIdx];
+	readIdx += p_bytes;
+	return r;
 }
 
-void ByteBuf::write_i32(int32_t p_val)
-{
-	//big_endian
-	data.resize(data.size()+4);
-	p_val = BSWAP32(p_val);
-	encode_uint32(p_val, &(data.write().ptr()[writeIdx]));
-	writeIdx += 4;
+void ByteBuf::_put_u32(uint8_t *p_dst, uint32_t p_val) const {
+
+	encode_uint32(big_endian ? BSWAP32(p_val) : p_val, p_dst);
 }
 
-int32_t ByteBuf::read_i32()
-{
-	uint32_t r = decode_uint32(&(data.write().ptr()[readIdx]));
-	r = BSWAP32(r);
-	readIdx += 4;
+uint32_t ByteBuf::_get_u32(const uint8_t *p_src) const {
 
-	return r;
+	uint32_t r = decode_uint32(p_src);
+	return big_endian ? BSWAP32(r) : r;
 }
 
-void ByteBuf::write_i64(int64_t p_val)
-{
-	//big_endian
-	data.resize(data.size()+8);
-	p_val = BSWAP64(p_val);
-	encode_uint64(p_val, &(data.write().ptr()[writeIdx]));
-	writeIdx += 8;
+void ByteBuf::_put_u64(uint8_t *p_dst, uint64_t p_val) const {
+
+	encode_uint64(big_endian ? BSWAP64(p_val) : p_val, p_dst);
 }
 
-int64_t ByteBuf::read_i64()
-{
-	uint64_t r = decode_uint64(&(data.write().ptr()[readIdx]));
-	r = BSWAP64(r);
-	readIdx += 8;
+uint64_t ByteBuf::_get_u64(const uint8_t *p_src) const {
 
-	return r;
+	uint64_t r = decode_uint64(p_src);
+	return big_endian ? BSWAP64(r) : r;
+}
+
+void ByteBuf::set_big_endian(bool p_enable) {
+
+	big_endian = p_enable;
+}
+
+bool ByteBuf::is_big_endian_enabled() const {
+
+	return big_endian;
+}
+
+void ByteBuf::write_byte(uint8_t p_val) {
+
+	*_reserve(1) = p_val;
+}
+
+uint8_t ByteBuf::read_byte() {
+
+	const uint8_t *r = _consume(1);
+	ERR_FAIL_COND_V(!r, 0);
+	return *r;
+}
+
+void ByteBuf::write_i16(int16_t p_val) {
+
+	uint16_t v = big_endian ? BSWAP16(p_val) : p_val;
+	encode_uint16(v, _reserve(2));
+}
+
+int16_t ByteBuf::read_i16() {
+
+	const uint8_t *r = _consume(2);
+	ERR_FAIL_COND_V(!r, 0);
+	uint16_t v = decode_uint16(r);
+	return big_endian ? BSWAP16(v) : v;
+}
+
+void ByteBuf::write_i32(int32_t p_val) {
+
+	_put_u32(_reserve(4), p_val);
+}
+
+int32_t ByteBuf::read_i32() {
+
+	const uint8_t *r = _consume(4);
+	ERR_FAIL_COND_V(!r, 0);
+	return _get_u32(r);
+}
+
+void ByteBuf::write_i64(int64_t p_val) {
+
+	_put_u64(_reserve(8), p_val);
+}
+
+int64_t ByteBuf::read_i64() {
+
+	const uint8_t *r = _consume(8);
+	ERR_FAIL_COND_V(!r, 0);
+	return _get_u64(r);
 }
 
 void ByteBuf::write_float(float p_val) {
 
-	data.resize(data.size() + 4);
-	encode_float(p_val, &(data.write().ptr()[writeIdx]));
-	if (true) {
-		uint32_t *p32 = (uint32_t *)&(data.write().ptr()[writeIdx]);
-		*p32 = BSWAP32(*p32);
+	MarshallFloat mf;
+	mf.f = p_val;
+	_put_u32(_reserve(4), mf.i);
+}
+
+float ByteBuf::read_float() {
+
+	const uint8_t *r = _consume(4);
+	ERR_FAIL_COND_V(!r, 0);
+	MarshallFloat mf;
+	mf.i = _get_u32(r);
+	return mf.f;
+}
+
+void ByteBuf::write_double(double p_val) {
+
+	MarshallDouble md;
+	md.d = p_val;
+	_put_u64(_reserve(8), md.l);
+}
+
+double ByteBuf::read_double() {
+
+	const uint8_t *r = _consume(8);
+	ERR_FAIL_COND_V(!r, 0);
+	MarshallDouble md;
+	md.l = _get_u64(r);
+	return md.d;
+}
+
+void ByteBuf::write_string(const String &p_str) {
+
+	// i32 byte length followed by the UTF-8 bytes, no terminator
+	CharString utf8 = p_str.utf8();
+	int len = utf8.length();
+	write_i32(len);
+	write_raw((const uint8_t *)utf8.get_data(), len);
+}
+
+String ByteBuf::read_string() {
+
+	int32_t len = read_i32();
+	ERR_FAIL_COND_V(len < 0, String());
+	if (len == 0)
+		return String();
+
+	const uint8_t *r = _consume(len);
+	ERR_FAIL_COND_V(!r, String());
+
+	String s;
+	s.parse_utf8((const char *)r, len);
+	return s;
+}
+
+void ByteBuf::write_raw(const uint8_t *p_data, int p_bytes) {
+
+	ERR_FAIL_COND(p_bytes < 0);
+	if (p_bytes == 0)
+		return;
+	copymem(_reserve(p_bytes), p_data, p_bytes);
+}
+
+Error ByteBuf::read_raw(uint8_t *p_data, int p_bytes) {
+
+	const uint8_t *r = _consume(p_bytes);
+	ERR_FAIL_COND_V(!r, ERR_FILE_EOF);
+	copymem(p_data, r, p_bytes);
+	return OK;
+}
+
+void ByteBuf::write_bytes(const DVector<uint8_t> &p_bytes) {
+
+	int len = p_bytes.size();
+	if (len == 0)
+		return;
+
+	DVector<uint8_t>::Read r = p_bytes.read();
+	write_raw(r.ptr(), len);
+}
+
+DVector<uint8_t> ByteBuf::read_bytes(int p_count) {
+
+	DVector<uint8_t> ret;
+	ERR_FAIL_COND_V(p_count < 0, ret);
+	if (p_count == 0)
+		return ret;
+
+	const uint8_t *r = _consume(p_count);
+	ERR_FAIL_COND_V(!r, ret);
+
+	ret.resize(p_count);
+	DVector<uint8_t>::Write w = ret.write();
+	copymem(w.ptr(), r, p_count);
+	return ret;
+}
+
+void ByteBuf::write_i32_array(const DVector<int> &p_values) {
+
+	int count = p_values.size();
+	if (count == 0)
+		return;
+
+	DVector<int>::Read r = p_values.read();
+	uint8_t *w = _reserve(count * 4);
+	for (int i = 0; i < count; i++) {
+		_put_u32(&w[i * 4], r[i]);
+	}
+}
+
+DVector<int> ByteBuf::read_i32_array(int p_count) {
+
+	DVector<int> ret;
+	ERR_FAIL_COND_V(p_count < 0, ret);
+	if (p_count == 0)
+		return ret;
+
+	const uint8_t *r = _consume(p_count * 4);
+	ERR_FAIL_COND_V(!r, ret);
+
+	ret.resize(p_count);
+	DVector<int>::Write w = ret.write();
+	for (int i = 0; i < p_count; i++) {
+		w[i] = (int32_t)_get_u32(&r[i * 4]);
 	}
+	return ret;
+}
+
+void ByteBuf::write_float_array(const DVector<real_t> &p_values) {
+
+	int count = p_values.size();
+	if (count == 0)
+		return;
 
-	writeIdx += 4;
+	DVector<real_t>::Read r = p_values.read();
+	uint8_t *w = _reserve(count * 4);
+	for (int i = 0; i < count; i++) {
+		MarshallFloat mf;
+		mf.f = r[i];
+		_put_u32(&w[i * 4], mf.i);
+	}
 }
 
-float ByteBuf::read_float() {
-	uint8_t * buf = &(data.write().ptr()[readIdx]);
-	if (true) {
-		uint32_t *p32 = (uint32_t *)buf;
-		*p32 = BSWAP32(*p32);
+DVector<real_t> ByteBuf::read_float_array(int p_count) {
+
+	DVector<real_t> ret;
+	ERR_FAIL_COND_V(p_count < 0, ret);
+	if (p_count == 0)
+		return ret;
+
+	const uint8_t *r = _consume(p_count * 4);
+	ERR_FAIL_COND_V(!r, ret);
+
+	ret.resize(p_count);
+	DVector<real_t>::Write w = ret.write();
+	for (int i = 0; i < p_count; i++) {
+		MarshallFloat mf;
+		mf.i = _get_u32(&r[i * 4]);
+		w[i] = mf.f;
 	}
+	return ret;
+}
 
-	float r = decode_float(buf);
-	readIdx += 4;
-	return r;
+void ByteBuf::seek(int p_pos) {
+
+	ERR_FAIL_INDEX(p_pos, writeIdx + 1);
+	readIdx = p_pos;
 }
 
-void ByteBuf::write_string(const String& str)
-{
-	int size = str.length();
-	write_i32(size);
+void ByteBuf::clear() {
 
-	for(int i=0; i<size; i++)
-		write_byte(str[i]);
+	readIdx = 0;
+	writeIdx = 0;
+	frameEnd = -1;
 }
-    
-String ByteBuf::read_string()
-{
-	char result[2048];
 
-	int32_t size = read_i32();
-	for(int i=0; i<size; i++)
-		result[i] = read_byte();
+void ByteBuf::compact() {
 
-	result[size] = '\0';
+	// drop the bytes already read, keeping the allocation
+	ERR_FAIL_COND(frameEnd >= 0);
+	if (readIdx == 0)
+		return;
 
-	return result;
+	int remaining = writeIdx - readIdx;
+	if (remaining > 0) {
+		uint8_t *w = data.ptr();
+		movemem(w, &w[readIdx], remaining);
+	}
+	readIdx = 0;
+	writeIdx = remaining;
 }
 
-DVector<uint8_t>& ByteBuf::raw_data()
-{
-	return data;
+void ByteBuf::reserve(int p_capacity) {
+
+	if (p_capacity > data.size())
+		data.resize(p_capacity);
 }
 
-void ByteBuf::_bind_methods() 
+DVector<uint8_t> ByteBuf::raw_data() const {
+
+	DVector<uint8_t> ret;
+	ret.resize(writeIdx);
+	if (writeIdx) {
+		DVector<uint8_t>::Write w = ret.write();
+		copymem(w.ptr(), data.ptr(), writeIdx);
+	}
+	return ret;
+}
+
+Error ByteBuf::send(const Ref<StreamPeer> &p_stream) const {
+
+	// hand the buffer straight to the peer, no intermediate ByteArray
+	ERR_FAIL_COND_V(p_stream.is_null(), ERR_INVALID_PARAMETER);
+	if (writeIdx == 0)
+		return OK;
+
+	Ref<StreamPeer> stream = p_stream;
+	return stream->put_data(data.ptr(), writeIdx);
+}
+
+int ByteBuf::receive(const Ref<StreamPeer> &p_stream) {
+
+	ERR_FAIL_COND_V(p_stream.is_null(), 0);
+
+	Ref<StreamPeer> stream = p_stream;
+	int avail = stream->get_available_bytes();
+	if (avail <= 0)
+		return 0;
+
+	if (frameEnd < 0)
+		compact();
+
+	int start = writeIdx;
+	uint8_t *w = _reserve(avail);
+	int received = 0;
+	Error err = stream->get_partial_data(w, avail, received);
+	writeIdx = start + (err == OK ? received : 0);
+	return writeIdx - start;
+}
+
+void ByteBuf::feed(const DVector<uint8_t> &p_bytes) {
+
+	if (frameEnd < 0)
+		compact();
+	write_bytes(p_bytes);
+}
+
+int ByteBuf::begin_frame() {
+
+	// returns the id of the next complete frame and leaves the read cursor
+	// at its payload, or -1 (cursor untouched) if more data is needed
+	ERR_FAIL_COND_V(frameEnd >= 0, -1);
+
+	int avail = writeIdx - readIdx;
+	if (avail < FRAME_HEADER_SIZE)
+		return -1;
+
+	const uint8_t *r = &data.ptr()[readIdx];
+	int id = (int32_t)_get_u32(r);
+	int len = (int32_t)_get_u32(&r[4]);
+
+	if (len < 0) {
+		clear();
+		ERR_EXPLAIN("Malformed frame: negative payload length");
+		ERR_FAIL_V(-1);
+	}
+
+	if (avail < FRAME_HEADER_SIZE + len + FRAME_TRAILER_SIZE)
+		return -1;
+
+	const uint8_t *trailer = &r[FRAME_HEADER_SIZE + len];
+	if (trailer[0] != FRAME_TRAILER_BYTE || trailer[1] != FRAME_TRAILER_BYTE) {
+		clear();
+		ERR_EXPLAIN("Malformed frame: missing '@@' delimiter");
+		ERR_FAIL_V(-1);
+	}
+
+	readIdx += FRAME_HEADER_SIZE;
+	frameEnd = readIdx + len + FRAME_TRAILER_SIZE;
+	return id;
+}
+
+void ByteBuf::end_frame() {
+
+	// skip whatever the payload reader left behind, plus the delimiter
+	ERR_FAIL_COND(frameEnd < 0);
+	readIdx = frameEnd;
+	frameEnd = -1;
+	compact();
+}
+
+Error ByteBuf::_write_field(const String &p_type, const Variant &p_value) {
+
+	if (p_type == "int") {
+		write_i32(p_value);
+	} else if (p_type == "long") {
+		write_i64(p_value);
+	} else if (p_type == "float") {
+		write_float(p_value);
+	} else if (p_type == "string") {
+		write_string(p_value);
+	} else {
+		ERR_EXPLAIN("Unknown protocol field type: " + p_type);
+		ERR_FAIL_V(ERR_INVALID_PARAMETER);
+	}
+	return OK;
+}
+
+Variant ByteBuf::_read_field(const String &p_type) {
+
+	if (p_type == "int") {
+		return read_i32();
+	} else if (p_type == "long") {
+		return read_i64();
+	} else if (p_type == "float") {
+		return read_float();
+	} else if (p_type == "string") {
+		return read_string();
+	}
+
+	ERR_EXPLAIN("Unknown protocol field type: " + p_type);
+	ERR_FAIL_V(Variant());
+}
+
+Error ByteBuf::write_message(int p_id, const Array &p_fields, const Variant &p_source) {
+
+	ERR_FAIL_COND_V(p_fields.size() % 2, ERR_INVALID_PARAMETER);
+
+	Object *obj = NULL;
+	Dictionary dict;
+	if (p_source.get_type() == Variant::OBJECT) {
+		obj = p_source;
+		ERR_FAIL_COND_V(!obj, ERR_INVALID_PARAMETER);
+	} else {
+		ERR_FAIL_COND_V(p_source.get_type() != Variant::DICTIONARY, ERR_INVALID_PARAMETER);
+		dict = p_source;
+	}
+
+	int start = writeIdx;
+	write_i32(p_id);
+	write_i32(0); // payload length, patched below
+
+	for (int i = 0; i < p_fields.size(); i += 2) {
+
+		String name = p_fields[i];
+		Variant value;
+		if (obj) {
+			bool valid = false;
+			value = obj->get(name, &valid);
+			if (!valid) {
+				writeIdx = start;
+				ERR_EXPLAIN("Protocol field not found in source object: " + name);
+				ERR_FAIL_V(ERR_INVALID_DATA);
+			}
+		} else {
+			if (!dict.has(name)) {
+				writeIdx = start;
+				ERR_EXPLAIN("Protocol field not found in source dictionary: " + name);
+				ERR_FAIL_V(ERR_INVALID_DATA);
+			}
+			value = dict[name];
+		}
+
+		Error err = _write_field(p_fields[i + 1], value);
+		if (err != OK) {
+			writeIdx = start;
+			return err;
+		}
+	}
+
+	_put_u32(&data.ptr()[start + 4], writeIdx - start - FRAME_HEADER_SIZE);
+
+	uint8_t *w = _reserve(FRAME_TRAILER_SIZE);
+	w[0] = FRAME_TRAILER_BYTE;
+	w[1] = FRAME_TRAILER_BYTE;
+	return OK;
+}
+
+Dictionary ByteBuf::read_message(const Array &p_fields) {
+
+	Dictionary ret;
+	ERR_FAIL_COND_V(p_fields.size() % 2, ret);
+
+	for (int i = 0; i < p_fields.size(); i += 2) {
+		ret[p_fields[i]] = _read_field(p_fields[i + 1]);
+	}
+	return ret;
+}
+
+Error ByteBuf::read_message_into(const Array &p_fields, Object *p_target) {
+
+	ERR_FAIL_COND_V(!p_target, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(p_fields.size() % 2, ERR_INVALID_PARAMETER);
+
+	for (int i = 0; i < p_fields.size(); i += 2) {
+		p_target->set(String(p_fields[i]), _read_field(p_fields[i + 1]));
+	}
+	return OK;
+}
+
+void ByteBuf::_bind_methods()
 {
+	ObjectTypeDB::bind_method(_MD("set_big_endian", "enable"), &ByteBuf::set_big_endian);
+	ObjectTypeDB::bind_method(_MD("is_big_endian_enabled"), &ByteBuf::is_big_endian_enabled);
+
 	ObjectTypeDB::bind_method(_MD("write_byte", "byte"), &ByteBuf::write_byte);
-    ObjectTypeDB::bind_method(_MD("write_i32", "value"), &ByteBuf::write_i32);
+	ObjectTypeDB::bind_method(_MD("read_byte"), &ByteBuf::read_byte);
+	ObjectTypeDB::bind_method(_MD("write_i16", "value"), &ByteBuf::write_i16);
+	ObjectTypeDB::bind_method(_MD("read_i16"), &ByteBuf::read_i16);
+	ObjectTypeDB::bind_method(_MD("write_i32", "value"), &ByteBuf::write_i32);
 	ObjectTypeDB::bind_method(_MD("read_i32"), &ByteBuf::read_i32);
 	ObjectTypeDB::bind_method(_MD("write_i64", "value"), &ByteBuf::write_i64);
 	ObjectTypeDB::bind_method(_MD("read_i64"), &ByteBuf::read_i64);
 	ObjectTypeDB::bind_method(_MD("write_float", "value"), &ByteBuf::write_float);
 	ObjectTypeDB::bind_method(_MD("read_float"), &ByteBuf::read_float);
+	ObjectTypeDB::bind_method(_MD("write_double", "value"), &ByteBuf::write_double);
+	ObjectTypeDB::bind_method(_MD("read_double"), &ByteBuf::read_double);
 	ObjectTypeDB::bind_method(_MD("write_string", "value"), &ByteBuf::write_string);
 	ObjectTypeDB::bind_method(_MD("read_string"), &ByteBuf::read_string);
-    ObjectTypeDB::bind_method(_MD("raw_data"), &ByteBuf::raw_data);
+	ObjectTypeDB::bind_method(_MD("write_bytes", "bytes"), &ByteBuf::write_bytes);
+	ObjectTypeDB::bind_method(_MD("read_bytes", "count"), &ByteBuf::read_bytes);
+	ObjectTypeDB::bind_method(_MD("write_i32_array", "values"), &ByteBuf::write_i32_array);
+	ObjectTypeDB::bind_method(_MD("read_i32_array", "count"), &ByteBuf::read_i32_array);
+	ObjectTypeDB::bind_method(_MD("write_float_array", "values"), &ByteBuf::write_float_array);
+	ObjectTypeDB::bind_method(_MD("read_float_array", "count"), &ByteBuf::read_float_array);
+
+	ObjectTypeDB::bind_method(_MD("get_size"), &ByteBuf::get_size);
+	ObjectTypeDB::bind_method(_MD("get_available"), &ByteBuf::get_available);
+	ObjectTypeDB::bind_method(_MD("get_read_pos"), &ByteBuf::get_read_pos);
+	ObjectTypeDB::bind_method(_MD("seek", "pos"), &ByteBuf::seek);
+	ObjectTypeDB::bind_method(_MD("clear"), &ByteBuf::clear);
+	ObjectTypeDB::bind_method(_MD("compact"), &ByteBuf::compact);
+	ObjectTypeDB::bind_method(_MD("reserve", "capacity"), &ByteBuf::reserve);
+	ObjectTypeDB::bind_method(_MD("raw_data"), &ByteBuf::raw_data);
+
+	ObjectTypeDB::bind_method(_MD("send", "stream:StreamPeer"), &ByteBuf::send);
+	ObjectTypeDB::bind_method(_MD("receive", "stream:StreamPeer"), &ByteBuf::receive);
+	ObjectTypeDB::bind_method(_MD("feed", "bytes"), &ByteBuf::feed);
+	ObjectTypeDB::bind_method(_MD("begin_frame"), &ByteBuf::begin_frame);
+	ObjectTypeDB::bind_method(_MD("end_frame"), &ByteBuf::end_frame);
+
+	ObjectTypeDB::bind_method(_MD("write_message", "id", "fields", "source"), &ByteBuf::write_message);
+	ObjectTypeDB::bind_method(_MD("read_message", "fields"), &ByteBuf::read_message);
+	ObjectTypeDB::bind_method(_MD("read_message_into", "fields", "target"), &ByteBuf::read_message_into);
 }
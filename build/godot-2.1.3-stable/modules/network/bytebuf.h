@@ -5,40 +5,112 @@
 #include <dvector.h>
 #include <io/stream_peer.h>
 
-// C++ wrapper for ByteBuf
-class ByteBuf : public Reference 
+// Growable byte buffer used by the generated protocol scripts.
+//
+// Writes append at the write cursor, reads consume from the read cursor.
+// Multi-byte values are big endian by default, which is what the server
+// (Netty ByteBuf) expects on the wire.
+//
+// Frames use the layout emitted by protocol/gen_protocol.py:
+//
+//   i32 id, i32 payload length, payload, '@', '@'
+//
+// write_message()/read_message() encode or decode a whole frame payload
+// from a flat field schema: [ "name", "type", "name", "type", ... ] where
+// type is one of the .proto types ("int", "long", "float", "string").
+class ByteBuf : public Reference
 {
-    OBJ_TYPE(ByteBuf, Reference)
+	OBJ_TYPE(ByteBuf, Reference)
 
 public:
-    ByteBuf();
-    ~ByteBuf();
+	enum {
+		FRAME_HEADER_SIZE = 8,
+		FRAME_TRAILER_SIZE = 2,
+		FRAME_TRAILER_BYTE = '@',
+	};
+
+private:
+	Vector<uint8_t> data; // data.size() is the capacity
+	int readIdx;
+	int writeIdx;
+	int frameEnd;
+	bool big_endian;
+
+	_FORCE_INLINE_ uint8_t *_reserve(int p_bytes);
+	_FORCE_INLINE_ const uint8_t *_consume(int p_bytes);
+
+	_FORCE_INLINE_ void _put_u32(uint8_t *p_dst, uint32_t p_val) const;
+	_FORCE_INLINE_ uint32_t _get_u32(const uint8_t *p_src) const;
+	_FORCE_INLINE_ void _put_u64(uint8_t *p_dst, uint64_t p_val) const;
+	_FORCE_INLINE_ uint64_t _get_u64(const uint8_t *p_src) const;
+
+	Error _write_field(const String &p_type, const Variant &p_value);
+	Variant _read_field(const String &p_type);
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_big_endian(bool p_enable);
+	bool is_big_endian_enabled() const;
 
 	void write_byte(uint8_t p_val);
-    uint8_t read_byte(); 
+	uint8_t read_byte();
+
+	void write_i16(int16_t p_val);
+	int16_t read_i16();
 
-    void write_i32(int32_t p_val);
-    int32_t read_i32();
+	void write_i32(int32_t p_val);
+	int32_t read_i32();
 
-    void write_i64(int64_t p_val);
-    int64_t read_i64();
+	void write_i64(int64_t p_val);
+	int64_t read_i64();
 
 	void write_float(float p_val);
 	float read_float();
 
-    void write_string(const String& str);
-    String read_string();
+	void write_double(double p_val);
+	double read_double();
 
-	DVector<uint8_t>& raw_data();
+	void write_string(const String &p_str);
+	String read_string();
 
-protected:
-    static void _bind_methods();
+	void write_bytes(const DVector<uint8_t> &p_bytes);
+	DVector<uint8_t> read_bytes(int p_count);
 
-    int     readIdx;
-    int     writeIdx;
-	DVector<uint8_t> data;
-};
+	void write_i32_array(const DVector<int> &p_values);
+	DVector<int> read_i32_array(int p_count);
+
+	void write_float_array(const DVector<real_t> &p_values);
+	DVector<real_t> read_float_array(int p_count);
+
+	void write_raw(const uint8_t *p_data, int p_bytes);
+	Error read_raw(uint8_t *p_data, int p_bytes);
+
+	int get_size() const { return writeIdx; }
+	int get_available() const { return writeIdx - readIdx; }
+	int get_read_pos() const { return readIdx; }
+	void seek(int p_pos);
+	void clear();
+	void compact();
+	void reserve(int p_capacity);
 
-#endif // OPENSIMPLEX_NOISE_H
+	const uint8_t *ptr() const { return data.ptr(); }
+	DVector<uint8_t> raw_data() const;
 
+	Error send(const Ref<StreamPeer> &p_stream) const;
+	int receive(const Ref<StreamPeer> &p_stream);
+	void feed(const DVector<uint8_t> &p_bytes);
+
+	int begin_frame();
+	void end_frame();
+
+	Error write_message(int p_id, const Array &p_fields, const Variant &p_source);
+	Dictionary read_message(const Array &p_fields);
+	Error read_message_into(const Array &p_fields, Object *p_target);
+
+	ByteBuf();
+	~ByteBuf();
+};
 
+#endif // BYTE_BUF_H
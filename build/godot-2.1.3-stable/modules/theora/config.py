@@ -4,4 +4,5 @@ def can_build(platform):
 
 
 def configure(env):
-    pass
+    # lets main/tests reach the yuv converters
+    env.Append(CPPFLAGS=['-DTHEORA_ENABLED'])
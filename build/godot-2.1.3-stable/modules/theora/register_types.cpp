@@ -29,6 +29,7 @@
 /*************************************************************************/
 #include "register_types.h"
 
+#include "globals.h"
 #include "video_stream_theora.h"
 
 static ResourceFormatLoaderVideoStreamTheora *theora_stream_loader = NULL;
@@ -38,6 +39,9 @@ void register_theora_types() {
 	theora_stream_loader = memnew(ResourceFormatLoaderVideoStreamTheora);
 	ResourceLoader::add_resource_format_loader(theora_stream_loader);
 	ObjectTypeDB::register_type<VideoStreamTheora>();
+
+	GLOBAL_DEF("render/theora_decode_thread", true);
+	GLOBAL_DEF("render/theora_planar_yuv", false);
 }
 
 void unregister_theora_types() {
@@ -32,36 +32,15 @@
 #include "globals.h"
 #include "os/os.h"
 #include "yuv2rgb.h"
+#include "yuv2rgb_simd.h"
 
 int VideoStreamPlaybackTheora::buffer_data() {
 
 	char *buffer = ogg_sync_buffer(&oy, 4096);
 
-#ifdef THEORA_USE_THREAD_STREAMING
-
-	int read;
-
-	do {
-		thread_sem->post();
-		read = MIN(ring_buffer.data_left(), 4096);
-		if (read) {
-			ring_buffer.read((uint8_t *)buffer, read);
-			ogg_sync_wrote(&oy, read);
-		} else {
-			OS::get_singleton()->delay_usec(100);
-		}
-
-	} while (read == 0);
-
-	return read;
-
-#else
-
 	int bytes = file->get_buffer((uint8_t *)buffer, 4096);
 	ogg_sync_wrote(&oy, bytes);
 	return (bytes);
-
-#endif
 }
 
 int VideoStreamPlaybackTheora::queue_page(ogg_page *page) {
@@ -78,164 +57,80 @@ int VideoStreamPlaybackTheora::queue_page(ogg_page *page) {
 	return 0;
 }
 
-void VideoStreamPlaybackTheora::video_write(void) {
-	th_ycbcr_buffer yuv;
-	th_decode_ycbcr_out(td, yuv);
-
-	/*
-	int y_offset, uv_offset;
-	y_offset=(ti.pic_x&~1)+yuv[0].stride*(ti.pic_y&~1);
-
-	{
-		int pixels = size.x * size.y;
-		frame_data.resize(pixels * 4);
-		DVector<uint8_t>::Write w = frame_data.write();
-		char* dst = (char*)w.ptr();
-		int p = 0;
-		for (int i=0; i<size.y; i++) {
-
-			char *in_y  = (char *)yuv[0].data+y_offset+yuv[0].stride*i;
-			char *out = dst + (int)size.x * 4 * i;
-			for (int j=0;j<size.x;j++) {
-
-				dst[p++] = in_y[j];
-				dst[p++] = in_y[j];
-				dst[p++] = in_y[j];
-				dst[p++] = 255;
-			};
-		}
-		format = Image::FORMAT_RGBA;
-	}
-	//	*/
-
-	//*
-
-	int pitch = 4;
-	frame_data.resize(size.x * size.y * pitch);
-	{
-		DVector<uint8_t>::Write w = frame_data.write();
-		char *dst = (char *)w.ptr();
-
-		//uv_offset=(ti.pic_x/2)+(yuv[1].stride)*(ti.pic_y/2);
+static void _copy_plane(DVector<uint8_t> &r_dst, const th_img_plane &p_plane, int p_width, int p_height) {
 
-		if (px_fmt == TH_PF_444) {
+	r_dst.resize(p_width * p_height);
+	DVector<uint8_t>::Write w = r_dst.write();
 
-			yuv444_2_rgb8888((uint8_t *)dst, (uint8_t *)yuv[0].data, (uint8_t *)yuv[1].data, (uint8_t *)yuv[2].data, size.x, size.y, yuv[0].stride, yuv[1].stride, size.x << 2, 0);
+	for (int i = 0; i < p_height; i++) {
+		copymem(&w[i * p_width], p_plane.data + i * p_plane.stride, p_width);
+	}
+}
 
-		} else if (px_fmt == TH_PF_422) {
+void VideoStreamPlaybackTheora::convert_frame(Frame &r_frame) {
 
-			yuv422_2_rgb8888((uint8_t *)dst, (uint8_t *)yuv[0].data, (uint8_t *)yuv[1].data, (uint8_t *)yuv[2].data, size.x, size.y, yuv[0].stride, yuv[1].stride, size.x << 2, 0);
+	th_ycbcr_buffer yuv;
+	th_decode_ycbcr_out(td, yuv);
 
-		} else if (px_fmt == TH_PF_420) {
+	r_frame.time = videobuf_time;
 
-			yuv420_2_rgb8888((uint8_t *)dst, (uint8_t *)yuv[0].data, (uint8_t *)yuv[2].data, (uint8_t *)yuv[1].data, size.x, size.y, yuv[0].stride, yuv[1].stride, size.x << 2, 0);
-		};
+	if (planar) {
 
-		format = Image::FORMAT_RGBA;
+		_copy_plane(r_frame.planes[0], yuv[0], size.x, size.y);
+		_copy_plane(r_frame.planes[1], yuv[1], chroma_size.x, chroma_size.y);
+		_copy_plane(r_frame.planes[2], yuv[2], chroma_size.x, chroma_size.y);
+		return;
 	}
 
-	Image img(size.x, size.y, 0, Image::FORMAT_RGBA, frame_data); //zero copy image creation
-
-	texture->set_data(img); //zero copy send to visual server
-
-	/*
-
-	if (px_fmt == TH_PF_444) {
+	int pitch = 4;
+	r_frame.planes[0].resize(size.x * size.y * pitch);
+	DVector<uint8_t>::Write w = r_frame.planes[0].write();
+	uint8_t *dst = w.ptr();
 
-		int pitch = 3;
-		frame_data.resize(size.x * size.y * pitch);
-		DVector<uint8_t>::Write w = frame_data.write();
-		char* dst = (char*)w.ptr();
+	if (yuv2rgba_simd_available()) {
 
-		for(int i=0;i<size.y;i++) {
+		yuv2rgba8888(dst, yuv[0].data, yuv[1].data, yuv[2].data, size.x, size.y, yuv[0].stride, yuv[1].stride, size.x << 2, chroma_shift_x, chroma_shift_y);
 
-			char *in_y  = (char *)yuv[0].data+y_offset+yuv[0].stride*i;
-			char *out = dst + (int)size.x * pitch * i;
-			char *in_u  = (char *)yuv[1].data+uv_offset+yuv[1].stride*i;
-			char *in_v  = (char *)yuv[2].data+uv_offset+yuv[2].stride*i;
-			for (int j=0;j<size.x;j++) {
+	} else if (px_fmt == TH_PF_444) {
 
-				out[j*3+0] = in_y[j];
-				out[j*3+1] = in_u[j];
-				out[j*3+2] = in_v[j];
-			};
-		}
+		yuv444_2_rgb8888(dst, (uint8_t *)yuv[0].data, (uint8_t *)yuv[1].data, (uint8_t *)yuv[2].data, size.x, size.y, yuv[0].stride, yuv[1].stride, size.x << 2, 0);
 
-		format = Image::FORMAT_YUV_444;
+	} else if (px_fmt == TH_PF_422) {
 
-	} else {
+		yuv422_2_rgb8888(dst, (uint8_t *)yuv[0].data, (uint8_t *)yuv[1].data, (uint8_t *)yuv[2].data, size.x, size.y, yuv[0].stride, yuv[1].stride, size.x << 2, 0);
 
-		int div;
-		if (px_fmt!=TH_PF_422) {
-			div = 2;
-		}
+	} else if (px_fmt == TH_PF_420) {
 
-		bool rgba = true;
-		if (rgba) {
-
-			int pitch = 4;
-			frame_data.resize(size.x * size.y * pitch);
-			DVector<uint8_t>::Write w = frame_data.write();
-			char* dst = (char*)w.ptr();
-
-			uv_offset=(ti.pic_x/2)+(yuv[1].stride)*(ti.pic_y / div);
-			for(int i=0;i<size.y;i++) {
-				char *in_y  = (char *)yuv[0].data+y_offset+yuv[0].stride*i;
-				char *in_u  = (char *)yuv[1].data+uv_offset+yuv[1].stride*(i/div);
-				char *in_v  = (char *)yuv[2].data+uv_offset+yuv[2].stride*(i/div);
-				uint8_t *out = (uint8_t*)dst + (int)size.x * pitch * i;
-				int ofs = 0;
-				for (int j=0;j<size.x;j++) {
-
-					uint8_t y, u, v;
-					y = in_y[j];
-					u = in_u[j/2];
-					v = in_v[j/2];
-
-					int32_t r = Math::fast_ftoi(1.164 * (y - 16) + 1.596 * (v - 128));
-					int32_t g = Math::fast_ftoi(1.164 * (y - 16) - 0.813 * (v - 128) - 0.391 * (u - 128));
-					int32_t b = Math::fast_ftoi(1.164 * (y - 16) + 2.018 * (u - 128));
-
-					out[ofs++] = CLAMP(r, 0, 255);
-					out[ofs++] = CLAMP(g, 0, 255);
-					out[ofs++] = CLAMP(b, 0, 255);
-					out[ofs++] = 255;
-				}
-			}
+		yuv420_2_rgb8888(dst, (uint8_t *)yuv[0].data, (uint8_t *)yuv[1].data, (uint8_t *)yuv[2].data, size.x, size.y, yuv[0].stride, yuv[1].stride, size.x << 2, 0);
+	};
+}
 
-			format = Image::FORMAT_RGBA;
+void VideoStreamPlaybackTheora::show_frame(const Frame &p_frame) {
 
-		} else {
+	//zero copy image creation, zero copy send to visual server
+	if (planar) {
 
-			int pitch = 2;
-			frame_data.resize(size.x * size.y * pitch);
-			DVector<uint8_t>::Write w = frame_data.write();
-			char* dst = (char*)w.ptr();
-
-			uv_offset=(ti.pic_x/2)+(yuv[1].stride)*(ti.pic_y / div);
-			for(int i=0;i<size.y;i++) {
-				char *in_y  = (char *)yuv[0].data+y_offset+yuv[0].stride*i;
-				char *out = dst + (int)size.x * pitch * i;
-				for (int j=0;j<size.x;j++)
-					out[j*2] = in_y[j];
-				char *in_u  = (char *)yuv[1].data+uv_offset+yuv[1].stride*(i/div);
-				char *in_v  = (char *)yuv[2].data+uv_offset+yuv[2].stride*(i/div);
-				for (int j=0;j<(int)size.x>>1;j++) {
-					out[j*4+1] = in_u[j];
-					out[j*4+3] = in_v[j];
-				}
-			}
+		texture->set_data(Image(size.x, size.y, 0, Image::FORMAT_GRAYSCALE, p_frame.planes[0]));
+		u_texture->set_data(Image(chroma_size.x, chroma_size.y, 0, Image::FORMAT_GRAYSCALE, p_frame.planes[1]));
+		v_texture->set_data(Image(chroma_size.x, chroma_size.y, 0, Image::FORMAT_GRAYSCALE, p_frame.planes[2]));
+	} else {
 
-			format = Image::FORMAT_YUV_422;
-		};
-	};
-	//	*/
+		texture->set_data(Image(size.x, size.y, 0, Image::FORMAT_RGBA, p_frame.planes[0]));
+	}
 
-	frames_pending = 1;
+	frames_drawn++;
 }
 
 void VideoStreamPlaybackTheora::clear() {
 
+	if (thread) {
+		thread_exit = true;
+		thread_sem->post();
+		Thread::wait_to_finish(thread);
+		memdelete(thread);
+		thread = NULL;
+	}
+
 	if (!file)
 		return;
 
@@ -258,20 +153,11 @@ void VideoStreamPlaybackTheora::clear() {
 	}
 	ogg_sync_clear(&oy);
 
-#ifdef THEORA_USE_THREAD_STREAMING
-	thread_exit = true;
-	thread_sem->post(); //just in case
-	Thread::wait_to_finish(thread);
-	memdelete(thread);
-	thread = NULL;
-	ring_buffer.clear();
-#endif
 	//file_name = "";
 
 	theora_p = 0;
 	vorbis_p = 0;
 	videobuf_ready = 0;
-	frames_pending = 0;
 	videobuf_time = 0;
 	theora_eos = false;
 	vorbis_eos = false;
@@ -296,18 +182,6 @@ void VideoStreamPlaybackTheora::set_file(const String &p_file) {
 	file = FileAccess::open(p_file, FileAccess::READ);
 	ERR_FAIL_COND(!file);
 
-#ifdef THEORA_USE_THREAD_STREAMING
-	thread_exit = false;
-	thread_eof = false;
-	//pre-fill buffer
-	int to_read = ring_buffer.space_left();
-	int read = file->get_buffer(read_buffer.ptr(), to_read);
-	ring_buffer.write(read_buffer.ptr(), read);
-
-	thread = Thread::create(_streaming_thread, this);
-
-#endif
-
 	ogg_sync_init(&oy);
 
 	/* init supporting Vorbis structures needed in header parsing */
@@ -468,7 +342,40 @@ void VideoStreamPlaybackTheora::set_file(const String &p_file) {
 		size.x = w;
 		size.y = h;
 
-		texture->create(w, h, Image::FORMAT_RGBA, Texture::FLAG_FILTER | Texture::FLAG_VIDEO_SURFACE);
+		chroma_shift_x = px_fmt == TH_PF_444 ? 0 : 1;
+		chroma_shift_y = px_fmt == TH_PF_420 ? 1 : 0;
+		chroma_size.x = w >> chroma_shift_x;
+		chroma_size.y = h >> chroma_shift_y;
+
+		planar = Globals::get_singleton()->get("render/theora_planar_yuv");
+
+		if (planar) {
+
+			texture->create(w, h, Image::FORMAT_GRAYSCALE, Texture::FLAG_FILTER | Texture::FLAG_VIDEO_SURFACE);
+			u_texture->create(chroma_size.x, chroma_size.y, Image::FORMAT_GRAYSCALE, Texture::FLAG_FILTER | Texture::FLAG_VIDEO_SURFACE);
+			v_texture->create(chroma_size.x, chroma_size.y, Image::FORMAT_GRAYSCALE, Texture::FLAG_FILTER | Texture::FLAG_VIDEO_SURFACE);
+
+			if (texture_material.is_null()) {
+
+				Ref<CanvasItemShader> shader = memnew(CanvasItemShader);
+				shader->set_code("",
+						"uniform texture u_plane;\n"
+						"uniform texture v_plane;\n"
+						"float y = (tex(TEXTURE, UV).r - 0.0625) * 1.164;\n"
+						"float u = tex(u_plane, UV).r - 0.5;\n"
+						"float v = tex(v_plane, UV).r - 0.5;\n"
+						"COLOR = vec4(y + 1.596 * v, y - 0.391 * u - 0.813 * v, y + 2.018 * u, 1.0) * SRC_COLOR;\n",
+						"");
+
+				texture_material.instance();
+				texture_material->set_shader(shader);
+				texture_material->set_shader_param("u_plane", u_texture);
+				texture_material->set_shader_param("v_plane", v_texture);
+			}
+		} else {
+
+			texture->create(w, h, Image::FORMAT_RGBA, Texture::FLAG_FILTER | Texture::FLAG_VIDEO_SURFACE);
+		}
 
 	} else {
 		/* tear down the partial theora setup */
@@ -509,6 +416,16 @@ Ref<Texture> VideoStreamPlaybackTheora::get_texture() {
 	return texture;
 }
 
+Ref<CanvasItemMaterial> VideoStreamPlaybackTheora::get_texture_material() {
+
+	return planar ? texture_material : Ref<CanvasItemMaterial>();
+}
+
+int VideoStreamPlaybackTheora::get_frames_drawn() const {
+
+	return frames_drawn;
+}
+
 void VideoStreamPlaybackTheora::update(float p_delta) {
 
 	if (!file)
@@ -519,9 +436,48 @@ void VideoStreamPlaybackTheora::update(float p_delta) {
 		return;
 	};
 
-#ifdef THEORA_USE_THREAD_STREAMING
-	thread_sem->post();
-#endif
+	if (thread) {
+
+		//show the newest decoded frame that is due, the decode thread refills the slots
+		thread_mutex->lock();
+		time += p_delta;
+		double current = get_time();
+
+		int show = -1;
+		while (ring_buffer.data_left()) {
+
+			int idx;
+			ring_buffer.read(&idx, 1, false);
+			if (frames[idx].time > current)
+				break;
+
+			ring_buffer.advance_read(1);
+			if (show != -1)
+				free_frames.write(show); //late, a newer frame is due already
+			show = idx;
+		}
+
+		bool done = thread_eof && ring_buffer.data_left() == 0;
+		thread_mutex->unlock();
+
+		if (show != -1) {
+
+			show_frame(frames[show]);
+
+			thread_mutex->lock();
+			free_frames.write(show);
+			thread_mutex->unlock();
+			thread_sem->post();
+
+		} else if (done) {
+
+			if (OS::get_singleton()->is_stdout_verbose())
+				print_line("video done, stopping");
+			stop();
+		}
+
+		return;
+	}
 
 	//double ctime =AudioServer::get_singleton()->get_mix_time();
 
@@ -532,6 +488,22 @@ void VideoStreamPlaybackTheora::update(float p_delta) {
 		return; //no new frames need to be produced
 	}
 
+	if (!decode_frame(get_time())) {
+		if (OS::get_singleton()->is_stdout_verbose())
+			print_line("video done, stopping");
+		stop();
+		return;
+	}
+
+	convert_frame(frames[0]);
+	show_frame(frames[0]);
+};
+
+bool VideoStreamPlaybackTheora::decode_frame(double p_time) {
+
+	//decodes until a frame at or after p_time is ready, feeding audio along the way.
+	//returns false at the end of the stream
+
 	bool frame_done = false;
 	bool audio_done = !vorbis_p;
 
@@ -645,7 +617,7 @@ void VideoStreamPlaybackTheora::update(float p_delta) {
 					 keyframing.  Soon enough libtheora will be able to deal
 					 with non-keyframe seeks.  */
 
-					if (videobuf_time >= get_time()) {
+					if (videobuf_time >= p_time) {
 						frame_done = true;
 					} else {
 						/*If we are too slow, reduce the pp level.*/
@@ -662,14 +634,8 @@ void VideoStreamPlaybackTheora::update(float p_delta) {
 
 //print_line("no theora: "+itos(no_theora)+" theora eos: "+itos(theora_eos)+" frame done "+itos(frame_done));
 
-#ifdef THEORA_USE_THREAD_STREAMING
-		if (file && thread_eof && no_theora && theora_eos && ring_buffer.data_left() == 0) {
-#else
 		if (file && /*!videobuf_ready && */ no_theora && theora_eos) {
-#endif
-			printf("video done, stopping\n");
-			stop();
-			return;
+			return false;
 		};
 #if 0
 		if (!videobuf_ready || audio_todo > 0){
@@ -695,7 +661,7 @@ void VideoStreamPlaybackTheora::update(float p_delta) {
 		//if(stateflag) audio_write_nonblocking();
 
 		/* are we at or past time for this video frame? */
-		if (videobuf_ready && videobuf_time <= get_time()) {
+		if (videobuf_ready && videobuf_time <= p_time) {
 
 			//video_write();
 			//videobuf_ready=0;
@@ -703,7 +669,7 @@ void VideoStreamPlaybackTheora::update(float p_delta) {
 			//printf("frame at %f not ready (time %f), ready %i\n", (float)videobuf_time, get_time(), videobuf_ready);
 		}
 
-		float tdiff = videobuf_time - get_time();
+		float tdiff = videobuf_time - p_time;
 		/*If we have lots of extra time, increase the post-processing level.*/
 		if (tdiff > ti.fps_denominator * 0.25 / ti.fps_numerator) {
 			pp_inc = pp_level < pp_level_max ? 1 : 0;
@@ -712,8 +678,8 @@ void VideoStreamPlaybackTheora::update(float p_delta) {
 		}
 	}
 
-	video_write();
-};
+	return true;
+}
 
 void VideoStreamPlaybackTheora::play() {
 
@@ -724,8 +690,21 @@ void VideoStreamPlaybackTheora::play() {
 	}
 
 	playing = true;
+	frames_drawn = 0;
 	delay_compensation = Globals::get_singleton()->get("audio/video_delay_compensation_ms");
 	delay_compensation /= 1000.0;
+
+	if (file && !thread && thread_sem && thread_mutex && bool(Globals::get_singleton()->get("render/theora_decode_thread"))) {
+
+		ring_buffer.clear();
+		free_frames.clear();
+		for (int i = 0; i < MAX_FRAMES; i++) {
+			free_frames.write(i);
+		}
+		thread_exit = false;
+		thread_eof = false;
+		thread = Thread::create(_decode_thread, this); //stays NULL without thread support, decoding in update() then
+	}
 };
 
 void VideoStreamPlaybackTheora::stop() {
@@ -810,31 +789,41 @@ int VideoStreamPlaybackTheora::get_mix_rate() const {
 	return vi.rate;
 }
 
-#ifdef THEORA_USE_THREAD_STREAMING
-
-void VideoStreamPlaybackTheora::_streaming_thread(void *ud) {
+void VideoStreamPlaybackTheora::_decode_thread(void *ud) {
 
 	VideoStreamPlaybackTheora *vs = (VideoStreamPlaybackTheora *)ud;
 
 	while (!vs->thread_exit) {
 
-		//just fill back the buffer
-		if (!vs->thread_eof) {
+		int idx = -1;
 
-			int to_read = vs->ring_buffer.space_left();
-			if (to_read) {
-				int read = vs->file->get_buffer(vs->read_buffer.ptr(), to_read);
-				vs->ring_buffer.write(vs->read_buffer.ptr(), read);
-				vs->thread_eof = vs->file->eof_reached();
-			}
+		vs->thread_mutex->lock();
+		if (!vs->thread_eof && vs->free_frames.data_left())
+			vs->free_frames.read(&idx, 1);
+		double time = vs->get_time();
+		vs->thread_mutex->unlock();
+
+		if (idx == -1) {
+			//ahead by MAX_FRAMES already (or done), wait for update() to show one
+			vs->thread_sem->wait();
+			continue;
 		}
 
-		vs->thread_sem->wait();
+		bool decoded = vs->decode_frame(time);
+		if (decoded)
+			vs->convert_frame(vs->frames[idx]);
+
+		vs->thread_mutex->lock();
+		if (decoded) {
+			vs->ring_buffer.write(idx);
+		} else {
+			vs->free_frames.write(idx);
+			vs->thread_eof = true;
+		}
+		vs->thread_mutex->unlock();
 	}
 }
 
-#endif
-
 VideoStreamPlaybackTheora::VideoStreamPlaybackTheora() {
 
 	file = NULL;
@@ -842,38 +831,41 @@ VideoStreamPlaybackTheora::VideoStreamPlaybackTheora() {
 	vorbis_p = 0;
 	videobuf_ready = 0;
 	playing = false;
-	frames_pending = 0;
+	frames_drawn = 0;
 	videobuf_time = 0;
 	paused = false;
+	chroma_shift_x = 1;
+	chroma_shift_y = 1;
+	planar = false;
 
 	buffering = false;
 	texture = Ref<ImageTexture>(memnew(ImageTexture));
+	u_texture = Ref<ImageTexture>(memnew(ImageTexture));
+	v_texture = Ref<ImageTexture>(memnew(ImageTexture));
 	mix_callback = NULL;
 	mix_udata = NULL;
 	audio_track = 0;
 	delay_compensation = 0;
 	audio_frames_wrote = 0;
 
-#ifdef THEORA_USE_THREAD_STREAMING
-	int rb_power = nearest_shift(RB_SIZE_KB * 1024);
-	ring_buffer.resize(rb_power);
-	read_buffer.resize(RB_SIZE_KB * 1024);
+	ring_buffer.resize(FRAME_RING_POWER);
+	free_frames.resize(FRAME_RING_POWER);
+	thread_mutex = Mutex::create();
 	thread_sem = Semaphore::create();
 	thread = NULL;
 	thread_exit = false;
 	thread_eof = false;
-
-#endif
 };
 
 VideoStreamPlaybackTheora::~VideoStreamPlaybackTheora() {
 
-#ifdef THEORA_USE_THREAD_STREAMING
-
-	memdelete(thread_sem);
-#endif
 	clear();
 
+	if (thread_sem)
+		memdelete(thread_sem);
+	if (thread_mutex)
+		memdelete(thread_mutex);
+
 	if (file)
 		memdelete(file);
 };
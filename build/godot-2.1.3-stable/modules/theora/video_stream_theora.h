@@ -32,6 +32,7 @@
 
 #include "io/resource_loader.h"
 #include "os/file_access.h"
+#include "os/mutex.h"
 #include "os/semaphore.h"
 #include "os/thread.h"
 #include "ring_buffer.h"
@@ -40,20 +41,23 @@
 #include <theora/theoradec.h>
 #include <vorbis/codec.h>
 
-//#define THEORA_USE_THREAD_STREAMING
-
 class VideoStreamPlaybackTheora : public VideoStreamPlayback {
 
 	OBJ_TYPE(VideoStreamPlaybackTheora, VideoStreamPlayback);
 
 	enum {
-		MAX_FRAMES = 4,
+		MAX_FRAMES = 4, //decoded ahead by the decode thread
+		FRAME_RING_POWER = 3
+	};
+
+	struct Frame {
+
+		double time;
+		DVector<uint8_t> planes[3]; //RGBA, or Y, U and V when uploading planar
 	};
 
-	//Image frames[MAX_FRAMES];
-	Image::Format format;
-	DVector<uint8_t> frame_data;
-	int frames_pending;
+	Frame frames[MAX_FRAMES];
+	int frames_drawn;
 	FileAccess *file;
 	String file_name;
 	int audio_frames_wrote;
@@ -61,7 +65,9 @@ class VideoStreamPlaybackTheora : public VideoStreamPlayback {
 
 	int buffer_data();
 	int queue_page(ogg_page *page);
-	void video_write(void);
+	bool decode_frame(double p_time);
+	void convert_frame(Frame &r_frame);
+	void show_frame(const Frame &p_frame);
 	float get_time() const;
 
 	bool theora_eos;
@@ -79,6 +85,9 @@ class VideoStreamPlaybackTheora : public VideoStreamPlayback {
 	vorbis_block vb;
 	vorbis_comment vc;
 	th_pixel_fmt px_fmt;
+	int chroma_shift_x;
+	int chroma_shift_y;
+	Point2i chroma_size;
 	double videobuf_time;
 	int pp_inc;
 
@@ -97,26 +106,26 @@ class VideoStreamPlaybackTheora : public VideoStreamPlayback {
 
 	Ref<ImageTexture> texture;
 
+	//planar upload: texture holds Y, converted to RGB by texture_material
+	bool planar;
+	Ref<ImageTexture> u_texture;
+	Ref<ImageTexture> v_texture;
+	Ref<CanvasItemMaterial> texture_material;
+
 	AudioMixCallback mix_callback;
 	void *mix_udata;
 	bool paused;
 
-#ifdef THEORA_USE_THREAD_STREAMING
-
-	enum {
-		RB_SIZE_KB = 1024
-	};
-
-	RingBuffer<uint8_t> ring_buffer;
-	Vector<uint8_t> read_buffer;
-	bool thread_eof;
+	//decode thread, keeps up to MAX_FRAMES converted frames ahead of playback
+	RingBuffer<int> ring_buffer; //frames ready to show, oldest first
+	RingBuffer<int> free_frames;
+	Mutex *thread_mutex;
 	Semaphore *thread_sem;
 	Thread *thread;
 	volatile bool thread_exit;
+	bool thread_eof;
 
-	static void _streaming_thread(void *ud);
-
-#endif
+	static void _decode_thread(void *ud);
 
 	int audio_track;
 
@@ -146,6 +155,8 @@ public:
 	void set_file(const String &p_file);
 
 	virtual Ref<Texture> get_texture();
+	virtual Ref<CanvasItemMaterial> get_texture_material();
+	virtual int get_frames_drawn() const;
 	virtual void update(float p_delta);
 
 	virtual void set_mix_callback(AudioMixCallback p_callback, void *p_userdata);
@@ -794,13 +794,13 @@ do {                             \
 
 #define STORE(Y,DSTPTR)         \
 do {                            \
-    *(DSTPTR)++ = (Y);          \
-    *(DSTPTR)++ = (Y)>>22;      \
     *(DSTPTR)++ = (Y)>>11;      \
+    *(DSTPTR)++ = (Y)>>22;      \
+    *(DSTPTR)++ = (Y);          \
     *(DSTPTR)++ = 255;            \
 } while (0 == 1)
 
-void yuv422_2_rgb8888(uint8_t  *dst_ptr,
+static void yuv422_2_rgb8888(uint8_t  *dst_ptr,
 		const uint8_t  *y_ptr,
 		const uint8_t  *u_ptr,
 		const uint8_t  *v_ptr,
@@ -811,7 +811,6 @@ void yuv422_2_rgb8888(uint8_t  *dst_ptr,
 		      int32_t   dst_span,
 		      int32_t   dither)
 {
-    height -= 1;
     while (height > 0)
     {
 	height -= width<<16;
@@ -908,10 +907,10 @@ do {                             \
 
 #define STORE(Y,DSTPTR)     \
 do {                        \
-    (DSTPTR) = 0xFF000000 | (Y & 0xFF) | (0xFF00 & (Y>>14)) | (0xFF0000 & (Y<<5));\
+    (DSTPTR) = 0xFF000000 | (0xFF & (Y>>11)) | (0xFF00 & (Y>>14)) | (0xFF0000 & (Y<<16));\
 } while (0 == 1)
 
-void yuv420_2_rgb8888(uint8_t  *dst_ptr_,
+static void yuv420_2_rgb8888(uint8_t  *dst_ptr_,
 		const uint8_t  *y_ptr,
 		const uint8_t  *u_ptr,
 		const uint8_t  *v_ptr,
@@ -960,8 +959,8 @@ void yuv420_2_rgb8888(uint8_t  *dst_ptr_,
 	    y0 = uv + READY(*y_ptr++);
 	    FIXUP(y1);
 	    FIXUP(y0);
-	    STORE(y0, dst_ptr[dst_span]);
-	    STORE(y1, *dst_ptr++);
+	    STORE(y1, dst_ptr[dst_span]);
+	    STORE(y0, *dst_ptr++);
 	}
 	dst_ptr += dst_span*2-width;
 	y_ptr   += y_span*2-width;
@@ -1027,13 +1026,13 @@ do {                             \
 
 #define STORE(Y,DSTPTR)         \
 do {                            \
-    *(DSTPTR)++ = (Y);          \
-    *(DSTPTR)++ = (Y)>>22;      \
     *(DSTPTR)++ = (Y)>>11;      \
+    *(DSTPTR)++ = (Y)>>22;      \
+    *(DSTPTR)++ = (Y);          \
 	*(DSTPTR)++ = 255;           \
 } while (0 == 1)
 
-void yuv444_2_rgb8888(uint8_t  *dst_ptr,
+static void yuv444_2_rgb8888(uint8_t  *dst_ptr,
 		const uint8_t  *y_ptr,
 		const uint8_t  *u_ptr,
 		const uint8_t  *v_ptr,
@@ -1044,7 +1043,6 @@ void yuv444_2_rgb8888(uint8_t  *dst_ptr,
 		      int32_t   dst_span,
 		      int32_t   dither)
 {
-    height -= 1;
     while (height > 0)
     {
 	height -= width<<16;
@@ -0,0 +1,267 @@
+/*************************************************************************/
+/*  yuv2rgb_simd.cpp                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2017 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "yuv2rgb_simd.h"
+
+#ifdef YUV2RGB_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef YUV2RGB_NEON
+#include <arm_neon.h>
+#endif
+
+/* 6 bit fixed point coefficients:
+
+	c = 74 * (y - 16)
+	r = (c + 102 * (v - 128) + 32) >> 6
+	g = (c - 25 * (u - 128) - 52 * (v - 128) + 32) >> 6
+	b = (c + 129 * (u - 128) + 32) >> 6
+
+   every intermediate fits in 16 bits except c + 129 * (u - 128) for very bright blues,
+   which the SIMD versions saturate. the result is clamped to 255 either way. */
+
+#define YUV_C_MUL 74
+#define YUV_RV_MUL 102
+#define YUV_GU_MUL 25
+#define YUV_GV_MUL 52
+#define YUV_BU_MUL 129
+#define YUV_ROUND 32
+
+static _FORCE_INLINE_ uint8_t _yuv_clamp(int p_v) {
+
+	return p_v < 0 ? 0 : (p_v > 255 ? 255 : p_v);
+}
+
+static void _yuv_row_c(uint8_t *p_dst, const uint8_t *p_y, const uint8_t *p_u, const uint8_t *p_v, int p_from, int p_width, int p_chroma_shift) {
+
+	for (int x = p_from; x < p_width; x++) {
+
+		int c = YUV_C_MUL * (p_y[x] - 16);
+		int d = p_u[x >> p_chroma_shift] - 128;
+		int e = p_v[x >> p_chroma_shift] - 128;
+
+		uint8_t *dst = &p_dst[x << 2];
+		dst[0] = _yuv_clamp((c + YUV_RV_MUL * e + YUV_ROUND) >> 6);
+		dst[1] = _yuv_clamp((c - YUV_GU_MUL * d - YUV_GV_MUL * e + YUV_ROUND) >> 6);
+		dst[2] = _yuv_clamp((c + YUV_BU_MUL * d + YUV_ROUND) >> 6);
+		dst[3] = 255;
+	}
+}
+
+#ifdef YUV2RGB_SSE2
+
+static _FORCE_INLINE_ void _yuv_chroma_sse2(__m128i p_d, __m128i p_e, __m128i &r_r, __m128i &r_g, __m128i &r_b) {
+
+	const __m128i round = _mm_set1_epi16(YUV_ROUND);
+
+	r_r = _mm_add_epi16(_mm_mullo_epi16(p_e, _mm_set1_epi16(YUV_RV_MUL)), round);
+	r_g = _mm_sub_epi16(round, _mm_add_epi16(_mm_mullo_epi16(p_d, _mm_set1_epi16(YUV_GU_MUL)), _mm_mullo_epi16(p_e, _mm_set1_epi16(YUV_GV_MUL))));
+	r_b = _mm_add_epi16(_mm_mullo_epi16(p_d, _mm_set1_epi16(YUV_BU_MUL)), round);
+}
+
+static _FORCE_INLINE_ __m128i _yuv_pack_sse2(__m128i p_c_lo, __m128i p_c_hi, __m128i p_lo, __m128i p_hi) {
+
+	return _mm_packus_epi16(_mm_srai_epi16(_mm_adds_epi16(p_c_lo, p_lo), 6), _mm_srai_epi16(_mm_adds_epi16(p_c_hi, p_hi), 6));
+}
+
+static void _yuv_row_simd(uint8_t *p_dst, const uint8_t *p_y, const uint8_t *p_u, const uint8_t *p_v, int p_width, int p_chroma_shift) {
+
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i y_offset = _mm_set1_epi16(16);
+	const __m128i uv_offset = _mm_set1_epi16(128);
+	const __m128i y_mul = _mm_set1_epi16(YUV_C_MUL);
+	const __m128i alpha = _mm_set1_epi8((char)0xFF);
+
+	int x = 0;
+	for (; x + 16 <= p_width; x += 16) {
+
+		__m128i y = _mm_loadu_si128((const __m128i *)(p_y + x));
+		__m128i c_lo = _mm_mullo_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(y, zero), y_offset), y_mul);
+		__m128i c_hi = _mm_mullo_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(y, zero), y_offset), y_mul);
+
+		__m128i r_lo, r_hi, g_lo, g_hi, b_lo, b_hi;
+
+		if (p_chroma_shift) {
+
+			__m128i u = _mm_loadl_epi64((const __m128i *)(p_u + (x >> 1)));
+			__m128i v = _mm_loadl_epi64((const __m128i *)(p_v + (x >> 1)));
+			__m128i r, g, b;
+			_yuv_chroma_sse2(_mm_sub_epi16(_mm_unpacklo_epi8(u, zero), uv_offset), _mm_sub_epi16(_mm_unpacklo_epi8(v, zero), uv_offset), r, g, b);
+
+			//each chroma sample covers two pixels
+			r_lo = _mm_unpacklo_epi16(r, r);
+			r_hi = _mm_unpackhi_epi16(r, r);
+			g_lo = _mm_unpacklo_epi16(g, g);
+			g_hi = _mm_unpackhi_epi16(g, g);
+			b_lo = _mm_unpacklo_epi16(b, b);
+			b_hi = _mm_unpackhi_epi16(b, b);
+		} else {
+
+			__m128i u = _mm_loadu_si128((const __m128i *)(p_u + x));
+			__m128i v = _mm_loadu_si128((const __m128i *)(p_v + x));
+			_yuv_chroma_sse2(_mm_sub_epi16(_mm_unpacklo_epi8(u, zero), uv_offset), _mm_sub_epi16(_mm_unpacklo_epi8(v, zero), uv_offset), r_lo, g_lo, b_lo);
+			_yuv_chroma_sse2(_mm_sub_epi16(_mm_unpackhi_epi8(u, zero), uv_offset), _mm_sub_epi16(_mm_unpackhi_epi8(v, zero), uv_offset), r_hi, g_hi, b_hi);
+		}
+
+		__m128i r = _yuv_pack_sse2(c_lo, c_hi, r_lo, r_hi);
+		__m128i g = _yuv_pack_sse2(c_lo, c_hi, g_lo, g_hi);
+		__m128i b = _yuv_pack_sse2(c_lo, c_hi, b_lo, b_hi);
+
+		__m128i rg_lo = _mm_unpacklo_epi8(r, g);
+		__m128i rg_hi = _mm_unpackhi_epi8(r, g);
+		__m128i ba_lo = _mm_unpacklo_epi8(b, alpha);
+		__m128i ba_hi = _mm_unpackhi_epi8(b, alpha);
+
+		__m128i *dst = (__m128i *)(p_dst + (x << 2));
+		_mm_storeu_si128(dst + 0, _mm_unpacklo_epi16(rg_lo, ba_lo));
+		_mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(rg_lo, ba_lo));
+		_mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(rg_hi, ba_hi));
+		_mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(rg_hi, ba_hi));
+	}
+
+	_yuv_row_c(p_dst, p_y, p_u, p_v, x, p_width, p_chroma_shift);
+}
+
+#endif
+
+#ifdef YUV2RGB_NEON
+
+static _FORCE_INLINE_ int16x8_t _yuv_widen_neon(uint8x8_t p_v, int16x8_t p_offset) {
+
+	return vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(p_v)), p_offset);
+}
+
+static _FORCE_INLINE_ void _yuv_chroma_neon(int16x8_t p_d, int16x8_t p_e, int16x8_t &r_r, int16x8_t &r_g, int16x8_t &r_b) {
+
+	const int16x8_t round = vdupq_n_s16(YUV_ROUND);
+
+	r_r = vaddq_s16(vmulq_n_s16(p_e, YUV_RV_MUL), round);
+	r_g = vsubq_s16(round, vaddq_s16(vmulq_n_s16(p_d, YUV_GU_MUL), vmulq_n_s16(p_e, YUV_GV_MUL)));
+	r_b = vaddq_s16(vmulq_n_s16(p_d, YUV_BU_MUL), round);
+}
+
+static _FORCE_INLINE_ uint8x16_t _yuv_pack_neon(int16x8_t p_c_lo, int16x8_t p_c_hi, int16x8_t p_lo, int16x8_t p_hi) {
+
+	return vcombine_u8(vqmovun_s16(vshrq_n_s16(vqaddq_s16(p_c_lo, p_lo), 6)), vqmovun_s16(vshrq_n_s16(vqaddq_s16(p_c_hi, p_hi), 6)));
+}
+
+static void _yuv_row_simd(uint8_t *p_dst, const uint8_t *p_y, const uint8_t *p_u, const uint8_t *p_v, int p_width, int p_chroma_shift) {
+
+	const int16x8_t y_offset = vdupq_n_s16(16);
+	const int16x8_t uv_offset = vdupq_n_s16(128);
+
+	int x = 0;
+	for (; x + 16 <= p_width; x += 16) {
+
+		uint8x16_t y = vld1q_u8(p_y + x);
+		int16x8_t c_lo = vmulq_n_s16(_yuv_widen_neon(vget_low_u8(y), y_offset), YUV_C_MUL);
+		int16x8_t c_hi = vmulq_n_s16(_yuv_widen_neon(vget_high_u8(y), y_offset), YUV_C_MUL);
+
+		int16x8_t r_lo, r_hi, g_lo, g_hi, b_lo, b_hi;
+
+		if (p_chroma_shift) {
+
+			int16x8_t r, g, b;
+			_yuv_chroma_neon(_yuv_widen_neon(vld1_u8(p_u + (x >> 1)), uv_offset), _yuv_widen_neon(vld1_u8(p_v + (x >> 1)), uv_offset), r, g, b);
+
+			//each chroma sample covers two pixels
+			int16x8x2_t rr = vzipq_s16(r, r);
+			int16x8x2_t gg = vzipq_s16(g, g);
+			int16x8x2_t bb = vzipq_s16(b, b);
+			r_lo = rr.val[0];
+			r_hi = rr.val[1];
+			g_lo = gg.val[0];
+			g_hi = gg.val[1];
+			b_lo = bb.val[0];
+			b_hi = bb.val[1];
+		} else {
+
+			uint8x16_t u = vld1q_u8(p_u + x);
+			uint8x16_t v = vld1q_u8(p_v + x);
+			_yuv_chroma_neon(_yuv_widen_neon(vget_low_u8(u), uv_offset), _yuv_widen_neon(vget_low_u8(v), uv_offset), r_lo, g_lo, b_lo);
+			_yuv_chroma_neon(_yuv_widen_neon(vget_high_u8(u), uv_offset), _yuv_widen_neon(vget_high_u8(v), uv_offset), r_hi, g_hi, b_hi);
+		}
+
+		uint8x16x4_t rgba;
+		rgba.val[0] = _yuv_pack_neon(c_lo, c_hi, r_lo, r_hi);
+		rgba.val[1] = _yuv_pack_neon(c_lo, c_hi, g_lo, g_hi);
+		rgba.val[2] = _yuv_pack_neon(c_lo, c_hi, b_lo, b_hi);
+		rgba.val[3] = vdupq_n_u8(255);
+		vst4q_u8(p_dst + (x << 2), rgba);
+	}
+
+	_yuv_row_c(p_dst, p_y, p_u, p_v, x, p_width, p_chroma_shift);
+}
+
+#endif
+
+bool yuv2rgba_simd_available() {
+
+#if defined(YUV2RGB_SSE2) || defined(YUV2RGB_NEON)
+	return true;
+#else
+	return false;
+#endif
+}
+
+const char *yuv2rgba_simd_get_name() {
+
+#if defined(YUV2RGB_SSE2)
+	return "SSE2";
+#elif defined(YUV2RGB_NEON)
+	return "NEON";
+#else
+	return "none";
+#endif
+}
+
+void yuv2rgba8888(uint8_t *p_dst, const uint8_t *p_y, const uint8_t *p_u, const uint8_t *p_v, int p_width, int p_height, int p_y_span, int p_uv_span, int p_dst_span, int p_chroma_shift_x, int p_chroma_shift_y) {
+
+#if defined(YUV2RGB_SSE2) || defined(YUV2RGB_NEON)
+
+	for (int i = 0; i < p_height; i++) {
+
+		int uv_row = i >> p_chroma_shift_y;
+		_yuv_row_simd(p_dst + i * p_dst_span, p_y + i * p_y_span, p_u + uv_row * p_uv_span, p_v + uv_row * p_uv_span, p_width, p_chroma_shift_x);
+	}
+#else
+
+	yuv2rgba8888_c(p_dst, p_y, p_u, p_v, p_width, p_height, p_y_span, p_uv_span, p_dst_span, p_chroma_shift_x, p_chroma_shift_y);
+#endif
+}
+
+void yuv2rgba8888_c(uint8_t *p_dst, const uint8_t *p_y, const uint8_t *p_u, const uint8_t *p_v, int p_width, int p_height, int p_y_span, int p_uv_span, int p_dst_span, int p_chroma_shift_x, int p_chroma_shift_y) {
+
+	for (int i = 0; i < p_height; i++) {
+
+		int uv_row = i >> p_chroma_shift_y;
+		_yuv_row_c(p_dst + i * p_dst_span, p_y + i * p_y_span, p_u + uv_row * p_uv_span, p_v + uv_row * p_uv_span, 0, p_width, p_chroma_shift_x);
+	}
+}
@@ -0,0 +1,52 @@
+/*************************************************************************/
+/*  yuv2rgb_simd.h                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2017 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#ifndef YUV2RGB_SIMD_H
+#define YUV2RGB_SIMD_H
+
+#include "typedefs.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define YUV2RGB_SSE2
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define YUV2RGB_NEON
+#endif
+
+// BT.601 (video range) YCbCr to RGBA8888, 16 pixels at a time with SSE2 or NEON.
+// chroma planes are subsampled by 1<<p_chroma_shift_x horizontally and 1<<p_chroma_shift_y
+// vertically (4:2:0 is 1,1, 4:2:2 is 1,0 and 4:4:4 is 0,0). the plain C version is used for
+// the end of each row and gives the exact same results.
+
+bool yuv2rgba_simd_available();
+const char *yuv2rgba_simd_get_name();
+
+void yuv2rgba8888(uint8_t *p_dst, const uint8_t *p_y, const uint8_t *p_u, const uint8_t *p_v, int p_width, int p_height, int p_y_span, int p_uv_span, int p_dst_span, int p_chroma_shift_x, int p_chroma_shift_y);
+void yuv2rgba8888_c(uint8_t *p_dst, const uint8_t *p_y, const uint8_t *p_u, const uint8_t *p_v, int p_width, int p_height, int p_y_span, int p_uv_span, int p_dst_span, int p_chroma_shift_x, int p_chroma_shift_y);
+
+#endif // YUV2RGB_SIMD_H
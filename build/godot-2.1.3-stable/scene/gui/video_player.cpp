@@ -172,6 +172,22 @@ bool VideoPlayer::has_expand() const {
 	return expand;
 }
 
+void VideoPlayer::set_material(const Ref<CanvasItemMaterial> &p_material) {
+
+	//clearing the material falls back to the one the playback needs
+	if (p_material.is_null() && playback_material.is_valid())
+		CanvasItem::set_material(playback_material);
+	else
+		CanvasItem::set_material(p_material);
+}
+
+void VideoPlayer::_validate_property(PropertyInfo &property) const {
+
+	//the playback material belongs to the stream, don't save it with the scene
+	if (property.name == "material/material" && playback_material.is_valid() && get_material() == playback_material)
+		property.usage &= ~PROPERTY_USAGE_STORAGE;
+}
+
 void VideoPlayer::set_stream(const Ref<VideoStream> &p_stream) {
 
 	stop();
@@ -208,6 +224,12 @@ void VideoPlayer::set_stream(const Ref<VideoStream> &p_stream) {
 		AudioServer::get_singleton()->unlock();
 	}
 
+	//planar YUV playback needs its own material to convert to RGB, unless the node has one
+	Ref<CanvasItemMaterial> prev_material = playback_material;
+	playback_material = playback.is_valid() ? playback->get_texture_material() : Ref<CanvasItemMaterial>();
+	if (get_material().is_null() || get_material() == prev_material)
+		set_material(Ref<CanvasItemMaterial>());
+
 	update();
 };
 
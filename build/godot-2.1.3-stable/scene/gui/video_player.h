@@ -58,6 +58,7 @@ class VideoPlayer : public Control {
 	RID stream_rid;
 
 	Ref<ImageTexture> texture;
+	Ref<CanvasItemMaterial> playback_material;
 	Image last_frame;
 
 	AudioRBResampler resampler;
@@ -77,6 +78,7 @@ class VideoPlayer : public Control {
 protected:
 	static void _bind_methods();
 	void _notification(int p_notification);
+	virtual void _validate_property(PropertyInfo &property) const;
 
 public:
 	Size2 get_minimum_size() const;
@@ -85,6 +87,8 @@ public:
 
 	Ref<Texture> get_video_texture();
 
+	virtual void set_material(const Ref<CanvasItemMaterial> &p_material);
+
 	void set_stream(const Ref<VideoStream> &p_stream);
 	Ref<VideoStream> get_stream() const;
 
@@ -102,69 +102,51 @@ DynamicFontData::~DynamicFontData() {
 ////////////////////
 HashMap<String, Vector<uint8_t> > DynamicFontAtSize::_fontdata;
 
-Error DynamicFontAtSize::_load() {
+Error DynamicFontAtSize::_open_face(FT_Library &r_library, FT_Face &r_face, FT_StreamRec &r_stream) const {
 
-	int error = FT_Init_FreeType(&library);
+	int error = FT_Init_FreeType(&r_library);
 
 	ERR_EXPLAIN(TTR("Error initializing FreeType."));
 	ERR_FAIL_COND_V(error != 0, ERR_CANT_CREATE);
 
-	// FT_OPEN_STREAM is extremely slow only on Android.
-	if (OS::get_singleton()->get_name() == "Android" && font->font_mem == NULL && font->font_path != String()) {
-		// cache font only once for each font->font_path
-		if (_fontdata.has(font->font_path)) {
-
-			font->set_font_ptr(_fontdata[font->font_path].ptr(), _fontdata[font->font_path].size());
-
-		} else {
-
-			FileAccess *f = FileAccess::open(font->font_path, FileAccess::READ);
-			ERR_FAIL_COND_V(!f, ERR_CANT_OPEN);
-
-			size_t len = f->get_len();
-			_fontdata[font->font_path] = Vector<uint8_t>();
-			Vector<uint8_t> &fontdata = _fontdata[font->font_path];
-			fontdata.resize(len);
-			f->get_buffer(fontdata.ptr(), len);
-			font->set_font_ptr(fontdata.ptr(), len);
-			f->close();
-		}
-	}
-
 	if (font->font_mem == NULL && font->font_path != String()) {
 
 		FileAccess *f = FileAccess::open(font->font_path, FileAccess::READ);
-		ERR_FAIL_COND_V(!f, ERR_CANT_OPEN);
+		if (!f) {
+			FT_Done_FreeType(r_library);
+			ERR_FAIL_V(ERR_CANT_OPEN);
+		}
 
-		memset(&stream, 0, sizeof(FT_StreamRec));
-		stream.base = NULL;
-		stream.size = f->get_len();
-		stream.pos = 0;
-		stream.descriptor.pointer = f;
-		stream.read = _ft_stream_io;
-		stream.close = _ft_stream_close;
+		memset(&r_stream, 0, sizeof(FT_StreamRec));
+		r_stream.base = NULL;
+		r_stream.size = f->get_len();
+		r_stream.pos = 0;
+		r_stream.descriptor.pointer = f;
+		r_stream.read = _ft_stream_io;
+		r_stream.close = _ft_stream_close;
 
 		FT_Open_Args fargs;
 		memset(&fargs, 0, sizeof(FT_Open_Args));
 		fargs.flags = FT_OPEN_STREAM;
-		fargs.stream = &stream;
-		error = FT_Open_Face(library, &fargs, 0, &face);
+		fargs.stream = &r_stream;
+		error = FT_Open_Face(r_library, &fargs, 0, &r_face);
 	} else if (font->font_mem) {
 
-		memset(&stream, 0, sizeof(FT_StreamRec));
-		stream.base = (unsigned char *)font->font_mem;
-		stream.size = font->font_mem_size;
-		stream.pos = 0;
+		memset(&r_stream, 0, sizeof(FT_StreamRec));
+		r_stream.base = (unsigned char *)font->font_mem;
+		r_stream.size = font->font_mem_size;
+		r_stream.pos = 0;
 
 		FT_Open_Args fargs;
 		memset(&fargs, 0, sizeof(FT_Open_Args));
 		fargs.memory_base = (unsigned char *)font->font_mem;
 		fargs.memory_size = font->font_mem_size;
 		fargs.flags = FT_OPEN_MEMORY;
-		fargs.stream = &stream;
-		error = FT_Open_Face(library, &fargs, 0, &face);
+		fargs.stream = &r_stream;
+		error = FT_Open_Face(r_library, &fargs, 0, &r_face);
 
 	} else {
+		FT_Done_FreeType(r_library);
 		ERR_EXPLAIN("DynamicFont uninitialized");
 		ERR_FAIL_V(ERR_UNCONFIGURED);
 	}
@@ -173,12 +155,12 @@ Error DynamicFontAtSize::_load() {
 
 	if (error == FT_Err_Unknown_File_Format) {
 		ERR_EXPLAIN(TTR("Unknown font format."));
-		FT_Done_FreeType(library);
+		FT_Done_FreeType(r_library);
 
 	} else if (error) {
 
 		ERR_EXPLAIN(TTR("Error loading font."));
-		FT_Done_FreeType(library);
+		FT_Done_FreeType(r_library);
 	}
 
 	ERR_FAIL_COND_V(error, ERR_FILE_CANT_OPEN);
@@ -191,7 +173,38 @@ Error DynamicFontAtSize::_load() {
 		ERR_FAIL_COND_V( error, ERR_INVALID_PARAMETER );
 	}*/
 
-	error = FT_Set_Pixel_Sizes(face, 0, id.size);
+	error = FT_Set_Pixel_Sizes(r_face, 0, id.size);
+
+	return OK;
+}
+
+Error DynamicFontAtSize::_load() {
+
+	// FT_OPEN_STREAM is extremely slow only on Android.
+	if (OS::get_singleton()->get_name() == "Android" && font->font_mem == NULL && font->font_path != String()) {
+		// cache font only once for each font->font_path
+		if (_fontdata.has(font->font_path)) {
+
+			font->set_font_ptr(_fontdata[font->font_path].ptr(), _fontdata[font->font_path].size());
+
+		} else {
+
+			FileAccess *f = FileAccess::open(font->font_path, FileAccess::READ);
+			ERR_FAIL_COND_V(!f, ERR_CANT_OPEN);
+
+			size_t len = f->get_len();
+			_fontdata[font->font_path] = Vector<uint8_t>();
+			Vector<uint8_t> &fontdata = _fontdata[font->font_path];
+			fontdata.resize(len);
+			f->get_buffer(fontdata.ptr(), len);
+			font->set_font_ptr(fontdata.ptr(), len);
+			f->close();
+		}
+	}
+
+	Error err = _open_face(library, face, stream);
+	if (err != OK)
+		return err;
 
 	ascent = face->size->metrics.ascender >> 6;
 	descent = -face->size->metrics.descender >> 6;
@@ -413,54 +426,123 @@ void DynamicFontAtSize::_ft_stream_close(FT_Stream stream) {
 	memdelete(f);
 }
 
-void DynamicFontAtSize::_update_char(CharType p_char) {
-
-	if (char_map.has(p_char))
-		return;
-
-	_THREAD_SAFE_METHOD_
+void DynamicFontAtSize::_rasterize(FT_Face p_face, CharType p_char, bool p_force_autohinter, GlyphBitmap &r_glyph) {
 
-	FT_GlyphSlot slot = face->glyph;
+	r_glyph.c = p_char;
+	r_glyph.found = false;
 
-	if (FT_Get_Char_Index(face, p_char) == 0) {
+	if (FT_Get_Char_Index(p_face, p_char) == 0) {
 		//not found
-		Character ch;
-		ch.texture_idx = -1;
-		ch.advance = 0;
-		ch.h_align = 0;
-		ch.v_align = 0;
-		ch.found = false;
-
-		char_map[p_char] = ch;
 		return;
 	}
-	int error = FT_Load_Char(face, p_char, FT_LOAD_RENDER | (font->force_autohinter ? FT_LOAD_FORCE_AUTOHINT : 0));
+
+	int error = FT_Load_Char(p_face, p_char, FT_LOAD_RENDER | (p_force_autohinter ? FT_LOAD_FORCE_AUTOHINT : 0));
 	if (!error) {
-		error = FT_Render_Glyph(face->glyph, ft_render_mode_normal);
+		error = FT_Render_Glyph(p_face->glyph, ft_render_mode_normal);
 	}
 	if (error) {
-
-		int advance = 0;
 		//stbtt_GetCodepointHMetrics(&font->info, p_char, &advance, 0);
 		//print_line("char has no bitmap: "+itos(p_char)+" but advance is "+itos(advance*scale));
+		return;
+	}
+
+	FT_GlyphSlot slot = p_face->glyph;
+
+	r_glyph.width = slot->bitmap.width;
+	r_glyph.height = slot->bitmap.rows;
+	r_glyph.yofs = slot->bitmap_top;
+	r_glyph.xofs = slot->bitmap_left;
+	r_glyph.advance = slot->advance.x >> 6;
+	r_glyph.coverage.resize(r_glyph.width * r_glyph.height);
+
+	{
+		DVector<uint8_t>::Write wr = r_glyph.coverage.write();
+
+		for (int i = 0; i < r_glyph.height; i++) {
+			const uint8_t *src = slot->bitmap.buffer + i * slot->bitmap.pitch;
+			for (int j = 0; j < r_glyph.width; j++) {
+				wr[i * r_glyph.width + j] = src[j];
+			}
+		}
+	}
+
+	r_glyph.found = true;
+}
+
+// bottom-left skyline packing: returns the y a rect placed at the left edge of
+// skyline node p_index would rest on, or -1 if it does not fit there.
+int DynamicFontAtSize::_skyline_fit(const Vector<SkylineNode> &p_skyline, int p_index, int p_width, int p_height, int p_size) {
+
+	int x = p_skyline[p_index].x;
+	if (x + p_width > p_size)
+		return -1;
+
+	int y = 0;
+	int width_left = p_width;
+	for (int i = p_index; width_left > 0; i++) {
+
+		// nodes always span the whole texture width, so i stays in range
+		y = MAX(y, p_skyline[i].y);
+		if (y + p_height > p_size)
+			return -1;
+		width_left -= p_skyline[i].width;
+	}
+
+	return y;
+}
+
+void DynamicFontAtSize::_skyline_add(Vector<SkylineNode> &p_skyline, int p_index, int p_width, int p_height, int p_y) {
+
+	SkylineNode node;
+	node.x = p_skyline[p_index].x;
+	node.y = p_y + p_height;
+	node.width = p_width;
+	p_skyline.insert(p_index, node);
+
+	// trim the nodes now covered by the new one
+	for (int i = p_index + 1; i < p_skyline.size(); i++) {
+
+		int overlap = p_skyline[i - 1].x + p_skyline[i - 1].width - p_skyline[i].x;
+		if (overlap <= 0)
+			break;
+
+		p_skyline[i].x += overlap;
+		p_skyline[i].width -= overlap;
+		if (p_skyline[i].width > 0)
+			break;
+
+		p_skyline.remove(i);
+		i--;
+	}
+
+	// merge neighbours at the same height
+	for (int i = 0; i < p_skyline.size() - 1; i++) {
+
+		if (p_skyline[i].y == p_skyline[i + 1].y) {
+			p_skyline[i].width += p_skyline[i + 1].width;
+			p_skyline.remove(i + 1);
+			i--;
+		}
+	}
+}
+
+void DynamicFontAtSize::_add_glyph(const GlyphBitmap &p_glyph) {
+
+	if (!p_glyph.found) {
+
 		Character ch;
 		ch.texture_idx = -1;
-		ch.advance = advance;
+		ch.advance = p_glyph.advance;
 		ch.h_align = 0;
 		ch.v_align = 0;
 		ch.found = false;
 
-		char_map[p_char] = ch;
-
+		char_map[p_glyph.c] = ch;
 		return;
 	}
 
-	int w = slot->bitmap.width;
-	int h = slot->bitmap.rows;
-	//int p = slot->bitmap.pitch;
-	int yofs = slot->bitmap_top;
-	int xofs = slot->bitmap_left;
-	int advance = slot->advance.x >> 6;
+	int w = p_glyph.width;
+	int h = p_glyph.height;
 
 	int mw = w + rect_margin * 2;
 	int mh = h + rect_margin * 2;
@@ -479,35 +561,36 @@ void DynamicFontAtSize::_update_char(CharType p_char) {
 
 	for (int i = 0; i < textures.size(); i++) {
 
-		CharTexture &ct = textures[i];
+		const CharTexture &ct = textures[i];
 
 		if (mw > ct.texture_size || mh > ct.texture_size) //too big for this texture
 			continue;
 
-		tex_y = 0x7FFFFFFF;
-		tex_x = 0;
-
-		for (int j = 0; j < ct.texture_size - mw; j++) {
+		int best_node = -1;
+		int best_bottom = 0x7FFFFFFF;
+		int best_width = 0x7FFFFFFF;
 
-			int max_y = 0;
+		for (int j = 0; j < ct.skyline.size(); j++) {
 
-			for (int k = j; k < j + mw; k++) {
-
-				int y = ct.offsets[k];
-				if (y > max_y)
-					max_y = y;
-			}
+			int y = _skyline_fit(ct.skyline, j, mw, mh, ct.texture_size);
+			if (y < 0)
+				continue;
 
-			if (max_y < tex_y) {
-				tex_y = max_y;
-				tex_x = j;
+			// lowest bottom edge first, then the narrowest segment to waste less
+			if (y + mh < best_bottom || (y + mh == best_bottom && ct.skyline[j].width < best_width)) {
+				best_node = j;
+				best_bottom = y + mh;
+				best_width = ct.skyline[j].width;
+				tex_x = ct.skyline[j].x;
+				tex_y = y;
 			}
 		}
 
-		if (tex_y == 0x7FFFFFFF || tex_y + mh > ct.texture_size)
+		if (best_node == -1)
 			continue; //fail, could not fit it here
 
 		tex_index = i;
+		_skyline_add(textures[i].skyline, best_node, mw, mh, tex_y);
 		break;
 	}
 
@@ -540,9 +623,13 @@ void DynamicFontAtSize::_update_char(CharType p_char) {
 				w[i] = 0;
 			}
 		}
-		tex.offsets.resize(texsize);
-		for (int i = 0; i < texsize; i++) //zero offsets
-			tex.offsets[i] = 0;
+
+		SkylineNode floor;
+		floor.x = 0;
+		floor.y = 0;
+		floor.width = texsize;
+		tex.skyline.push_back(floor);
+		_skyline_add(tex.skyline, 0, mw, mh, 0);
 
 		textures.push_back(tex);
 		tex_index = textures.size() - 1;
@@ -554,6 +641,7 @@ void DynamicFontAtSize::_update_char(CharType p_char) {
 
 	{
 		DVector<uint8_t>::Write wr = tex.imgdata.write();
+		DVector<uint8_t>::Read rd = p_glyph.coverage.read();
 
 		for (int i = 0; i < h; i++) {
 			for (int j = 0; j < w; j++) {
@@ -561,43 +649,222 @@ void DynamicFontAtSize::_update_char(CharType p_char) {
 				int ofs = ((i + tex_y + rect_margin) * tex.texture_size + j + tex_x + rect_margin) * 2;
 				ERR_FAIL_COND(ofs >= tex.imgdata.size());
 				wr[ofs + 0] = 255; //grayscale as 1
-				wr[ofs + 1] = slot->bitmap.buffer[i * slot->bitmap.width + j];
+				wr[ofs + 1] = rd[i * w + j];
 			}
 		}
 	}
 
-	//blit to image and texture
-	{
+	// uploaded by _flush_textures(), together with whatever else was added meanwhile
+	Rect2 rect(tex_x, tex_y, mw, mh);
+	if (tex.dirty.has_no_area())
+		tex.dirty = rect;
+	else
+		tex.dirty = tex.dirty.merge(rect);
 
-		Image img(tex.texture_size, tex.texture_size, 0, Image::FORMAT_GRAYSCALE_ALPHA, tex.imgdata);
+	Character chr;
+	chr.h_align = p_glyph.xofs;
+	chr.v_align = ascent - p_glyph.yofs; // + ascent - descent;
+	chr.advance = p_glyph.advance;
+	chr.texture_idx = tex_index;
+	chr.found = true;
+
+	chr.rect = Rect2(tex_x + rect_margin, tex_y + rect_margin, w, h);
+
+	//print_line("CHAR: "+String::chr(p_char)+" TEX INDEX: "+itos(tex_index)+" RECT: "+chr.rect+" X OFS: "+itos(xofs)+" Y OFS: "+itos(yofs));
+
+	char_map[p_glyph.c] = chr;
+}
+
+void DynamicFontAtSize::_flush_textures() {
+
+	for (int i = 0; i < textures.size(); i++) {
+
+		CharTexture &tex = textures[i];
+		if (tex.dirty.has_no_area())
+			continue;
+
+		int x = tex.dirty.pos.x;
+		int y = tex.dirty.pos.y;
+		int w = tex.dirty.size.x;
+		int h = tex.dirty.size.y;
+
+		if (tex.texture.is_null() || w * h * 2 > tex.texture_size * tex.texture_size) {
+
+			//new texture, or most of it changed
+			Image img(tex.texture_size, tex.texture_size, 0, Image::FORMAT_GRAYSCALE_ALPHA, tex.imgdata);
+
+			if (tex.texture.is_null()) {
+				tex.texture.instance();
+				tex.texture->create_from_image(img, Texture::FLAG_VIDEO_SURFACE | texture_flags);
+			} else {
+				tex.texture->set_data(img); //update
+			}
 
-		if (tex.texture.is_null()) {
-			tex.texture.instance();
-			tex.texture->create_from_image(img, Texture::FLAG_VIDEO_SURFACE | texture_flags);
 		} else {
-			tex.texture->set_data(img); //update
+
+			DVector<uint8_t> region;
+			region.resize(w * h * 2);
+			{
+				DVector<uint8_t>::Write wr = region.write();
+				DVector<uint8_t>::Read rd = tex.imgdata.read();
+
+				for (int j = 0; j < h; j++) {
+					copymem(&wr[j * w * 2], &rd[((y + j) * tex.texture_size + x) * 2], w * 2);
+				}
+			}
+
+			Image img(w, h, 0, Image::FORMAT_GRAYSCALE_ALPHA, region);
+			tex.texture->set_data_partial(img, x, y);
 		}
+
+		tex.dirty = Rect2();
 	}
+}
 
-	// update height array
+void DynamicFontAtSize::_update_char(CharType p_char) {
 
-	for (int k = tex_x; k < tex_x + mw; k++) {
+	if (char_map.has(p_char))
+		return;
 
-		tex.offsets[k] = tex_y + mh;
+	_THREAD_SAFE_METHOD_
+
+	// whatever the worker finished goes in first, this char may be among it
+	_commit_prerendered();
+
+	if (!char_map.has(p_char)) {
+
+		GlyphBitmap glyph;
+		_rasterize(face, p_char, font->force_autohinter, glyph);
+		_add_glyph(glyph);
 	}
 
-	Character chr;
-	chr.h_align = xofs;
-	chr.v_align = ascent - yofs; // + ascent - descent;
-	chr.advance = advance;
-	chr.texture_idx = tex_index;
-	chr.found = true;
+	_flush_textures();
+}
 
-	chr.rect = Rect2(tex_x + rect_margin, tex_y + rect_margin, w, h);
+void DynamicFontAtSize::_commit_prerendered() {
 
-	//print_line("CHAR: "+String::chr(p_char)+" TEX INDEX: "+itos(tex_index)+" RECT: "+chr.rect+" X OFS: "+itos(xofs)+" Y OFS: "+itos(yofs));
+	if (!prerender_mutex)
+		return;
+
+	prerender_mutex->lock();
+	List<GlyphBitmap> done = prerender_done;
+	prerender_done.clear();
+	prerender_mutex->unlock();
 
-	char_map[p_char] = chr;
+	for (List<GlyphBitmap>::Element *E = done.front(); E; E = E->next()) {
+
+		if (!char_map.has(E->get().c)) //may have been needed before the worker got to it
+			_add_glyph(E->get());
+	}
+}
+
+void DynamicFontAtSize::_prerender_thread_func(void *p_ud) {
+
+	DynamicFontAtSize *fs = (DynamicFontAtSize *)p_ud;
+
+	// a face can't be used from two threads, so the worker opens its own
+	FT_Library library;
+	FT_Face face;
+	FT_StreamRec stream;
+	Error err = fs->_open_face(library, face, stream);
+
+	while (!fs->prerender_exit) {
+
+		fs->prerender_sem->wait();
+
+		while (!fs->prerender_exit) {
+
+			fs->prerender_mutex->lock();
+			if (fs->prerender_queue.empty()) {
+				fs->prerender_mutex->unlock();
+				break;
+			}
+			if (err != OK) {
+				//main thread will rasterize them as they are drawn
+				fs->prerender_queue.clear();
+				fs->prerender_mutex->unlock();
+				break;
+			}
+			CharType c = fs->prerender_queue.front()->get();
+			fs->prerender_queue.pop_front();
+			fs->prerender_working++;
+			fs->prerender_mutex->unlock();
+
+			GlyphBitmap glyph;
+			_rasterize(face, c, fs->font->force_autohinter, glyph);
+
+			fs->prerender_mutex->lock();
+			fs->prerender_done.push_back(glyph);
+			fs->prerender_working--;
+			fs->prerender_mutex->unlock();
+		}
+	}
+
+	if (err == OK)
+		FT_Done_FreeType(library);
+}
+
+void DynamicFontAtSize::prerender(const String &p_text) {
+
+	if (!valid)
+		return;
+
+	_THREAD_SAFE_METHOD_
+
+	Vector<CharType> chars;
+	Set<CharType> added;
+	for (int i = 0; i < p_text.length(); i++) {
+
+		CharType c = p_text[i];
+		if (c < 32 || char_map.has(c) || added.has(c))
+			continue;
+		added.insert(c);
+		chars.push_back(c);
+	}
+
+	if (chars.empty())
+		return;
+
+	if (!prerender_thread) {
+
+		if (!prerender_sem)
+			prerender_sem = Semaphore::create();
+		if (!prerender_mutex)
+			prerender_mutex = Mutex::create();
+		if (prerender_sem && prerender_mutex)
+			prerender_thread = Thread::create(_prerender_thread_func, this);
+	}
+
+	if (!prerender_thread) {
+
+		//no threads, rasterize right away and upload once
+		for (int i = 0; i < chars.size(); i++) {
+
+			GlyphBitmap glyph;
+			_rasterize(face, chars[i], font->force_autohinter, glyph);
+			_add_glyph(glyph);
+		}
+		_flush_textures();
+		return;
+	}
+
+	prerender_mutex->lock();
+	for (int i = 0; i < chars.size(); i++) {
+		prerender_queue.push_back(chars[i]);
+	}
+	prerender_mutex->unlock();
+	prerender_sem->post();
+}
+
+int DynamicFontAtSize::get_prerender_pending() const {
+
+	if (!prerender_mutex)
+		return 0;
+
+	prerender_mutex->lock();
+	int pending = prerender_queue.size() + prerender_working;
+	prerender_mutex->unlock();
+	return pending;
 }
 
 DynamicFontAtSize::DynamicFontAtSize() {
@@ -608,10 +875,26 @@ DynamicFontAtSize::DynamicFontAtSize() {
 	descent = 1;
 	linegap = 1;
 	texture_flags = 0;
+	prerender_thread = NULL;
+	prerender_sem = NULL;
+	prerender_mutex = NULL;
+	prerender_exit = false;
+	prerender_working = 0;
 }
 
 DynamicFontAtSize::~DynamicFontAtSize() {
 
+	if (prerender_thread) {
+		prerender_exit = true;
+		prerender_sem->post();
+		Thread::wait_to_finish(prerender_thread);
+		memdelete(prerender_thread);
+	}
+	if (prerender_sem)
+		memdelete(prerender_sem);
+	if (prerender_mutex)
+		memdelete(prerender_mutex);
+
 	if (valid) {
 		FT_Done_FreeType(library);
 		font->size_cache.erase(id);
@@ -770,6 +1053,48 @@ float DynamicFont::draw_char(RID p_canvas_item, const Point2 &p_pos, CharType p_
 
 	return data_at_size->draw_char(p_canvas_item, p_pos, p_char, p_next, p_modulate, fallback_data_at_size) + spacing_char;
 }
+
+void DynamicFont::prerender_text(const String &p_text) {
+
+	if (!data_at_size.is_valid())
+		return;
+
+	data_at_size->prerender(p_text);
+}
+
+Error DynamicFont::prerender_charset_file(const String &p_path) {
+
+	Error err;
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ, &err);
+	if (!f) {
+		ERR_EXPLAIN("Can't open charset file: " + p_path);
+		ERR_FAIL_V(err);
+	}
+
+	Vector<uint8_t> buf;
+	buf.resize(f->get_len());
+	if (buf.size())
+		f->get_buffer(buf.ptr(), buf.size());
+	memdelete(f);
+
+	String charset;
+	if (charset.parse_utf8((const char *)buf.ptr(), buf.size())) {
+		ERR_EXPLAIN("Charset file is not valid UTF-8: " + p_path);
+		ERR_FAIL_V(ERR_PARSE_ERROR);
+	}
+
+	prerender_text(charset);
+	return OK;
+}
+
+int DynamicFont::get_prerender_pending() const {
+
+	if (!data_at_size.is_valid())
+		return 0;
+
+	return data_at_size->get_prerender_pending();
+}
+
 void DynamicFont::set_fallback(int p_idx, const Ref<DynamicFontData> &p_data) {
 
 	ERR_FAIL_COND(p_data.is_null());
@@ -880,6 +1205,10 @@ void DynamicFont::_bind_methods() {
 	ObjectTypeDB::bind_method(_MD("remove_fallback", "idx"), &DynamicFont::remove_fallback);
 	ObjectTypeDB::bind_method(_MD("get_fallback_count"), &DynamicFont::get_fallback_count);
 
+	ObjectTypeDB::bind_method(_MD("prerender_text", "text"), &DynamicFont::prerender_text);
+	ObjectTypeDB::bind_method(_MD("prerender_charset_file", "path"), &DynamicFont::prerender_charset_file);
+	ObjectTypeDB::bind_method(_MD("get_prerender_pending"), &DynamicFont::get_prerender_pending);
+
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "font/size"), _SCS("set_size"), _SCS("get_size"));
 	ADD_PROPERTYINZ(PropertyInfo(Variant::INT, "extra_spacing/top"), _SCS("set_spacing"), _SCS("get_spacing"), SPACING_TOP);
 	ADD_PROPERTYINZ(PropertyInfo(Variant::INT, "extra_spacing/bottom"), _SCS("set_spacing"), _SCS("get_spacing"), SPACING_BOTTOM);
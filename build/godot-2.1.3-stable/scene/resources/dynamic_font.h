@@ -32,6 +32,8 @@
 
 #ifdef FREETYPE_ENABLED
 #include "io/resource_loader.h"
+#include "os/semaphore.h"
+#include "os/thread.h"
 #include "os/thread_safe.h"
 #include "scene/resources/font.h"
 
@@ -106,11 +108,19 @@ class DynamicFontAtSize : public Reference {
 
 	bool valid;
 
+	struct SkylineNode {
+
+		int x;
+		int y; // top of the used space below this segment
+		int width;
+	};
+
 	struct CharTexture {
 
 		DVector<uint8_t> imgdata;
 		int texture_size;
-		Vector<int> offsets;
+		Vector<SkylineNode> skyline;
+		Rect2 dirty; // written to imgdata, not uploaded yet
 		Ref<ImageTexture> texture;
 	};
 
@@ -131,6 +141,24 @@ class DynamicFontAtSize : public Reference {
 		}
 	};
 
+	struct GlyphBitmap {
+
+		CharType c;
+		bool found;
+		int width;
+		int height;
+		int xofs;
+		int yofs;
+		int advance;
+		DVector<uint8_t> coverage; // width*height, no padding
+
+		GlyphBitmap() {
+			c = 0;
+			found = false;
+			width = height = xofs = yofs = advance = 0;
+		}
+	};
+
 	static unsigned long _ft_stream_io(FT_Stream stream, unsigned long offset, unsigned char *buffer, unsigned long count);
 	static void _ft_stream_close(FT_Stream stream);
 
@@ -138,11 +166,31 @@ class DynamicFontAtSize : public Reference {
 
 	_FORCE_INLINE_ void _update_char(CharType p_char);
 
+	static void _rasterize(FT_Face p_face, CharType p_char, bool p_force_autohinter, GlyphBitmap &r_glyph);
+	static int _skyline_fit(const Vector<SkylineNode> &p_skyline, int p_index, int p_width, int p_height, int p_size);
+	static void _skyline_add(Vector<SkylineNode> &p_skyline, int p_index, int p_width, int p_height, int p_y);
+	void _add_glyph(const GlyphBitmap &p_glyph);
+	void _flush_textures();
+
+	// glyphs requested with prerender() are rasterized by a worker thread on its
+	// own face, the main thread only packs and uploads them
+	Thread *prerender_thread;
+	Semaphore *prerender_sem;
+	Mutex *prerender_mutex;
+	volatile bool prerender_exit;
+	int prerender_working;
+	List<CharType> prerender_queue;
+	List<GlyphBitmap> prerender_done;
+
+	static void _prerender_thread_func(void *p_ud);
+	void _commit_prerendered();
+
 	friend class DynamicFontData;
 	Ref<DynamicFontData> font;
 	DynamicFontData::CacheID id;
 
 	static HashMap<String, Vector<uint8_t> > _fontdata;
+	Error _open_face(FT_Library &r_library, FT_Face &r_face, FT_StreamRec &r_stream) const;
 	Error _load();
 
 protected:
@@ -158,6 +206,9 @@ public:
 
 	void set_texture_flags(uint32_t p_flags);
 
+	void prerender(const String &p_text);
+	int get_prerender_pending() const;
+
 	DynamicFontAtSize();
 	~DynamicFontAtSize();
 };
@@ -232,6 +283,10 @@ public:
 
 	virtual float draw_char(RID p_canvas_item, const Point2 &p_pos, CharType p_char, CharType p_next = 0, const Color &p_modulate = Color(1, 1, 1)) const;
 
+	void prerender_text(const String &p_text);
+	Error prerender_charset_file(const String &p_path);
+	int get_prerender_pending() const;
+
 	DynamicFont();
 	~DynamicFont();
 };
@@ -233,6 +233,14 @@ void ImageTexture::set_data(const Image &p_image) {
 	_change_notify();
 }
 
+void ImageTexture::set_data_partial(const Image &p_image, int p_x, int p_y) {
+
+	ERR_FAIL_COND(p_image.get_format() != format);
+
+	VisualServer::get_singleton()->texture_set_data_partial(texture, p_image, p_x, p_y);
+	VisualServer::get_singleton()->texture_set_reload_hook(texture, 0, StringName()); //hook is erased if data is changed
+}
+
 void ImageTexture::_resource_path_changed() {
 
 	String path = get_path();
@@ -387,6 +395,7 @@ void ImageTexture::_bind_methods() {
 	ObjectTypeDB::bind_method(_MD("get_format"), &ImageTexture::get_format);
 	ObjectTypeDB::bind_method(_MD("load", "path"), &ImageTexture::load);
 	ObjectTypeDB::bind_method(_MD("set_data", "image"), &ImageTexture::set_data);
+	ObjectTypeDB::bind_method(_MD("set_data_partial", "image", "x", "y"), &ImageTexture::set_data_partial);
 	ObjectTypeDB::bind_method(_MD("get_data", "cube_side"), &ImageTexture::get_data);
 	ObjectTypeDB::bind_method(_MD("set_storage", "mode"), &ImageTexture::set_storage);
 	ObjectTypeDB::bind_method(_MD("get_storage"), &ImageTexture::get_storage);
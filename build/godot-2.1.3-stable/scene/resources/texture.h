@@ -120,6 +120,7 @@ public:
 	Image::Format get_format() const;
 	void load(const String &p_path);
 	void set_data(const Image &p_image);
+	void set_data_partial(const Image &p_image, int p_x, int p_y);
 	Image get_data() const;
 
 	int get_width() const;
@@ -31,6 +31,7 @@
 #define VIDEO_STREAM_H
 
 #include "audio_stream_resampled.h"
+#include "scene/2d/canvas_item.h"
 #include "scene/resources/texture.h"
 
 class VideoStreamPlayback : public Resource {
@@ -64,6 +65,8 @@ public:
 	//virtual int mix(int16_t* p_bufer,int p_frames)=0;
 
 	virtual Ref<Texture> get_texture() = 0;
+	virtual Ref<CanvasItemMaterial> get_texture_material() { return Ref<CanvasItemMaterial>(); } //needed to draw get_texture() when it is not RGB
+	virtual int get_frames_drawn() const { return 0; } //frames uploaded to get_texture() since the last play()
 	virtual void update(float p_delta) = 0;
 
 	virtual void set_mix_callback(AudioMixCallback p_callback, void *p_userdata) = 0;
@@ -28,6 +28,7 @@
 /* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
 /*************************************************************************/
 #include "rasterizer.h"
+#include "globals.h"
 #include "os/os.h"
 #include "print_string.h"
 
@@ -569,6 +570,47 @@ void Rasterizer::_free_fixed_material(const RID &p_material) {
 	}
 }
 
+bool Rasterizer::_canvas_batch_add_command(const CanvasItem::Command *p_command) {
+
+	RID texture;
+	if (!canvas_batching || !canvas_command_get_batch_texture(p_command, texture))
+		return false; //caller flushes and draws it on its own
+
+	//a style box is up to nine quads, the batch is drawn before it could overflow
+	int quads = p_command->type == CanvasItem::Command::TYPE_STYLE ? 9 : 1;
+
+	if (!canvas_batch.started || texture != canvas_batch.texture) {
+
+		_canvas_batch_flush();
+		canvas_batch.texture = texture;
+		canvas_batch.started = true;
+		_canvas_batch_begin(texture);
+	} else if (canvas_batch.quads + quads > CANVAS_BATCH_MAX_QUADS) {
+
+		_canvas_batch_flush();
+	}
+
+	_canvas_batch_add(p_command);
+	return true;
+}
+
+void Rasterizer::_canvas_batch_flush() {
+
+	if (!canvas_batch.quads)
+		return;
+
+	_canvas_batch_draw();
+	canvas_batch.quads = 0;
+}
+
+void Rasterizer::_canvas_batch_end_item() {
+
+	//batches don't span items, and textures may change before the next one
+	_canvas_batch_flush();
+	canvas_batch.texture = RID();
+	canvas_batch.started = false;
+}
+
 void Rasterizer::flush_frame() {
 
 	//not really necesary to implement
@@ -598,6 +640,10 @@ Rasterizer::Rasterizer() {
 
 	draw_viewport_func = NULL;
 
+	canvas_batch.started = false;
+	canvas_batch.quads = 0;
+	canvas_batching = bool(GLOBAL_DEF("rasterizer/use_2d_batching", true));
+
 	ERR_FAIL_COND(sizeof(FixedMaterialShaderKey) != 4);
 }
 
@@ -172,6 +172,7 @@ public:
 	RID texture_create_from_image(const Image &p_image, uint32_t p_flags = VS::TEXTURE_FLAGS_DEFAULT); // helper
 	virtual void texture_allocate(RID p_texture, int p_width, int p_height, Image::Format p_format, uint32_t p_flags = VS::TEXTURE_FLAGS_DEFAULT) = 0;
 	virtual void texture_set_data(RID p_texture, const Image &p_image, VS::CubeMapSide p_cube_side = VS::CUBEMAP_LEFT) = 0;
+	virtual void texture_set_data_partial(RID p_texture, const Image &p_image, int p_dst_x, int p_dst_y, VS::CubeMapSide p_cube_side = VS::CUBEMAP_LEFT) = 0;
 	virtual Image texture_get_data(RID p_texture, VS::CubeMapSide p_cube_side = VS::CUBEMAP_LEFT) const = 0;
 	virtual void texture_set_flags(RID p_texture, uint32_t p_flags) = 0;
 	virtual uint32_t texture_get_flags(RID p_texture) const = 0;
@@ -978,6 +979,60 @@ public:
 
 	virtual void canvas_render_items(CanvasItem *p_item_list, int p_z, const Color &p_modulate, CanvasLight *p_light) = 0;
 	virtual void canvas_debug_viewport_shadows(CanvasLight *p_lights_with_shadow) = 0;
+
+	/* CANVAS BATCHING */
+
+	//consecutive rects and style boxes of an item that share a texture can be merged into a single draw call.
+	//tiled rects are left out, as they may need to change the texture wrap mode.
+	static _FORCE_INLINE_ bool canvas_command_get_batch_texture(const CanvasItem::Command *p_command, RID &r_texture) {
+
+		switch (p_command->type) {
+
+			case CanvasItem::Command::TYPE_RECT: {
+
+				const CanvasItem::CommandRect *rect = static_cast<const CanvasItem::CommandRect *>(p_command);
+				if (rect->flags & CANVAS_RECT_TILE)
+					return false;
+				r_texture = rect->texture;
+				return true;
+			} break;
+			case CanvasItem::Command::TYPE_STYLE: {
+
+				r_texture = static_cast<const CanvasItem::CommandStyle *>(p_command)->texture;
+				return true;
+			} break;
+			default: {}
+		}
+
+		return false;
+	}
+
+protected:
+	//where batches are split is decided here, so every rasterizer splits them (and counts them) the same way.
+	//a rasterizer only fills and draws them through the hooks below.
+
+	enum {
+		CANVAS_BATCH_MAX_QUADS = 2048
+	};
+
+	struct CanvasBatch {
+
+		RID texture;
+		bool started;
+		int quads;
+	} canvas_batch;
+
+	bool canvas_batching;
+
+	virtual void _canvas_batch_begin(const RID &p_texture) {} //texture changed, nothing is queued
+	virtual void _canvas_batch_add(const CanvasItem::Command *p_command) {} //append the command's quads, increasing canvas_batch.quads
+	virtual void _canvas_batch_draw() {} //draw the queued quads
+
+	bool _canvas_batch_add_command(const CanvasItem::Command *p_command);
+	void _canvas_batch_flush();
+	void _canvas_batch_end_item();
+
+public:
 	/* LIGHT SHADOW MAPPING */
 
 	virtual RID canvas_light_occluder_create() = 0;
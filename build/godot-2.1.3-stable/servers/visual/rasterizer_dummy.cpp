@@ -58,6 +58,17 @@ void RasterizerDummy::texture_set_data(RID p_texture, const Image &p_image, VS::
 	texture->image[p_cube_side] = p_image;
 }
 
+void RasterizerDummy::texture_set_data_partial(RID p_texture, const Image &p_image, int p_dst_x, int p_dst_y, VS::CubeMapSide p_cube_side) {
+
+	Texture *texture = texture_owner.get(p_texture);
+
+	ERR_FAIL_COND(!texture);
+	ERR_FAIL_COND(texture->format != p_image.get_format());
+	ERR_FAIL_COND(texture->image[p_cube_side].empty());
+
+	texture->image[p_cube_side].blit_rect(p_image, Rect2(0, 0, p_image.get_width(), p_image.get_height()), Point2(p_dst_x, p_dst_y));
+}
+
 Image RasterizerDummy::texture_get_data(RID p_texture, VS::CubeMapSide p_cube_side) const {
 
 	Texture *texture = texture_owner.get(p_texture);
@@ -1320,6 +1331,9 @@ bool RasterizerDummy::render_target_renedered_in_frame(RID p_render_target) {
 }
 
 void RasterizerDummy::begin_frame() {
+
+	canvas_draw_calls = 0;
+	canvas_batches = 0;
 }
 
 void RasterizerDummy::capture_viewport(Image *r_capture) {
@@ -1423,7 +1437,59 @@ void RasterizerDummy::canvas_draw_polygon(int p_vertex_count, const int *p_indic
 void RasterizerDummy::canvas_set_transform(const Matrix32 &p_transform) {
 }
 
+void RasterizerDummy::_canvas_batch_add(const CanvasItem::Command *p_command) {
+
+	//as many quads as the GLES2 batcher would add
+	if (p_command->type == CanvasItem::Command::TYPE_STYLE)
+		canvas_batch.quads += static_cast<const CanvasItem::CommandStyle *>(p_command)->draw_center ? 9 : 8;
+	else
+		canvas_batch.quads++;
+}
+
+void RasterizerDummy::_canvas_batch_draw() {
+
+	canvas_draw_calls++;
+	canvas_batches++;
+}
+
 void RasterizerDummy::canvas_render_items(CanvasItem *p_item_list, int p_z, const Color &p_modulate, CanvasLight *p_light) {
+
+	while (p_item_list) {
+
+		CanvasItem *ci = p_item_list;
+		int cc = ci->commands.size();
+		CanvasItem::Command **commands = ci->commands.ptr();
+
+		for (int i = 0; i < cc; i++) {
+
+			CanvasItem::Command *c = commands[i];
+
+			if (_canvas_batch_add_command(c))
+				continue;
+
+			_canvas_batch_flush();
+
+			switch (c->type) {
+
+				case CanvasItem::Command::TYPE_TRANSFORM:
+				case CanvasItem::Command::TYPE_BLEND_MODE:
+				case CanvasItem::Command::TYPE_CLIP_IGNORE: {
+					//state changes only
+				} break;
+				case CanvasItem::Command::TYPE_STYLE: {
+					//one draw per nine-patch slice
+					canvas_draw_calls += static_cast<CanvasItem::CommandStyle *>(c)->draw_center ? 9 : 8;
+				} break;
+				default: {
+					canvas_draw_calls++;
+				}
+			}
+		}
+
+		_canvas_batch_end_item();
+
+		p_item_list = p_item_list->next;
+	}
 }
 
 /* ENVIRONMENT */
@@ -1687,6 +1753,19 @@ void RasterizerDummy::finish() {
 
 int RasterizerDummy::get_render_info(VS::RenderInfo p_info) {
 
+	switch (p_info) {
+
+		case VS::INFO_2D_DRAW_CALLS_IN_FRAME: {
+
+			return canvas_draw_calls;
+		} break;
+		case VS::INFO_2D_BATCHES_IN_FRAME: {
+
+			return canvas_batches;
+		} break;
+		default: {}
+	}
+
 	return 0;
 }
 
@@ -1703,8 +1782,10 @@ bool RasterizerDummy::has_feature(VS::Features p_feature) const {
 void RasterizerDummy::restore_framebuffer() {
 }
 
-RasterizerDummy::RasterizerDummy(){
+RasterizerDummy::RasterizerDummy() {
 
+	canvas_draw_calls = 0;
+	canvas_batches = 0;
 };
 
 RasterizerDummy::~RasterizerDummy(){
@@ -368,12 +368,20 @@ class RasterizerDummy : public Rasterizer {
 
 	RID default_material;
 
+	//nothing is drawn, but 2D draw calls are counted as the GLES2 batcher would issue them
+	int canvas_draw_calls;
+	int canvas_batches;
+
+	virtual void _canvas_batch_add(const CanvasItem::Command *p_command);
+	virtual void _canvas_batch_draw();
+
 public:
 	/* TEXTURE API */
 
 	virtual RID texture_create();
 	virtual void texture_allocate(RID p_texture, int p_width, int p_height, Image::Format p_format, uint32_t p_flags = VS::TEXTURE_FLAGS_DEFAULT);
 	virtual void texture_set_data(RID p_texture, const Image &p_image, VS::CubeMapSide p_cube_side = VS::CUBEMAP_LEFT);
+	virtual void texture_set_data_partial(RID p_texture, const Image &p_image, int p_dst_x, int p_dst_y, VS::CubeMapSide p_cube_side = VS::CUBEMAP_LEFT);
 	virtual Image texture_get_data(RID p_texture, VS::CubeMapSide p_cube_side = VS::CUBEMAP_LEFT) const;
 	virtual void texture_set_flags(RID p_texture, uint32_t p_flags);
 	virtual uint32_t texture_get_flags(RID p_texture) const;
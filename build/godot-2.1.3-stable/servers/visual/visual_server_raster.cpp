@@ -64,6 +64,12 @@ void VisualServerRaster::texture_set_data(RID p_texture, const Image &p_image, C
 	rasterizer->texture_set_data(p_texture, p_image, p_cube_side);
 }
 
+void VisualServerRaster::texture_set_data_partial(RID p_texture, const Image &p_image, int p_dst_x, int p_dst_y, CubeMapSide p_cube_side) {
+
+	VS_CHANGED;
+	rasterizer->texture_set_data_partial(p_texture, p_image, p_dst_x, p_dst_y, p_cube_side);
+}
+
 Image VisualServerRaster::texture_get_data(RID p_texture, CubeMapSide p_cube_side) const {
 
 	return rasterizer->texture_get_data(p_texture, p_cube_side);
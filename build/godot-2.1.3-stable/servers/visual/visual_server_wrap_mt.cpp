@@ -29,6 +29,7 @@
 /*************************************************************************/
 #include "visual_server_wrap_mt.h"
 #include "globals.h"
+#include "io/resource_loader.h"
 #include "os/os.h"
 void VisualServerWrapMT::thread_exit() {
 
@@ -180,6 +181,8 @@ VisualServerWrapMT::VisualServerWrapMT(VisualServer *p_contained, bool p_create_
 	mesh_pool_max_size = GLOBAL_DEF("core/rid_pool_prealloc", 20);
 	if (!p_create_thread) {
 		server_thread = Thread::get_caller_ID();
+		//calls from loader threads wait for the main thread to flush them, even while it waits on a load
+		command_queue.set_push_notify_func(ResourceLoader::wake_thread_load_wait);
 	} else {
 		server_thread = 0;
 	}
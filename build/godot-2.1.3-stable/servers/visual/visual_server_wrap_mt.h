@@ -86,6 +86,7 @@ public:
 	FUNCRID(texture);
 	FUNC5(texture_allocate, RID, int, int, Image::Format, uint32_t);
 	FUNC3(texture_set_data, RID, const Image &, CubeMapSide);
+	FUNC5(texture_set_data_partial, RID, const Image &, int, int, CubeMapSide);
 	FUNC2RC(Image, texture_get_data, RID, CubeMapSide);
 	FUNC2(texture_set_flags, RID, uint32_t);
 	FUNC1RC(Image::Format, texture_get_format, RID);
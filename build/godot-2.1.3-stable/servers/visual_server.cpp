@@ -667,6 +667,8 @@ void VisualServer::_bind_methods() {
 	BIND_CONSTANT(INFO_VIDEO_MEM_USED);
 	BIND_CONSTANT(INFO_TEXTURE_MEM_USED);
 	BIND_CONSTANT(INFO_VERTEX_MEM_USED);
+	BIND_CONSTANT(INFO_2D_DRAW_CALLS_IN_FRAME);
+	BIND_CONSTANT(INFO_2D_BATCHES_IN_FRAME);
 }
 
 void VisualServer::_canvas_item_add_style_box(RID p_item, const Rect2 &p_rect, const Rect2 &p_source, RID p_texture, const Vector<float> &p_margins, const Color &p_modulate) {
@@ -120,6 +120,7 @@ public:
 	RID texture_create_from_image(const Image &p_image, uint32_t p_flags = TEXTURE_FLAGS_DEFAULT); // helper
 	virtual void texture_allocate(RID p_texture, int p_width, int p_height, Image::Format p_format, uint32_t p_flags = TEXTURE_FLAGS_DEFAULT) = 0;
 	virtual void texture_set_data(RID p_texture, const Image &p_image, CubeMapSide p_cube_side = CUBEMAP_LEFT) = 0;
+	virtual void texture_set_data_partial(RID p_texture, const Image &p_image, int p_dst_x, int p_dst_y, CubeMapSide p_cube_side = CUBEMAP_LEFT) = 0; ///< update a region of a texture that already has data, same format, no mipmaps in p_image
 	virtual Image texture_get_data(RID p_texture, CubeMapSide p_cube_side = CUBEMAP_LEFT) const = 0;
 	virtual void texture_set_flags(RID p_texture, uint32_t p_flags) = 0;
 	virtual uint32_t texture_get_flags(RID p_texture) const = 0;
@@ -1114,6 +1115,8 @@ public:
 		INFO_VIDEO_MEM_USED,
 		INFO_TEXTURE_MEM_USED,
 		INFO_VERTEX_MEM_USED,
+		INFO_2D_DRAW_CALLS_IN_FRAME,
+		INFO_2D_BATCHES_IN_FRAME,
 	};
 
 	virtual int get_render_info(RenderInfo p_info) = 0;
@@ -10,6 +10,9 @@ var finished_lessons = {}
 
 var catalogue_dict = {}
 
+# compiled course pack (CoursePacker), null when the course only ships loose files
+var course_pack = null
+
 func _ready():
 	config_file = ConfigFile.new()
 	if config_file.load(file_name) == OK:
@@ -18,18 +21,46 @@ func _ready():
 	
 	var dir = Directory.new()
 	if dir.file_exists("res://courses/catalogue/catalogue.json"):
-		var file = File.new()
-		if file.open("res://courses/catalogue/catalogue.json", file.READ)==OK:
-			var text = file.get_as_text()
-			catalogue_dict.parse_json(text)
+		if catalogue_dict.parse_json_file("res://courses/catalogue/catalogue.json")==OK:
 			print(catalogue_dict)
-		file.close()
+	
+	open_course_pack(get_current_course())
 
 func select_course(course):
 	config_file.set_value("data", "current_course", course)
+	open_course_pack(course)
 	
 	save()
 	
+func open_course_pack(course):
+	course_pack = null
+	
+	var pack_file = "res://courses/" + course + ".cpk"
+	var file = File.new()
+	if file.file_exists(pack_file):
+		var pack = CoursePack.new()
+		if pack.open(pack_file)==OK:
+			# icons, audio and video of the course are then read out of the pack
+			pack.mount_media()
+			course_pack = pack
+	
+func get_lesson_md5(lesson_file):
+	if course_pack != null:
+		var md5 = course_pack.get_lesson_md5(lesson_file)
+		if md5 != "":
+			return md5
+	
+	var file = File.new()
+	return file.get_md5(lesson_file)
+	
+func load_lesson(lesson_file, lesson_md5):
+	if course_pack != null and course_pack.has_lesson(lesson_md5):
+		return course_pack.get_lesson(lesson_md5)
+	
+	var lesson = {}
+	lesson.parse_json_file(lesson_file)
+	return lesson
+	
 func get_current_course():
 	if catalogue_dict.has("default"):
 		var default = catalogue_dict["default"]
@@ -1,5 +1,7 @@
 extends Node
 
+const FIELDS = [ "osid", "string" ]
+
 var osid = String()
 
 func _ready():
@@ -11,18 +13,10 @@ func name():
 func id():
 	return 4
 
-func length():
-	return 4 +osid.length();
-
 func send(stream):
 	var buf = ByteBuf.new()
-	buf.write_i32(int(id()))
-	buf.write_i32(int(length()))
-	buf.write_string(osid)
-	buf.write_byte(64)
-	buf.write_byte(64)
-	stream.put_data(buf.raw_data())
+	buf.write_message(id(), FIELDS, self)
+	return buf.send(stream)
 
 func parse_data( byteBuffer):
-	osid = byteBuffer.read_string();
-	pass
+	byteBuffer.read_message_into(FIELDS, self)
@@ -1,5 +1,7 @@
 extends Node
 
+const FIELDS = [ "cur_blood", "int", "max_blood", "int" ]
+
 var cur_blood = int(0)
 var max_blood = int(0)
 
@@ -12,20 +14,10 @@ func name():
 func id():
 	return 6
 
-func length():
-	return 8 ;
-
 func send(stream):
 	var buf = ByteBuf.new()
-	buf.write_i32(int(id()))
-	buf.write_i32(int(length()))
-	buf.write_i32(cur_blood)
-	buf.write_i32(max_blood)
-	buf.write_byte(64)
-	buf.write_byte(64)
-	stream.put_data(buf.raw_data())
+	buf.write_message(id(), FIELDS, self)
+	return buf.send(stream)
 
 func parse_data( byteBuffer):
-	cur_blood = byteBuffer.read_i32();
-	max_blood = byteBuffer.read_i32();
-	pass
+	byteBuffer.read_message_into(FIELDS, self)
@@ -1,5 +1,7 @@
 extends Node
 
+const FIELDS = [ "player", "long", "name", "string" ]
+
 var player = -1
 var name = String()
 
@@ -12,20 +14,10 @@ func name():
 func id():
 	return 7
 
-func length():
-	return 12 +name.length();
-
 func send(stream):
 	var buf = ByteBuf.new()
-	buf.write_i32(int(id()))
-	buf.write_i32(int(length()))
-	buf.write_i64(player)
-	buf.write_string(name)
-	buf.write_byte(64)
-	buf.write_byte(64)
-	stream.put_data(buf.raw_data())
+	buf.write_message(id(), FIELDS, self)
+	return buf.send(stream)
 
 func parse_data( byteBuffer):
-	player = byteBuffer.read_i64();
-	name = byteBuffer.read_string();
-	pass
+	byteBuffer.read_message_into(FIELDS, self)
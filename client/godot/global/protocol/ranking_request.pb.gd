@@ -1,5 +1,7 @@
 extends Node
 
+const FIELDS = [  ]
+
 
 func _ready():
 	pass
@@ -10,16 +12,10 @@ func name():
 func id():
 	return 8
 
-func length():
-	return 0 ;
-
 func send(stream):
 	var buf = ByteBuf.new()
-	buf.write_i32(int(id()))
-	buf.write_i32(int(length()))
-	buf.write_byte(64)
-	buf.write_byte(64)
-	stream.put_data(buf.raw_data())
+	buf.write_message(id(), FIELDS, self)
+	return buf.send(stream)
 
 func parse_data( byteBuffer):
-	pass
+	byteBuffer.read_message_into(FIELDS, self)
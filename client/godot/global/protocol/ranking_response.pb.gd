@@ -1,5 +1,7 @@
 extends Node
 
+const FIELDS = [ "ranking", "string" ]
+
 var ranking = String()
 
 func _ready():
@@ -11,18 +13,10 @@ func name():
 func id():
 	return 9
 
-func length():
-	return 4 +ranking.length();
-
 func send(stream):
 	var buf = ByteBuf.new()
-	buf.write_i32(int(id()))
-	buf.write_i32(int(length()))
-	buf.write_string(ranking)
-	buf.write_byte(64)
-	buf.write_byte(64)
-	stream.put_data(buf.raw_data())
+	buf.write_message(id(), FIELDS, self)
+	return buf.send(stream)
 
 func parse_data( byteBuffer):
-	ranking = byteBuffer.read_string();
-	pass
+	byteBuffer.read_message_into(FIELDS, self)
@@ -1,7 +1,9 @@
 extends Node
 
-var password = String()
+const FIELDS = [ "email", "string", "password", "string" ]
+
 var email = String()
+var password = String()
 
 func _ready():
 	pass
@@ -12,20 +14,10 @@ func name():
 func id():
 	return 10
 
-func length():
-	return 8 +password.length()+email.length();
-
 func send(stream):
 	var buf = ByteBuf.new()
-	buf.write_i32(int(id()))
-	buf.write_i32(int(length()))
-	buf.write_string(password)
-	buf.write_string(email)
-	buf.write_byte(64)
-	buf.write_byte(64)
-	stream.put_data(buf.raw_data())
+	buf.write_message(id(), FIELDS, self)
+	return buf.send(stream)
 
 func parse_data( byteBuffer):
-	password = byteBuffer.read_string();
-	email = byteBuffer.read_string();
-	pass
+	byteBuffer.read_message_into(FIELDS, self)
@@ -1,5 +1,7 @@
 extends Node
 
+const FIELDS = [ "account", "int", "result", "int" ]
+
 var account = int(0)
 var result = int(0)
 
@@ -12,20 +14,10 @@ func name():
 func id():
 	return 11
 
-func length():
-	return 8 ;
-
 func send(stream):
 	var buf = ByteBuf.new()
-	buf.write_i32(int(id()))
-	buf.write_i32(int(length()))
-	buf.write_i32(account)
-	buf.write_i32(result)
-	buf.write_byte(64)
-	buf.write_byte(64)
-	stream.put_data(buf.raw_data())
+	buf.write_message(id(), FIELDS, self)
+	return buf.send(stream)
 
 func parse_data( byteBuffer):
-	account = byteBuffer.read_i32();
-	result = byteBuffer.read_i32();
-	pass
+	byteBuffer.read_message_into(FIELDS, self)
@@ -17,10 +17,7 @@ func _ready():
 	get_node("content").append_bbcode(content_now)
 	
 func load_question():
-	var file = File.new()
-	file.open(question_file,File.READ)
-	var json_str = file.get_as_text()
-	question_data.parse_json(json_str) 
+	question_data.parse_json_file(question_file)
 
 func _on_content_meta_clicked( meta):
 	var i = int(meta)
@@ -46,12 +46,9 @@ func update_display_by_accuracy():
 	get_node("icon").get_material().set_shader_param("Hue", accuracy * 0.01)
 	
 func load_lesson():
-	var file = File.new()
-	file.open(lesson_file,File.READ)
-	var json_str = file.get_as_text()
-	lesson_data.parse_json(json_str)
-	
-	lesson_md5 = file.get_md5(lesson_file)
+	var data_node = get_node("/root/data")
+	lesson_md5 = data_node.get_lesson_md5(lesson_file)
+	lesson_data = data_node.load_lesson(lesson_file, lesson_md5)
 
 func _on_on_click_pressed():
 	current_exercise = 0
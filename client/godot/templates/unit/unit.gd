@@ -50,8 +50,7 @@ func finished_lessons_accuracy(dir):
 	var data_node = get_node("/root/data")
 	for file in list_lessons(dir):
 		var lesson_file = dir + "/" + file
-		var fileHandle = File.new()
-		var lesson_md5 = fileHandle.get_md5(lesson_file)
+		var lesson_md5 = data_node.get_lesson_md5(lesson_file)
 		accuracy += data_node.get_lesson_accuracy(lesson_md5)
 		total += 100
 	
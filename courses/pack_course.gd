@@ -0,0 +1,31 @@
+# Compiles a course directory into a single course pack (.cpk), so the client
+# neither parses lesson json nor hashes lesson files at runtime.
+#
+# usage: godot -s pack_course.gd <course_dir> <res_path> <output.cpk>
+#   e.g. godot -s pack_course.gd cet4/courses/cet4 res://courses/cet4 cet4.cpk
+#
+# copy the result next to the course, as res://courses/<course>.cpk
+extends SceneTree
+
+func _init():
+	var args = OS.get_cmdline_args()
+	if args.size() < 3:
+		print("usage: godot -s pack_course.gd <course_dir> <res_path> <output.cpk>")
+		quit()
+		return
+	
+	var src_dir = args[args.size()-3]
+	var res_path = args[args.size()-2]
+	var output = args[args.size()-1]
+	
+	var packer = CoursePacker.new()
+	if packer.pack_start(output, 32)!=OK:
+		print("can't create " + output)
+	elif packer.add_dir(res_path, src_dir)!=OK:
+		print("can't read " + src_dir)
+	elif packer.flush(true)!=OK:
+		print("failed to write " + output)
+	else:
+		print("packed " + src_dir + " as " + res_path + " into " + output)
+	
+	quit()
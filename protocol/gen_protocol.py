@@ -55,7 +55,7 @@ def gen_protocol_java( file, id):
             length += 4
         if data[key]=='string':
             length += 4
-            strings += "+" + key + ".length()" 
+            strings += "+string_length(" + key + ")"
 
     java_file.writelines("\n")
     java_file.writelines("\t@Override\n")
@@ -118,6 +118,13 @@ def gen_protocol_godot(file, id):
 
     with open(file) as data_file:
         data = json.load(data_file) 
+
+        # field schema in wire order: [ name, type, name, type, ... ]
+        fields = []
+        for key in data.keys():
+            fields.append('"%s", "%s"' % (key, data[key]))
+        gd_file.writelines("const FIELDS = [ " + ", ".join(fields) + " ]\n\n")
+
         for key in data.keys():
             if data[key] == 'string':
                 gd_file.writelines("var " + key + " = String("")\n")
@@ -139,59 +146,17 @@ def gen_protocol_godot(file, id):
     gd_file.writelines("func id():\n")
     gd_file.writelines("\treturn %d\n" % id)
 
-    # length
-    length = 0
-    strings = ''
-    for key in data.keys():
-        if data[key]=='int':
-            length += 4
-        if data[key]=='long':
-            length += 8
-        if data[key]=='float':
-            length += 4
-        if data[key]=='string':
-            length += 4
-            strings += "+" + key + ".length()" 
-
-    gd_file.writelines("\n")
-    gd_file.writelines("func length():\n")
-    gd_file.writelines("\treturn %d %s;\n" % (length, strings))
+    # send data, the native ByteBuf encodes the whole frame from the schema
     gd_file.writelines("\n")
-
-    # send data
     gd_file.writelines("func send(stream):\n")
     gd_file.writelines("\tvar buf = ByteBuf.new()\n")
-    gd_file.writelines("\tbuf.write_i32(int(id()))\n")
-    gd_file.writelines("\tbuf.write_i32(int(length()))\n")
-    for key in data.keys():
-        if data[key]=='int':
-            gd_file.writelines("\tbuf.write_i32(%s)\n" % key)
-        if data[key]=='long':
-            gd_file.writelines("\tbuf.write_i64(%s)\n" % key)
-        if data[key]=='float':
-            gd_file.writelines("\tbuf.write_float(%s)\n" % key)
-        if data[key]=='string':
-            gd_file.writelines("\tbuf.write_string(%s)\n" % key)
-
-    gd_file.writelines("\tbuf.write_byte(64)\n")
-    gd_file.writelines("\tbuf.write_byte(64)\n")
-    gd_file.writelines("\tstream.put_data(buf.raw_data())")
-    gd_file.writelines("\n")
+    gd_file.writelines("\tbuf.write_message(id(), FIELDS, self)\n")
+    gd_file.writelines("\treturn buf.send(stream)\n")
 
     # parse data
     gd_file.writelines("\n")
     gd_file.writelines("func parse_data( byteBuffer):\n")
-    for key in data.keys():
-        if data[key]=='int':
-            gd_file.writelines("\t%s = byteBuffer.read_i32();\n" % key)
-        if data[key]=='long':
-            gd_file.writelines("\t%s = byteBuffer.read_i64();\n" % key)
-        if data[key]=='float':
-            gd_file.writelines("\t%s = byteBuffer.read_float();\n" % key)
-        if data[key]=='string':
-            gd_file.writelines("\t%s = byteBuffer.read_string();\n" % key)
-
-    gd_file.writelines("\tpass\n")
+    gd_file.writelines("\tbyteBuffer.read_message_into(FIELDS, self)\n")
 
     gd_file.close()
 
@@ -202,6 +167,7 @@ def generate_msg_jave_base_class():
     java_file_name = java_save_path + "message.java"
     java_file = open(java_file_name, "w+")
     java_file.writelines("package protocol;\n\n")
+    java_file.writelines("import java.nio.charset.StandardCharsets;\n\n")
     java_file.writelines("import io.netty.buffer.ByteBuf;\n")
     java_file.writelines("import io.netty.buffer.Unpooled;\n\n")
     java_file.writelines("public class message {\n\n")
@@ -223,11 +189,18 @@ def generate_msg_jave_base_class():
     java_file.writelines("\t\tSystem.out.println(\"parse_data method hasn't implementation.\");\n")
     java_file.writelines("\t}\n")
 
+    # string length, strings are prefixed with their UTF-8 byte count (same as the client's ByteBuf)
+    java_file.writelines("\n")
+    java_file.writelines("\tpublic int string_length(String str){\n")
+    java_file.writelines("\t\treturn str.getBytes(StandardCharsets.UTF_8).length;\n")
+    java_file.writelines("\t}\n")
+
     # write string
     java_file.writelines("\n")
     java_file.writelines("\tpublic void write_string(ByteBuf byteBuffer, String str){\n")
-    java_file.writelines("\t\tbyteBuffer.writeInt(str.length());\n")
-    java_file.writelines("\t\tbyteBuffer.writeBytes(str.getBytes());\n")
+    java_file.writelines("\t\tbyte[] bytes = str.getBytes(StandardCharsets.UTF_8);\n")
+    java_file.writelines("\t\tbyteBuffer.writeInt(bytes.length);\n")
+    java_file.writelines("\t\tbyteBuffer.writeBytes(bytes);\n")
     java_file.writelines("\t}\n")
 
     # read string
@@ -239,7 +212,7 @@ def generate_msg_jave_base_class():
     java_file.writelines("\t\t\tresult[i] = byteBuffer.readByte();\n")
     java_file.writelines("\t\t}\n")
     #java_file.writelines("\t\tresult[length] = '\\0';\n")
-    java_file.writelines("\t\treturn new String(result);\n")
+    java_file.writelines("\t\treturn new String(result, StandardCharsets.UTF_8);\n")
     java_file.writelines("\t}\n")
 
     # end
@@ -248,7 +221,8 @@ def generate_msg_jave_base_class():
 
 generate_msg_jave_base_class()
 
-dirs = os.listdir(root_path)
+# sorted, so message ids don't depend on the directory listing order
+dirs = sorted(os.listdir(root_path))
 id = 1
 for file in dirs:
     if os.path.splitext(file)[1] == '.proto':
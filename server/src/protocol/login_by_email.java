@@ -5,8 +5,8 @@ import io.netty.buffer.Unpooled;
 
 public class login_by_email extends message {
 
-	public String password = "";
 	public String email = "";
+	public String password = "";
 	@Override
 
 	public int id(){
@@ -15,15 +15,15 @@ public class login_by_email extends message {
 
 	@Override
 	public int length(){
-		 return 8 +password.length()+email.length();
+		 return 8 +string_length(email)+string_length(password);
 	}
 
 	public ByteBuf data(){
 		ByteBuf byteBuffer = Unpooled.buffer(8+length());
 		byteBuffer.writeInt(id());
 		byteBuffer.writeInt(length());
-		write_string(byteBuffer, password);
 		write_string(byteBuffer, email);
+		write_string(byteBuffer, password);
 		byteBuffer.writeByte(64);
 		byteBuffer.writeByte(64);
 		return byteBuffer;
@@ -31,7 +31,7 @@ public class login_by_email extends message {
 
 	@Override
 	public void parse_data(ByteBuf byteBuffer){
-		password = read_string(byteBuffer);
 		email = read_string(byteBuffer);
+		password = read_string(byteBuffer);
 	}
 }
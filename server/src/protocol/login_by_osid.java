@@ -14,7 +14,7 @@ public class login_by_osid extends message {
 
 	@Override
 	public int length(){
-		 return 4 +osid.length();
+		 return 4 +string_length(osid);
 	}
 
 	public ByteBuf data(){
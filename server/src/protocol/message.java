@@ -1,5 +1,7 @@
 package protocol;
 
+import java.nio.charset.StandardCharsets;
+
 import io.netty.buffer.ByteBuf;
 import io.netty.buffer.Unpooled;
 
@@ -17,9 +19,14 @@ public class message {
 		System.out.println("parse_data method hasn't implementation.");
 	}
 
+	public int string_length(String str){
+		return str.getBytes(StandardCharsets.UTF_8).length;
+	}
+
 	public void write_string(ByteBuf byteBuffer, String str){
-		byteBuffer.writeInt(str.length());
-		byteBuffer.writeBytes(str.getBytes());
+		byte[] bytes = str.getBytes(StandardCharsets.UTF_8);
+		byteBuffer.writeInt(bytes.length);
+		byteBuffer.writeBytes(bytes);
 	}
 
 	public String read_string(ByteBuf byteBuffer){
@@ -28,6 +35,6 @@ public class message {
 		for(int i=0; i<length; i++){
 			result[i] = byteBuffer.readByte();
 		}
-		return new String(result);
+		return new String(result, StandardCharsets.UTF_8);
 	}
 }
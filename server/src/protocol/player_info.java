@@ -15,7 +15,7 @@ public class player_info extends message {
 
 	@Override
 	public int length(){
-		 return 12 +name.length();
+		 return 12 +string_length(name);
 	}
 
 	public ByteBuf data(){
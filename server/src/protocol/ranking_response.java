@@ -14,7 +14,7 @@ public class ranking_response extends message {
 
 	@Override
 	public int length(){
-		 return 4 +ranking.length();
+		 return 4 +string_length(ranking);
 	}
 
 	public ByteBuf data(){